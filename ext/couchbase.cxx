@@ -21,17 +21,22 @@
 #include "rcb_backend.hxx"
 #include "rcb_buckets.hxx"
 #include "rcb_collections.hxx"
+#include "rcb_completion_queue.hxx"
 #include "rcb_crud.hxx"
 #include "rcb_diagnostics.hxx"
 #include "rcb_exceptions.hxx"
 #include "rcb_extras.hxx"
+#include "rcb_json.hxx"
 #include "rcb_hdr_histogram.hxx"
 #include "rcb_logger.hxx"
 #include "rcb_multi.hxx"
 #include "rcb_observability.hxx"
+#include "rcb_pending_result.hxx"
 #include "rcb_query.hxx"
 #include "rcb_range_scan.hxx"
+#include "rcb_row_stream.hxx"
 #include "rcb_search.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_users.hxx"
 #include "rcb_version.hxx"
 #include "rcb_views.hxx"
@@ -45,6 +50,7 @@ Init_libcouchbase(void)
 {
   couchbase::ruby::install_terminate_handler();
   couchbase::ruby::init_logger();
+  couchbase::ruby::init_symbols();
 
   VALUE mCouchbase = rb_define_module("Couchbase");
 
@@ -54,7 +60,10 @@ Init_libcouchbase(void)
   VALUE cBackend = couchbase::ruby::init_backend(mCouchbase);
 
   couchbase::ruby::init_crud(cBackend);
+  couchbase::ruby::init_pending_result(cBackend);
   couchbase::ruby::init_multi(cBackend);
+  couchbase::ruby::init_completion_queue(cBackend);
+  couchbase::ruby::init_row_stream(cBackend);
   couchbase::ruby::init_analytics(cBackend);
   couchbase::ruby::init_views(cBackend);
   couchbase::ruby::init_search(cBackend);
@@ -65,6 +74,7 @@ Init_libcouchbase(void)
   couchbase::ruby::init_range_scan(mCouchbase, cBackend);
   couchbase::ruby::init_diagnostics(cBackend);
   couchbase::ruby::init_extras(cBackend);
+  couchbase::ruby::init_json(cBackend);
   couchbase::ruby::init_logger_methods(cBackend);
   couchbase::ruby::init_hdr_histogram(mCouchbase);
   couchbase::ruby::init_observability(cBackend);
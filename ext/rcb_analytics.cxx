@@ -40,11 +40,14 @@
 
 #include <future>
 #include <memory>
+#include <string>
 
 #include <ruby.h>
 
 #include "rcb_backend.hxx"
 #include "rcb_observability.hxx"
+#include "rcb_row_stream.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_utils.hxx"
 
 namespace couchbase::ruby
@@ -127,10 +130,10 @@ cb_Backend_analytics_dataset_get_all(VALUE self, VALUE options, VALUE observabil
     VALUE res = rb_ary_new_capa(static_cast<long>(resp.datasets.size()));
     for (const auto& ds : resp.datasets) {
       VALUE dataset = rb_hash_new();
-      rb_hash_aset(dataset, rb_id2sym(rb_intern("name")), cb_str_new(ds.name));
+      rb_hash_aset(dataset, cb_symbols.name, cb_str_new(ds.name));
       rb_hash_aset(dataset, rb_id2sym(rb_intern("dataverse_name")), cb_str_new(ds.dataverse_name));
       rb_hash_aset(dataset, rb_id2sym(rb_intern("link_name")), cb_str_new(ds.link_name));
-      rb_hash_aset(dataset, rb_id2sym(rb_intern("bucket_name")), cb_str_new(ds.bucket_name));
+      rb_hash_aset(dataset, cb_symbols.bucket_name, cb_str_new(ds.bucket_name));
       rb_ary_push(res, dataset);
     }
     return res;
@@ -379,7 +382,7 @@ cb_Backend_analytics_index_get_all(VALUE self, VALUE options, VALUE observabilit
     VALUE res = rb_ary_new_capa(static_cast<long>(resp.indexes.size()));
     for (const auto& idx : resp.indexes) {
       VALUE index = rb_hash_new();
-      rb_hash_aset(index, rb_id2sym(rb_intern("name")), cb_str_new(idx.name));
+      rb_hash_aset(index, cb_symbols.name, cb_str_new(idx.name));
       rb_hash_aset(index, rb_id2sym(rb_intern("dataset_name")), cb_str_new(idx.dataset_name));
       rb_hash_aset(index, rb_id2sym(rb_intern("dataverse_name")), cb_str_new(idx.dataverse_name));
       rb_hash_aset(index, rb_id2sym(rb_intern("is_primary")), idx.is_primary ? Qtrue : Qfalse);
@@ -1132,6 +1135,117 @@ cb_for_each_named_param_analytics(VALUE key, VALUE value, VALUE arg)
   return ST_CONTINUE;
 }
 
+void
+cb_extract_analytics_request(core::operations::analytics_request& req,
+                             VALUE statement,
+                             VALUE options)
+{
+  req.statement = cb_string_new(statement);
+  if (VALUE client_context_id = rb_hash_aref(options, cb_symbols.client_context_id);
+      !NIL_P(client_context_id)) {
+    cb_check_type(client_context_id, T_STRING);
+    req.client_context_id = cb_string_new(client_context_id);
+  }
+  cb_extract_timeout(req, options);
+  cb_extract_option_bool(req.readonly, options, "readonly");
+  cb_extract_option_bool(req.priority, options, "priority");
+  if (VALUE positional_params =
+        rb_hash_aref(options, rb_id2sym(rb_intern("positional_parameters")));
+      !NIL_P(positional_params)) {
+    cb_check_type(positional_params, T_ARRAY);
+    auto entries_num = static_cast<std::size_t>(RARRAY_LEN(positional_params));
+    req.positional_parameters.reserve(entries_num);
+    for (std::size_t i = 0; i < entries_num; ++i) {
+      VALUE entry = rb_ary_entry(positional_params, static_cast<long>(i));
+      cb_check_type(entry, T_STRING);
+      req.positional_parameters.emplace_back(cb_string_new(entry));
+    }
+  }
+  if (VALUE named_params = rb_hash_aref(options, rb_id2sym(rb_intern("named_parameters")));
+      !NIL_P(named_params)) {
+    cb_check_type(named_params, T_HASH);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    rb_hash_foreach(
+      named_params, cb_for_each_named_param_analytics, reinterpret_cast<VALUE>(&req));
+  }
+  if (VALUE scan_consistency = rb_hash_aref(options, rb_id2sym(rb_intern("scan_consistency")));
+      !NIL_P(scan_consistency)) {
+    cb_check_type(scan_consistency, T_SYMBOL);
+    if (ID type = rb_sym2id(scan_consistency); type == rb_intern("not_bounded")) {
+      req.scan_consistency = core::analytics_scan_consistency::not_bounded;
+    } else if (type == rb_intern("request_plus")) {
+      req.scan_consistency = core::analytics_scan_consistency::request_plus;
+    }
+  }
+
+  if (VALUE scope_qualifier = rb_hash_aref(options, rb_id2sym(rb_intern("scope_qualifier")));
+      !NIL_P(scope_qualifier) && TYPE(scope_qualifier) == T_STRING) {
+    req.scope_qualifier.emplace(cb_string_new(scope_qualifier));
+  } else {
+    VALUE scope_name = rb_hash_aref(options, rb_id2sym(rb_intern("scope_name")));
+    if (!NIL_P(scope_name) && TYPE(scope_name) == T_STRING) {
+      req.scope_name.emplace(cb_string_new(scope_name));
+      VALUE bucket_name = rb_hash_aref(options, cb_symbols.bucket_name);
+      if (NIL_P(bucket_name)) {
+        throw ruby_exception(
+          exc_invalid_argument(),
+          fmt::format("bucket must be specified for analytics query in scope \"{}\"",
+                      req.scope_name.value()));
+      }
+      req.bucket_name.emplace(cb_string_new(bucket_name));
+    }
+  }
+
+  if (VALUE raw_params = rb_hash_aref(options, rb_id2sym(rb_intern("raw_parameters")));
+      !NIL_P(raw_params)) {
+    cb_check_type(raw_params, T_HASH);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    rb_hash_foreach(raw_params, cb_for_each_named_param_analytics, reinterpret_cast<VALUE>(&req));
+  }
+}
+
+void
+cb_check_analytics_response(const core::operations::analytics_response& resp)
+{
+  if (resp.ctx.ec) {
+    if (!resp.meta.errors.empty()) {
+      const auto& first_error = resp.meta.errors.front();
+      cb_throw_error(resp.ctx,
+                     fmt::format("unable to execute analytics query ({}: {})",
+                                 first_error.code,
+                                 first_error.message));
+    } else {
+      cb_throw_error(resp.ctx, "unable to execute analytics query");
+    }
+  }
+}
+
+VALUE
+cb_create_analytics_meta(const core::operations::analytics_response& resp)
+{
+  VALUE meta = rb_hash_new();
+  rb_hash_aset(meta,
+               cb_symbols.status,
+               rb_id2sym(rb_intern(cb_analytics_status_str(resp.meta.status))));
+  rb_hash_aset(meta, cb_symbols.request_id, cb_str_new(resp.meta.request_id));
+  rb_hash_aset(meta, cb_symbols.client_context_id, cb_str_new(resp.meta.client_context_id));
+  if (resp.meta.signature) {
+    rb_hash_aset(meta, cb_symbols.signature, cb_str_new(resp.meta.signature.value()));
+  }
+  VALUE metrics = rb_hash_new();
+  rb_hash_aset(meta, cb_symbols.metrics, metrics);
+  rb_hash_aset(metrics, cb_symbols.elapsed_time, resp.meta.metrics.elapsed_time.count());
+  rb_hash_aset(metrics, cb_symbols.execution_time, resp.meta.metrics.execution_time.count());
+  rb_hash_aset(metrics, cb_symbols.result_count, ULL2NUM(resp.meta.metrics.result_count));
+  rb_hash_aset(metrics, cb_symbols.result_size, ULL2NUM(resp.meta.metrics.result_size));
+  rb_hash_aset(metrics, cb_symbols.error_count, ULL2NUM(resp.meta.metrics.error_count));
+  rb_hash_aset(metrics,
+               rb_id2sym(rb_intern("processed_objects")),
+               ULL2NUM(resp.meta.metrics.processed_objects));
+  rb_hash_aset(metrics, cb_symbols.warning_count, ULL2NUM(resp.meta.metrics.warning_count));
+  return meta;
+}
+
 VALUE
 cb_Backend_document_analytics(VALUE self,
                               VALUE statement,
@@ -1147,69 +1261,7 @@ cb_Backend_document_analytics(VALUE self,
 
   try {
     core::operations::analytics_request req;
-    req.statement = cb_string_new(statement);
-    if (VALUE client_context_id = rb_hash_aref(options, rb_id2sym(rb_intern("client_context_id")));
-        !NIL_P(client_context_id)) {
-      cb_check_type(client_context_id, T_STRING);
-      req.client_context_id = cb_string_new(client_context_id);
-    }
-    cb_extract_timeout(req, options);
-    cb_extract_option_bool(req.readonly, options, "readonly");
-    cb_extract_option_bool(req.priority, options, "priority");
-    if (VALUE positional_params =
-          rb_hash_aref(options, rb_id2sym(rb_intern("positional_parameters")));
-        !NIL_P(positional_params)) {
-      cb_check_type(positional_params, T_ARRAY);
-      auto entries_num = static_cast<std::size_t>(RARRAY_LEN(positional_params));
-      req.positional_parameters.reserve(entries_num);
-      for (std::size_t i = 0; i < entries_num; ++i) {
-        VALUE entry = rb_ary_entry(positional_params, static_cast<long>(i));
-        cb_check_type(entry, T_STRING);
-        req.positional_parameters.emplace_back(cb_string_new(entry));
-      }
-    }
-    if (VALUE named_params = rb_hash_aref(options, rb_id2sym(rb_intern("named_parameters")));
-        !NIL_P(named_params)) {
-      cb_check_type(named_params, T_HASH);
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      rb_hash_foreach(
-        named_params, cb_for_each_named_param_analytics, reinterpret_cast<VALUE>(&req));
-    }
-    if (VALUE scan_consistency = rb_hash_aref(options, rb_id2sym(rb_intern("scan_consistency")));
-        !NIL_P(scan_consistency)) {
-      cb_check_type(scan_consistency, T_SYMBOL);
-      if (ID type = rb_sym2id(scan_consistency); type == rb_intern("not_bounded")) {
-        req.scan_consistency = core::analytics_scan_consistency::not_bounded;
-      } else if (type == rb_intern("request_plus")) {
-        req.scan_consistency = core::analytics_scan_consistency::request_plus;
-      }
-    }
-
-    if (VALUE scope_qualifier = rb_hash_aref(options, rb_id2sym(rb_intern("scope_qualifier")));
-        !NIL_P(scope_qualifier) && TYPE(scope_qualifier) == T_STRING) {
-      req.scope_qualifier.emplace(cb_string_new(scope_qualifier));
-    } else {
-      VALUE scope_name = rb_hash_aref(options, rb_id2sym(rb_intern("scope_name")));
-      if (!NIL_P(scope_name) && TYPE(scope_name) == T_STRING) {
-        req.scope_name.emplace(cb_string_new(scope_name));
-        VALUE bucket_name = rb_hash_aref(options, rb_id2sym(rb_intern("bucket_name")));
-        if (NIL_P(bucket_name)) {
-          throw ruby_exception(
-            exc_invalid_argument(),
-            fmt::format("bucket must be specified for analytics query in scope \"{}\"",
-                        req.scope_name.value()));
-        }
-        req.bucket_name.emplace(cb_string_new(bucket_name));
-      }
-    }
-
-    if (VALUE raw_params = rb_hash_aref(options, rb_id2sym(rb_intern("raw_parameters")));
-        !NIL_P(raw_params)) {
-      cb_check_type(raw_params, T_HASH);
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      rb_hash_foreach(raw_params, cb_for_each_named_param_analytics, reinterpret_cast<VALUE>(&req));
-    }
-
+    cb_extract_analytics_request(req, statement, options);
     auto parent_span = cb_create_parent_span(req, self);
 
     std::promise<core::operations::analytics_response> promise;
@@ -1219,53 +1271,15 @@ cb_Backend_document_analytics(VALUE self,
     });
     auto resp = cb_wait_for_future(f);
     cb_add_core_spans(observability_handler, std::move(parent_span), resp.ctx.retry_attempts);
-    if (resp.ctx.ec) {
-      if (!resp.meta.errors.empty()) {
-        const auto& first_error = resp.meta.errors.front();
-        cb_throw_error(resp.ctx,
-                       fmt::format("unable to execute analytics query ({}: {})",
-                                   first_error.code,
-                                   first_error.message));
-      } else {
-        cb_throw_error(resp.ctx, "unable to execute analytics query");
-      }
-    }
+    cb_check_analytics_response(resp);
+
     VALUE res = rb_hash_new();
     VALUE rows = rb_ary_new_capa(static_cast<long>(resp.rows.size()));
-    rb_hash_aset(res, rb_id2sym(rb_intern("rows")), rows);
+    rb_hash_aset(res, cb_symbols.rows, rows);
     for (const auto& row : resp.rows) {
       rb_ary_push(rows, cb_str_new(row));
     }
-    VALUE meta = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("meta")), meta);
-    rb_hash_aset(meta,
-                 rb_id2sym(rb_intern("status")),
-                 rb_id2sym(rb_intern(cb_analytics_status_str(resp.meta.status))));
-    rb_hash_aset(meta, rb_id2sym(rb_intern("request_id")), cb_str_new(resp.meta.request_id));
-    rb_hash_aset(
-      meta, rb_id2sym(rb_intern("client_context_id")), cb_str_new(resp.meta.client_context_id));
-    if (resp.meta.signature) {
-      rb_hash_aset(
-        meta, rb_id2sym(rb_intern("signature")), cb_str_new(resp.meta.signature.value()));
-    }
-    VALUE metrics = rb_hash_new();
-    rb_hash_aset(meta, rb_id2sym(rb_intern("metrics")), metrics);
-    rb_hash_aset(
-      metrics, rb_id2sym(rb_intern("elapsed_time")), resp.meta.metrics.elapsed_time.count());
-    rb_hash_aset(
-      metrics, rb_id2sym(rb_intern("execution_time")), resp.meta.metrics.execution_time.count());
-    rb_hash_aset(
-      metrics, rb_id2sym(rb_intern("result_count")), ULL2NUM(resp.meta.metrics.result_count));
-    rb_hash_aset(
-      metrics, rb_id2sym(rb_intern("result_size")), ULL2NUM(resp.meta.metrics.result_size));
-    rb_hash_aset(
-      metrics, rb_id2sym(rb_intern("error_count")), ULL2NUM(resp.meta.metrics.error_count));
-    rb_hash_aset(metrics,
-                 rb_id2sym(rb_intern("processed_objects")),
-                 ULL2NUM(resp.meta.metrics.processed_objects));
-    rb_hash_aset(
-      metrics, rb_id2sym(rb_intern("warning_count")), ULL2NUM(resp.meta.metrics.warning_count));
-
+    rb_hash_aset(res, cb_symbols.meta, cb_create_analytics_meta(resp));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -1276,12 +1290,63 @@ cb_Backend_document_analytics(VALUE self,
   return Qnil;
 }
 
+/**
+ * Starts the analytics query and returns Backend::RowStream. Once the stream is cancelled (the
+ * consumer stopped the iteration), the next row makes the core stop reading and close the HTTP
+ * response.
+ */
+VALUE
+cb_Backend_document_analytics_stream(VALUE self,
+                                     VALUE statement,
+                                     VALUE options,
+                                     VALUE observability_handler)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(statement, T_STRING);
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::analytics_request req;
+    cb_extract_analytics_request(req, statement, options);
+    auto parent_span = cb_create_parent_span(req, self);
+
+    auto stream = cb_backend_make_row_stream(self);
+    req.row_callback = [stream](std::string row) {
+      return stream->push(std::move(row)) ? core::utils::json::stream_control::next_row
+                                          : core::utils::json::stream_control::stop;
+    };
+    cluster.execute(req, [stream, parent_span, observability_handler](auto&& resp) {
+      stream->finish([resp = std::forward<decltype(resp)>(resp),
+                      parent_span,
+                      observability_handler]() -> VALUE {
+        cb_add_core_spans(observability_handler, parent_span, resp.ctx.retry_attempts);
+        cb_check_analytics_response(resp);
+        VALUE res = rb_hash_new();
+        rb_hash_aset(res, cb_symbols.meta, cb_create_analytics_meta(resp));
+        return res;
+      });
+    });
+    return cb_row_stream_new(stream);
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
 } // namespace
 
 void
 init_analytics(VALUE cBackend)
 {
   rb_define_method(cBackend, "document_analytics", cb_Backend_document_analytics, 3);
+  rb_define_method(
+    cBackend, "document_analytics_stream", cb_Backend_document_analytics_stream, 3);
 
   // Management APIs
   rb_define_method(
@@ -38,6 +38,9 @@
 #include "rcb_backend.hxx"
 #include "rcb_exceptions.hxx"
 #include "rcb_logger.hxx"
+#include "rcb_prepared_statement_cache.hxx"
+#include "rcb_row_stream.hxx"
+#include "rcb_scan_agent_cache.hxx"
 #include "rcb_utils.hxx"
 #include "rcb_version.hxx"
 
@@ -45,23 +48,39 @@ namespace couchbase::ruby
 {
 namespace
 {
+/*
+ * The cache is opt-in, by default the queries with adhoc option turned off are prepared by the core,
+ * exactly like before the cache has been introduced.
+ */
+constexpr std::size_t cb_default_prepared_statement_cache_size{ 0 };
+
+/*
+ * Rows of the streaming query, analytics or search, that have been received but not consumed yet.
+ * Large enough to absorb short pauses of the consumer, and small enough to fail before the process
+ * runs out of memory.
+ */
+constexpr std::size_t cb_default_row_stream_max_buffered_bytes{ 64 * 1024 * 1024 };
+
 struct cb_backend_data {
   std::unique_ptr<cluster> instance{ nullptr };
+  std::shared_ptr<cb_prepared_statement_cache> prepared_statements{ nullptr };
+  std::shared_ptr<cb_scan_agent_cache> scan_agents{ nullptr };
+  std::size_t row_stream_max_buffered_bytes{ 0 };
 };
 
 class instance_registry
 {
 public:
-  void add(cluster* instance)
+  void add(cb_backend_data* backend)
   {
     std::scoped_lock lock(instances_mutex_);
-    known_instances_.push_back(instance);
+    known_instances_.push_back(backend);
   }
 
-  void remove(cluster* instance)
+  void remove(cb_backend_data* backend)
   {
     std::scoped_lock lock(instances_mutex_);
-    known_instances_.remove(instance);
+    known_instances_.remove(backend);
   }
 
   void notify_fork(couchbase::fork_event event)
@@ -72,8 +91,12 @@ public:
 
     {
       std::scoped_lock lock(instances_mutex_);
-      for (auto* instance : known_instances_) {
-        instance->notify_fork(event);
+      for (auto* backend : known_instances_) {
+        if (event == couchbase::fork_event::prepare && backend->scan_agents) {
+          // the agents are bound to the connections of the parent, let the scans open them again
+          backend->scan_agents->clear();
+        }
+        backend->instance->notify_fork(event);
       }
     }
 
@@ -85,7 +108,7 @@ public:
 
 private:
   std::mutex instances_mutex_;
-  std::list<cluster*> known_instances_;
+  std::list<cb_backend_data*> known_instances_;
 };
 
 instance_registry instances;
@@ -120,8 +143,15 @@ cb_Backend_notify_fork(VALUE self, VALUE event)
 void
 cb_backend_close(cb_backend_data* backend)
 {
+  backend->prepared_statements.reset();
+  if (backend->scan_agents) {
+    backend->scan_agents->clear();
+    backend->scan_agents.reset();
+  }
+  if (backend->instance) {
+    instances.remove(backend);
+  }
   if (auto instance = std::move(backend->instance); instance) {
-    instances.remove(instance.get());
     auto promise = std::make_shared<std::promise<void>>();
     auto f = promise->get_future();
     instance->close([promise = std::move(promise)]() mutable {
@@ -175,6 +205,8 @@ cb_Backend_allocate(VALUE klass)
   cb_backend_data* backend = nullptr;
   VALUE obj = TypedData_Make_Struct(klass, cb_backend_data, &cb_backend_type, backend);
   backend->instance = nullptr;
+  backend->prepared_statements = nullptr;
+  backend->scan_agents = nullptr;
   return obj;
 }
 
@@ -366,6 +398,21 @@ initialize_cluster_options(const core::utils::connection_string& connstr,
     cluster_options.compression().enabled(param.value());
   }
 
+  static const auto sym_compression_min_size = rb_id2sym(rb_intern("compression_min_size"));
+  if (auto param = options::get_size_t(options, sym_compression_min_size); param) {
+    cluster_options.compression().min_size(param.value());
+  }
+
+  static const auto sym_compression_min_ratio = rb_id2sym(rb_intern("compression_min_ratio"));
+  if (auto param = options::get_double(options, sym_compression_min_ratio); param) {
+    if (param.value() <= 0 || param.value() > 1) {
+      throw ruby_exception(
+        exc_invalid_argument(),
+        rb_sprintf("compression_min_ratio must be in range (0, 1], but given %f", param.value()));
+    }
+    cluster_options.compression().min_ratio(param.value());
+  }
+
   static const auto sym_enable_clustermap_notification =
     rb_id2sym(rb_intern("enable_clustermap_notification"));
   if (auto param = options::get_bool(options, sym_enable_clustermap_notification); param) {
@@ -517,6 +564,17 @@ cb_Backend_open(VALUE self, VALUE connstr, VALUE credentials, VALUE options)
     auto cluster_options =
       initialize_cluster_options(parsed_connection_string, credentials, options);
 
+    static const auto sym_prepared_statement_cache_size =
+      rb_id2sym(rb_intern("prepared_statement_cache_size"));
+    auto prepared_statement_cache_size =
+      options::get_size_t(options, sym_prepared_statement_cache_size)
+        .value_or(cb_default_prepared_statement_cache_size);
+    static const auto sym_row_stream_max_buffered_bytes =
+      rb_id2sym(rb_intern("row_stream_max_buffered_bytes"));
+    auto row_stream_max_buffered_bytes =
+      options::get_size_t(options, sym_row_stream_max_buffered_bytes)
+        .value_or(cb_default_row_stream_max_buffered_bytes);
+
     auto promise =
       std::make_shared<std::promise<std::pair<couchbase::error, couchbase::cluster>>>();
     auto f = promise->get_future();
@@ -533,7 +591,11 @@ cb_Backend_open(VALUE self, VALUE connstr, VALUE credentials, VALUE options)
         error, fmt::format("failed to connect to the Couchbase Server \"{}\"", connection_string));
     }
     backend->instance = std::make_unique<couchbase::cluster>(std::move(cluster));
-    instances.add(backend->instance.get());
+    backend->prepared_statements =
+      std::make_shared<cb_prepared_statement_cache>(prepared_statement_cache_size);
+    backend->scan_agents = std::make_shared<cb_scan_agent_cache>();
+    backend->row_stream_max_buffered_bytes = row_stream_max_buffered_bytes;
+    instances.add(backend);
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -654,4 +716,43 @@ cb_backend_to_core_api_cluster(VALUE self) -> core::cluster
   return core::get_core_cluster(cb_backend_to_public_api_cluster(self));
 }
 
+auto
+cb_backend_to_prepared_statement_cache(VALUE self) -> std::shared_ptr<cb_prepared_statement_cache>
+{
+  const cb_backend_data* backend = nullptr;
+  TypedData_Get_Struct(self, cb_backend_data, &cb_backend_type, backend);
+
+  if (backend->instance == nullptr) {
+    rb_raise(exc_cluster_closed(), "Cluster has been closed already");
+  }
+
+  return backend->prepared_statements;
+}
+
+auto
+cb_backend_to_scan_agent_cache(VALUE self) -> std::shared_ptr<cb_scan_agent_cache>
+{
+  const cb_backend_data* backend = nullptr;
+  TypedData_Get_Struct(self, cb_backend_data, &cb_backend_type, backend);
+
+  if (backend->instance == nullptr) {
+    rb_raise(exc_cluster_closed(), "Cluster has been closed already");
+  }
+
+  return backend->scan_agents;
+}
+
+auto
+cb_backend_make_row_stream(VALUE self) -> std::shared_ptr<cb_row_stream>
+{
+  const cb_backend_data* backend = nullptr;
+  TypedData_Get_Struct(self, cb_backend_data, &cb_backend_type, backend);
+
+  if (backend->instance == nullptr) {
+    rb_raise(exc_cluster_closed(), "Cluster has been closed already");
+  }
+
+  return std::make_shared<cb_row_stream>(backend->row_stream_max_buffered_bytes);
+}
+
 } // namespace couchbase::ruby
@@ -33,12 +33,29 @@ class cluster;
 
 namespace couchbase::ruby
 {
+class cb_prepared_statement_cache;
+class cb_row_stream;
+class cb_scan_agent_cache;
+
 auto
 cb_backend_to_public_api_cluster(VALUE self) -> couchbase::cluster;
 
 auto
 cb_backend_to_core_api_cluster(VALUE self) -> core::cluster;
 
+auto
+cb_backend_to_prepared_statement_cache(VALUE self) -> std::shared_ptr<cb_prepared_statement_cache>;
+
+auto
+cb_backend_to_scan_agent_cache(VALUE self) -> std::shared_ptr<cb_scan_agent_cache>;
+
+/**
+ * Creates the buffer for the rows of the streaming operation, bounded by the limit configured for
+ * the cluster.
+ */
+auto
+cb_backend_make_row_stream(VALUE self) -> std::shared_ptr<cb_row_stream>;
+
 VALUE
 init_backend(VALUE mCouchbase);
 } // namespace couchbase::ruby
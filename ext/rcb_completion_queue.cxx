@@ -0,0 +1,595 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <core/cluster.hxx>
+#include <core/document_id.hxx>
+
+#include <core/operations/document_get.hxx>
+#include <core/operations/document_remove.hxx>
+#include <core/operations/document_upsert.hxx>
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+
+#include <ruby.h>
+#include <ruby/io.h>
+
+#include "rcb_backend.hxx"
+#include "rcb_completion_queue.hxx"
+#include "rcb_exceptions.hxx"
+#include "rcb_symbols.hxx"
+#include "rcb_utils.hxx"
+
+namespace couchbase::ruby
+{
+namespace
+{
+/**
+ * Part of the completion queue, that is shared with the callbacks of the core.
+ *
+ * Producers (IO threads of the core) push completed entries into intrusive lock-free stack, and
+ * signal the file descriptor only on transition from empty to non-empty state. The consumer (Ruby
+ * thread) resets the signal and takes the whole stack at once.
+ */
+class completion_queue_state
+{
+public:
+  struct entry {
+    entry* next{ nullptr };
+    std::uint64_t token{};
+    std::function<VALUE()> build_result{};
+  };
+
+  completion_queue_state()
+  {
+#ifndef _WIN32
+#ifdef __linux__
+    read_fd_ = write_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (read_fd_ < 0) {
+      throw ruby_exception(
+        rb_syserr_new(errno, "unable to create eventfd for the completion queue"));
+    }
+    rb_update_max_fd(read_fd_);
+#else
+    std::array<int, 2> fds{};
+    if (rb_cloexec_pipe(fds.data()) != 0) {
+      throw ruby_exception(rb_syserr_new(errno, "unable to create pipe for the completion queue"));
+    }
+    rb_update_max_fd(fds[0]);
+    rb_update_max_fd(fds[1]);
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+#endif
+#endif
+  }
+
+  completion_queue_state(const completion_queue_state&) = delete;
+  completion_queue_state(completion_queue_state&&) = delete;
+  auto operator=(const completion_queue_state&) -> completion_queue_state& = delete;
+  auto operator=(completion_queue_state&&) -> completion_queue_state& = delete;
+
+  ~completion_queue_state()
+  {
+    auto* head = head_.exchange(nullptr, std::memory_order_acquire);
+    while (head != nullptr) {
+      auto* next = head->next;
+      delete head;
+      head = next;
+    }
+#ifndef _WIN32
+    if (read_fd_ >= 0) {
+      close(read_fd_);
+    }
+    if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+      close(write_fd_);
+    }
+#endif
+  }
+
+  [[nodiscard]] auto fd() const -> int
+  {
+    return read_fd_;
+  }
+
+  /**
+   * Might be called from any thread, does not require GVL.
+   */
+  void push(std::uint64_t token, std::function<VALUE()> build_result)
+  {
+    auto* item = new entry{ nullptr, token, std::move(build_result) };
+    item->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(
+      item->next, item, std::memory_order_release, std::memory_order_relaxed)) {
+      // retry with updated head
+    }
+    if (item->next == nullptr) {
+      notify();
+    }
+  }
+
+  /**
+   * Takes all completed entries in order of completion. Must be called from single thread only.
+   */
+  auto take_all() -> entry*
+  {
+    reset_signal();
+    auto* head = head_.exchange(nullptr, std::memory_order_acquire);
+    entry* reversed = nullptr;
+    while (head != nullptr) {
+      auto* next = head->next;
+      head->next = reversed;
+      reversed = head;
+      head = next;
+    }
+    return reversed;
+  }
+
+private:
+  void notify() const
+  {
+#ifndef _WIN32
+#ifdef __linux__
+    const std::uint64_t value{ 1 };
+#else
+    const char value{ 1 };
+#endif
+    while (write(write_fd_, &value, sizeof(value)) < 0 && errno == EINTR) {
+      // retry
+    }
+#endif
+  }
+
+  void reset_signal() const
+  {
+#ifndef _WIN32
+    std::array<char, 64> buffer{};
+    while (true) {
+      auto rc = read(read_fd_, buffer.data(), buffer.size());
+      if (rc > 0 || (rc < 0 && errno == EINTR)) {
+        continue;
+      }
+      break;
+    }
+#endif
+  }
+
+  std::atomic<entry*> head_{ nullptr };
+  int read_fd_{ -1 };
+  int write_fd_{ -1 };
+};
+
+struct cb_completion_queue_data {
+  std::shared_ptr<completion_queue_state> state{};
+  VALUE tags{ Qnil };
+  VALUE io{ Qnil };
+  std::uint64_t next_token{ 0 };
+};
+
+void
+cb_CompletionQueue_mark(void* ptr)
+{
+  const auto* data = static_cast<const cb_completion_queue_data*>(ptr);
+  rb_gc_mark(data->tags);
+  rb_gc_mark(data->io);
+}
+
+void
+cb_CompletionQueue_free(void* ptr)
+{
+  auto* data = static_cast<cb_completion_queue_data*>(ptr);
+  data->~cb_completion_queue_data();
+  ruby_xfree(data);
+}
+
+std::size_t
+cb_CompletionQueue_memsize(const void* ptr)
+{
+  const auto* data = static_cast<const cb_completion_queue_data*>(ptr);
+  return sizeof(*data);
+}
+
+const rb_data_type_t cb_completion_queue_type{
+  "Couchbase/Backend/CompletionQueue",
+  {
+    cb_CompletionQueue_mark,
+    cb_CompletionQueue_free,
+    cb_CompletionQueue_memsize,
+// only one reserved field when GC.compact implemented
+#ifdef T_MOVED
+    nullptr,
+#endif
+    {},
+  },
+#ifdef RUBY_TYPED_FREE_IMMEDIATELY
+  nullptr,
+  nullptr,
+  RUBY_TYPED_FREE_IMMEDIATELY,
+#endif
+};
+
+VALUE
+cb_CompletionQueue_allocate(VALUE klass)
+{
+  cb_completion_queue_data* data = nullptr;
+  VALUE obj =
+    TypedData_Make_Struct(klass, cb_completion_queue_data, &cb_completion_queue_type, data);
+  new (data) cb_completion_queue_data();
+  return obj;
+}
+
+auto
+cb_completion_queue_from_value(VALUE queue) -> cb_completion_queue_data*
+{
+  auto* data =
+    static_cast<cb_completion_queue_data*>(rb_check_typeddata(queue, &cb_completion_queue_type));
+  if (data->state == nullptr) {
+    rb_raise(rb_eArgError, "completion queue is not initialized");
+  }
+  return data;
+}
+
+VALUE
+cb_CompletionQueue_initialize(VALUE self)
+{
+  cb_completion_queue_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_completion_queue_data, &cb_completion_queue_type, data);
+  try {
+    data->state = std::make_shared<completion_queue_state>();
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  data->tags = rb_hash_new();
+  return self;
+}
+
+VALUE
+cb_CompletionQueue_to_io(VALUE self)
+{
+  auto* data = cb_completion_queue_from_value(self);
+#ifdef _WIN32
+  rb_raise(exc_feature_not_available(), "completion queue does not expose IO on Windows");
+#else
+  if (NIL_P(data->io)) {
+    data->io = rb_io_fdopen(data->state->fd(), O_RDONLY, nullptr);
+    // the descriptor is owned by the queue
+    rb_funcall(data->io, rb_intern("autoclose="), 1, Qfalse);
+  }
+#endif
+  return data->io;
+}
+
+VALUE
+cb_CompletionQueue_pending(VALUE self)
+{
+  const auto* data = cb_completion_queue_from_value(self);
+  return rb_hash_size(data->tags);
+}
+
+VALUE
+cb_build_completion_entry(VALUE arg)
+{
+  // NOLINTNEXTLINE(performance-no-int-to-ptr)
+  auto* item = reinterpret_cast<completion_queue_state::entry*>(arg);
+  try {
+    return item->build_result();
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_CompletionQueue_drain(VALUE self)
+{
+  auto* data = cb_completion_queue_from_value(self);
+
+  VALUE res = rb_ary_new();
+  int state = 0;
+  {
+    // take ownership of every entry and forget their tags before building any result, so that
+    // an error in the middle neither leaks the rest of the list nor leaves stale tags behind
+    std::vector<std::unique_ptr<completion_queue_state::entry>> entries{};
+    VALUE tags = rb_ary_new();
+    auto* item = data->state->take_all();
+    while (item != nullptr) {
+      auto* next = item->next;
+      entries.emplace_back(item);
+      rb_ary_push(tags, rb_hash_delete(data->tags, ULL2NUM(item->token)));
+      item = next;
+    }
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      VALUE result = rb_protect(
+        cb_build_completion_entry, reinterpret_cast<VALUE>(entries[i].get()), &state);
+      if (state != 0) {
+        break;
+      }
+      rb_ary_push(res, rb_assoc_new(rb_ary_entry(tags, static_cast<long>(i)), result));
+    }
+  }
+  if (state != 0) {
+    // the entries have been released by now, it is safe to unwind
+    rb_jump_tag(state);
+  }
+  return res;
+}
+
+VALUE
+cb_CompletionQueue_wait(int argc, VALUE* argv, VALUE self)
+{
+  VALUE timeout = Qnil;
+  rb_scan_args(argc, argv, "01", &timeout);
+  if (!NIL_P(timeout)) {
+    Check_Type(timeout, T_FIXNUM);
+  }
+
+  auto* data = cb_completion_queue_from_value(self);
+  VALUE res = cb_CompletionQueue_drain(self);
+  if (RARRAY_LEN(res) > 0 || RHASH_SIZE(data->tags) == 0) {
+    return res;
+  }
+#ifdef _WIN32
+  rb_thread_wait_for(rb_time_interval(rb_float_new(0.001)));
+#else
+  VALUE timeout_sec =
+    NIL_P(timeout) ? Qnil : rb_float_new(static_cast<double>(FIX2LONG(timeout)) / 1000.0);
+  rb_io_wait(cb_CompletionQueue_to_io(self), RB_INT2NUM(RUBY_IO_READABLE), timeout_sec);
+#endif
+  return cb_CompletionQueue_drain(self);
+}
+
+auto
+cb_completion_queue_register(cb_completion_queue_data* queue, VALUE tag) -> std::uint64_t
+{
+  auto token = ++queue->next_token;
+  rb_hash_aset(queue->tags, ULL2NUM(token), tag);
+  return token;
+}
+
+VALUE
+cb_build_get_entry(const core::operations::get_response& resp)
+{
+  VALUE entry = rb_hash_new();
+  if (resp.ctx.ec()) {
+    rb_hash_aset(entry, cb_symbols.error, cb_map_error(resp.ctx, "unable to fetch document"));
+  }
+  rb_hash_aset(entry, cb_symbols.id, cb_str_new(resp.ctx.id()));
+  rb_hash_aset(entry, cb_symbols.content, cb_str_new(resp.value));
+  rb_hash_aset(entry, cb_symbols.cas, cb_cas_to_num(resp.cas));
+  rb_hash_aset(entry, cb_symbols.flags, UINT2NUM(resp.flags));
+  return entry;
+}
+
+template<typename Response>
+VALUE
+cb_build_mutation_entry(const Response& resp, const char* message)
+{
+  VALUE entry;
+  if (resp.ctx.ec()) {
+    entry = rb_hash_new();
+    rb_hash_aset(entry, cb_symbols.error, cb_map_error(resp.ctx, message));
+  } else {
+    entry = cb_create_mutation_result(resp);
+  }
+  rb_hash_aset(entry, cb_symbols.id, cb_str_new(resp.ctx.id()));
+  return entry;
+}
+
+VALUE
+cb_Backend_document_get_enqueue(VALUE self,
+                                VALUE queue,
+                                VALUE tag,
+                                VALUE bucket,
+                                VALUE scope,
+                                VALUE collection,
+                                VALUE id,
+                                VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+  auto* queue_data = cb_completion_queue_from_value(queue);
+
+  Check_Type(bucket, T_STRING);
+  Check_Type(scope, T_STRING);
+  Check_Type(collection, T_STRING);
+  Check_Type(id, T_STRING);
+
+  try {
+    core::operations::get_request req{ core::document_id{
+      cb_string_new(bucket),
+      cb_string_new(scope),
+      cb_string_new(collection),
+      cb_string_new(id),
+    } };
+    cb_extract_timeout(req, options);
+
+    auto token = cb_completion_queue_register(queue_data, tag);
+    cluster.execute(req, [state = queue_data->state, token](auto&& resp) {
+      state->push(token, [resp = std::forward<decltype(resp)>(resp)]() {
+        return cb_build_get_entry(resp);
+      });
+    });
+    return self;
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_upsert_enqueue(VALUE self,
+                                   VALUE queue,
+                                   VALUE tag,
+                                   VALUE bucket,
+                                   VALUE scope,
+                                   VALUE collection,
+                                   VALUE id,
+                                   VALUE content,
+                                   VALUE flags,
+                                   VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+  auto* queue_data = cb_completion_queue_from_value(queue);
+
+  Check_Type(bucket, T_STRING);
+  Check_Type(scope, T_STRING);
+  Check_Type(collection, T_STRING);
+  Check_Type(id, T_STRING);
+  Check_Type(content, T_STRING);
+  Check_Type(flags, T_FIXNUM);
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::upsert_request req{
+      core::document_id{
+        cb_string_new(bucket),
+        cb_string_new(scope),
+        cb_string_new(collection),
+        cb_string_new(id),
+      },
+      cb_binary_new(content),
+    };
+    req.flags = FIX2UINT(flags);
+    cb_extract_timeout(req, options);
+    cb_extract_expiry(req, options);
+    cb_extract_durability_level(req, options);
+    cb_extract_preserve_expiry(req, options);
+
+    auto token = cb_completion_queue_register(queue_data, tag);
+    auto handler = [state = queue_data->state, token](auto&& resp) {
+      state->push(token, [resp = std::forward<decltype(resp)>(resp)]() {
+        return cb_build_mutation_entry(resp, "unable to upsert");
+      });
+    };
+    if (const auto legacy_durability = extract_legacy_durability_constraints(options);
+        legacy_durability.has_value()) {
+      cluster.execute(
+        core::operations::upsert_request_with_legacy_durability{
+          std::move(req),
+          legacy_durability.value().first,
+          legacy_durability.value().second,
+        },
+        std::move(handler));
+    } else {
+      cluster.execute(std::move(req), std::move(handler));
+    }
+    return self;
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_remove_enqueue(VALUE self,
+                                   VALUE queue,
+                                   VALUE tag,
+                                   VALUE bucket,
+                                   VALUE scope,
+                                   VALUE collection,
+                                   VALUE id,
+                                   VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+  auto* queue_data = cb_completion_queue_from_value(queue);
+
+  Check_Type(bucket, T_STRING);
+  Check_Type(scope, T_STRING);
+  Check_Type(collection, T_STRING);
+  Check_Type(id, T_STRING);
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::remove_request req{ core::document_id{
+      cb_string_new(bucket),
+      cb_string_new(scope),
+      cb_string_new(collection),
+      cb_string_new(id),
+    } };
+    cb_extract_timeout(req, options);
+    cb_extract_durability_level(req, options);
+    cb_extract_cas(req, options);
+
+    auto token = cb_completion_queue_register(queue_data, tag);
+    auto handler = [state = queue_data->state, token](auto&& resp) {
+      state->push(token, [resp = std::forward<decltype(resp)>(resp)]() {
+        return cb_build_mutation_entry(resp, "unable to remove");
+      });
+    };
+    if (const auto legacy_durability = extract_legacy_durability_constraints(options);
+        legacy_durability.has_value()) {
+      cluster.execute(
+        core::operations::remove_request_with_legacy_durability{
+          std::move(req),
+          legacy_durability.value().first,
+          legacy_durability.value().second,
+        },
+        std::move(handler));
+    } else {
+      cluster.execute(std::move(req), std::move(handler));
+    }
+    return self;
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+} // namespace
+
+void
+init_completion_queue(VALUE cBackend)
+{
+  VALUE cCompletionQueue = rb_define_class_under(cBackend, "CompletionQueue", rb_cObject);
+  rb_define_alloc_func(cCompletionQueue, cb_CompletionQueue_allocate);
+  rb_define_method(cCompletionQueue, "initialize", cb_CompletionQueue_initialize, 0);
+  rb_define_method(cCompletionQueue, "to_io", cb_CompletionQueue_to_io, 0);
+  rb_define_method(cCompletionQueue, "pending", cb_CompletionQueue_pending, 0);
+  rb_define_method(cCompletionQueue, "drain", cb_CompletionQueue_drain, 0);
+  rb_define_method(cCompletionQueue, "wait", cb_CompletionQueue_wait, -1);
+
+  rb_define_method(cBackend, "document_get_enqueue", cb_Backend_document_get_enqueue, 7);
+  rb_define_method(cBackend, "document_upsert_enqueue", cb_Backend_document_upsert_enqueue, 9);
+  rb_define_method(cBackend, "document_remove_enqueue", cb_Backend_document_remove_enqueue, 7);
+}
+} // namespace couchbase::ruby
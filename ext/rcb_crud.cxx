@@ -48,9 +48,14 @@
 #include <future>
 
 #include <ruby.h>
+#include <ruby/encoding.h>
 
 #include "rcb_backend.hxx"
+#include "rcb_crud.hxx"
+#include "rcb_json.hxx"
 #include "rcb_observability.hxx"
+#include "rcb_pending_result.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_utils.hxx"
 
 namespace couchbase
@@ -79,8 +84,246 @@ struct codec::is_transcoder<ruby::passthrough_transcoder> : public std::true_typ
 
 namespace couchbase::ruby
 {
+void
+cb_extract_lookup_in_specs(std::vector<core::impl::subdoc::command>& commands, VALUE specs)
+{
+  static VALUE xattr_property = rb_id2sym(rb_intern("xattr"));
+  static VALUE opcode_property = rb_id2sym(rb_intern("opcode"));
+
+  auto entries_size = static_cast<std::size_t>(RARRAY_LEN(specs));
+  for (std::size_t i = 0; i < entries_size; ++i) {
+    VALUE entry = rb_ary_entry(specs, static_cast<long>(i));
+    cb_check_type(entry, T_HASH);
+    VALUE operation = rb_hash_aref(entry, opcode_property);
+    cb_check_type(operation, T_SYMBOL);
+    bool xattr = RTEST(rb_hash_aref(entry, xattr_property));
+    VALUE path = rb_hash_aref(entry, cb_symbols.path);
+    cb_check_type(path, T_STRING);
+    auto opcode = core::impl::subdoc::opcode{};
+    if (ID operation_id = rb_sym2id(operation); operation_id == rb_intern("get_doc")) {
+      opcode = core::impl::subdoc::opcode::get_doc;
+    } else if (operation_id == rb_intern("get")) {
+      opcode = core::impl::subdoc::opcode::get;
+    } else if (operation_id == rb_intern("exists")) {
+      opcode = core::impl::subdoc::opcode::exists;
+    } else if (operation_id == rb_intern("count")) {
+      opcode = core::impl::subdoc::opcode::get_count;
+    } else {
+      throw ruby_exception(
+        exc_invalid_argument(),
+        rb_sprintf("unsupported operation for subdocument lookup: %+" PRIsVALUE, operation));
+    }
+    cb_check_type(path, T_STRING);
+
+    commands.emplace_back(core::impl::subdoc::command{
+      opcode,
+      cb_string_new(path),
+      {},
+      core::impl::subdoc::build_lookup_in_path_flags(xattr, false) });
+  }
+}
+
+void
+cb_extract_mutate_in_specs(std::vector<core::impl::subdoc::command>& commands, VALUE specs)
+{
+  static VALUE xattr_property = rb_id2sym(rb_intern("xattr"));
+  static VALUE create_path_property = rb_id2sym(rb_intern("create_path"));
+  static VALUE expand_macros_property = rb_id2sym(rb_intern("expand_macros"));
+  static VALUE opcode_property = rb_id2sym(rb_intern("opcode"));
+  static VALUE param_property = rb_id2sym(rb_intern("param"));
+
+  couchbase::mutate_in_specs cxx_specs;
+  {
+    auto entries_size = static_cast<std::size_t>(RARRAY_LEN(specs));
+    for (std::size_t i = 0; i < entries_size; ++i) {
+      VALUE entry = rb_ary_entry(specs, static_cast<long>(i));
+      cb_check_type(entry, T_HASH);
+      bool xattr = RTEST(rb_hash_aref(entry, xattr_property));
+      bool create_path = RTEST(rb_hash_aref(entry, create_path_property));
+      bool expand_macros = RTEST(rb_hash_aref(entry, expand_macros_property));
+      VALUE path = rb_hash_aref(entry, cb_symbols.path);
+      cb_check_type(path, T_STRING);
+      VALUE operation = rb_hash_aref(entry, opcode_property);
+      cb_check_type(operation, T_SYMBOL);
+      VALUE param = rb_hash_aref(entry, param_property);
+      if (ID operation_id = rb_sym2id(operation); operation_id == rb_intern("dict_add")) {
+        cb_check_type(param, T_STRING);
+        cxx_specs.push_back(couchbase::mutate_in_specs::insert_raw(
+                              cb_string_new(path), cb_binary_new(param), expand_macros)
+                              .xattr(xattr)
+                              .create_path(create_path));
+      } else if (operation_id == rb_intern("dict_upsert")) {
+        cb_check_type(param, T_STRING);
+
+        cxx_specs.push_back(couchbase::mutate_in_specs::upsert_raw(
+                              cb_string_new(path), cb_binary_new(param), expand_macros)
+                              .xattr(xattr)
+                              .create_path(create_path));
+      } else if (operation_id == rb_intern("remove")) {
+        cxx_specs.push_back(couchbase::mutate_in_specs::remove(cb_string_new(path)).xattr(xattr));
+      } else if (operation_id == rb_intern("replace")) {
+        cb_check_type(param, T_STRING);
+        cxx_specs.push_back(couchbase::mutate_in_specs::replace_raw(
+                              cb_string_new(path), cb_binary_new(param), expand_macros)
+                              .xattr(xattr));
+      } else if (operation_id == rb_intern("array_push_last")) {
+        cb_check_type(param, T_STRING);
+        cxx_specs.push_back(
+          couchbase::mutate_in_specs::array_append_raw(cb_string_new(path), cb_binary_new(param))
+            .xattr(xattr)
+            .create_path(create_path));
+      } else if (operation_id == rb_intern("array_push_first")) {
+        cb_check_type(param, T_STRING);
+        cxx_specs.push_back(
+          couchbase::mutate_in_specs::array_prepend_raw(cb_string_new(path), cb_binary_new(param))
+            .xattr(xattr)
+            .create_path(create_path));
+      } else if (operation_id == rb_intern("array_insert")) {
+        cb_check_type(param, T_STRING);
+        cxx_specs.push_back(
+          couchbase::mutate_in_specs::array_insert_raw(cb_string_new(path), cb_binary_new(param))
+            .xattr(xattr)
+            .create_path(create_path));
+      } else if (operation_id == rb_intern("array_add_unique")) {
+        cb_check_type(param, T_STRING);
+        cxx_specs.push_back(couchbase::mutate_in_specs::array_add_unique_raw(
+                              cb_string_new(path), cb_binary_new(param), expand_macros)
+                              .xattr(xattr)
+                              .create_path(create_path));
+      } else if (operation_id == rb_intern("counter")) {
+        if (TYPE(param) == T_FIXNUM || TYPE(param) == T_BIGNUM) {
+          if (std::int64_t num = NUM2LL(param); num < 0) {
+            cxx_specs.push_back(
+              couchbase::mutate_in_specs::decrement(cb_string_new(path), -1 * num)
+                .xattr(xattr)
+                .create_path(create_path));
+          } else {
+            cxx_specs.push_back(couchbase::mutate_in_specs::increment(cb_string_new(path), num)
+                                  .xattr(xattr)
+                                  .create_path(create_path));
+          }
+        } else {
+          throw ruby_exception(
+            exc_invalid_argument(),
+            rb_sprintf("subdocument counter operation expects number, but given: %+" PRIsVALUE,
+                       param));
+        }
+      } else if (operation_id == rb_intern("set_doc")) {
+        cb_check_type(param, T_STRING);
+        cxx_specs.push_back(
+          couchbase::mutate_in_specs::replace_raw("", cb_binary_new(param), expand_macros)
+            .xattr(xattr));
+      } else if (operation_id == rb_intern("remove_doc")) {
+        cxx_specs.push_back(couchbase::mutate_in_specs::remove("").xattr(xattr));
+      } else {
+        throw ruby_exception(
+          exc_invalid_argument(),
+          rb_sprintf("unsupported operation for subdocument mutation: %+" PRIsVALUE, operation));
+      }
+    }
+  }
+  commands = cxx_specs.specs();
+}
+
+VALUE
+cb_create_lookup_in_result(core::operations::lookup_in_response& resp,
+                           const std::optional<cb_json_decode_options>& json)
+{
+  VALUE res = rb_hash_new();
+  rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
+  VALUE fields = rb_ary_new_capa(static_cast<long>(resp.fields.size()));
+  rb_hash_aset(res, cb_symbols.fields, fields);
+  rb_hash_aset(res, cb_symbols.deleted, resp.deleted ? Qtrue : Qfalse);
+  for (std::size_t i = 0; i < resp.fields.size(); ++i) {
+    auto& resp_entry = resp.fields.at(i);
+    VALUE entry = rb_hash_new();
+    rb_hash_aset(entry, cb_symbols.index, ULL2NUM(resp_entry.original_index));
+    rb_hash_aset(entry, cb_symbols.exists, resp_entry.exists ? Qtrue : Qfalse);
+    rb_hash_aset(entry, cb_symbols.path, cb_str_new(resp_entry.path));
+    if (!resp_entry.value.empty()) {
+      // subdocument values are always JSON, and zero flags are treated as such
+      auto value = cb_json_decode_document(std::move(resp_entry.value), 0, json);
+      rb_hash_aset(entry, cb_symbols.value, value.encoded);
+      if (value.decoded) {
+        rb_hash_aset(entry, cb_symbols.decoded, Qtrue);
+        rb_hash_aset(entry, cb_symbols.decoded_value, value.decoded.value());
+      }
+    }
+    if (resp_entry.ec) {
+      rb_hash_aset(
+        entry,
+        cb_symbols.error,
+        cb_map_error_code(resp_entry.ec,
+                          fmt::format("error getting result for spec at index {}, path \"{}\"",
+                                      i,
+                                      resp_entry.path)));
+    }
+
+    rb_ary_store(fields, static_cast<long>(i), entry);
+  }
+  return res;
+}
+
+VALUE
+cb_create_mutate_in_result(const core::operations::mutate_in_response& resp, VALUE specs)
+{
+  VALUE res = cb_create_mutation_result(resp);
+  rb_hash_aset(res, cb_symbols.deleted, resp.deleted ? Qtrue : Qfalse);
+  VALUE fields = rb_ary_new_capa(static_cast<long>(resp.fields.size()));
+  rb_hash_aset(res, cb_symbols.fields, fields);
+  for (std::size_t i = 0; i < resp.fields.size(); ++i) {
+    VALUE entry = rb_hash_new();
+    rb_hash_aset(entry, cb_symbols.index, ULL2NUM(i));
+    rb_hash_aset(entry,
+                 cb_symbols.path,
+                 rb_hash_aref(rb_ary_entry(specs, static_cast<long>(i)), cb_symbols.path));
+    if (!resp.fields.at(i).value.empty()) {
+      rb_hash_aset(entry, cb_symbols.value, cb_str_new(resp.fields.at(i).value));
+    }
+    rb_ary_store(fields, static_cast<long>(i), entry);
+  }
+  return res;
+}
+
 namespace
 {
+/*
+ * Single-document get and mutation responses are returned as Struct instances instead of Hash.
+ * The struct holds everything the Ruby side needs in one object: the mutation token is stored as
+ * plain integers next to CAS, and the bucket name is deduplicated, so that each operation leaves
+ * only one object (plus document body) to the garbage collector.
+ */
+VALUE cGetResponse{ Qnil };
+VALUE cMutationResponse{ Qnil };
+
+VALUE
+cb_create_get_response(core::operations::get_response&& resp,
+                       const std::optional<cb_json_decode_options>& json)
+{
+  auto content = cb_json_decode_document(std::move(resp.value), resp.flags, json);
+  return rb_struct_new(cGetResponse,
+                       content.encoded,
+                       cb_cas_to_num(resp.cas),
+                       UINT2NUM(resp.flags),
+                       content.decoded ? Qtrue : Qfalse,
+                       content.decoded.value_or(Qnil));
+}
+
+template<typename Response>
+VALUE
+cb_create_mutation_response(const Response& resp)
+{
+  const auto& bucket_name = resp.token.bucket_name();
+  return rb_struct_new(cMutationResponse,
+                       cb_cas_to_num(resp.cas),
+                       UINT2NUM(resp.token.partition_id()),
+                       ULL2NUM(resp.token.partition_uuid()),
+                       ULL2NUM(resp.token.sequence_number()),
+                       rb_enc_interned_str(bucket_name.data(),
+                                           static_cast<long>(bucket_name.size()),
+                                           rb_utf8_encoding()));
+}
+
 VALUE
 cb_Backend_document_get(VALUE self,
                         VALUE bucket,
@@ -107,10 +350,11 @@ cb_Backend_document_get(VALUE self,
 
     core::operations::get_request req{ doc_id };
     cb_extract_timeout(req, options);
+    auto json = cb_extract_json_decode_options(options);
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::get_response> promise;
+    cb_promise<core::operations::get_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -121,11 +365,7 @@ cb_Backend_document_get(VALUE self,
       cb_throw_error(resp.ctx, "unable to fetch document");
     }
 
-    VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("content")), cb_str_new(resp.value));
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
-    rb_hash_aset(res, rb_id2sym(rb_intern("flags")), UINT2NUM(resp.flags));
-    return res;
+    return cb_create_get_response(std::move(resp), json);
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -165,7 +405,7 @@ cb_Backend_document_get_any_replica(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::get_any_replica_response> promise;
+    cb_promise<core::operations::get_any_replica_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -177,10 +417,10 @@ cb_Backend_document_get_any_replica(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("content")), cb_str_new(resp.value));
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
-    rb_hash_aset(res, rb_id2sym(rb_intern("flags")), UINT2NUM(resp.flags));
-    rb_hash_aset(res, rb_id2sym(rb_intern("replica")), resp.replica ? Qtrue : Qfalse);
+    rb_hash_aset(res, cb_symbols.content, cb_str_new(std::move(resp.value)));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.flags, UINT2NUM(resp.flags));
+    rb_hash_aset(res, cb_symbols.replica, resp.replica ? Qtrue : Qfalse);
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -221,7 +461,7 @@ cb_Backend_document_get_all_replicas(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::get_all_replicas_response> promise;
+    cb_promise<core::operations::get_all_replicas_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -234,12 +474,12 @@ cb_Backend_document_get_all_replicas(VALUE self,
 
     VALUE res = rb_ary_new_capa(static_cast<long>(resp.entries.size()));
 
-    for (const auto& entry : resp.entries) {
+    for (auto& entry : resp.entries) {
       VALUE response = rb_hash_new();
-      rb_hash_aset(response, rb_id2sym(rb_intern("content")), cb_str_new(entry.value));
-      rb_hash_aset(response, rb_id2sym(rb_intern("cas")), cb_cas_to_num(entry.cas));
-      rb_hash_aset(response, rb_id2sym(rb_intern("flags")), UINT2NUM(entry.flags));
-      rb_hash_aset(response, rb_id2sym(rb_intern("replica")), entry.replica ? Qtrue : Qfalse);
+      rb_hash_aset(response, cb_symbols.content, cb_str_new(std::move(entry.value)));
+      rb_hash_aset(response, cb_symbols.cas, cb_cas_to_num(entry.cas));
+      rb_hash_aset(response, cb_symbols.flags, UINT2NUM(entry.flags));
+      rb_hash_aset(response, cb_symbols.replica, entry.replica ? Qtrue : Qfalse);
       rb_ary_push(res, response);
     }
     return res;
@@ -299,7 +539,7 @@ cb_Backend_document_get_projected(VALUE self,
       }
     }
 
-    std::promise<core::operations::get_projected_response> promise;
+    cb_promise<core::operations::get_projected_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -311,11 +551,11 @@ cb_Backend_document_get_projected(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("content")), cb_str_new(resp.value));
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
-    rb_hash_aset(res, rb_id2sym(rb_intern("flags")), UINT2NUM(resp.flags));
+    rb_hash_aset(res, cb_symbols.content, cb_str_new(std::move(resp.value)));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.flags, UINT2NUM(resp.flags));
     if (resp.expiry) {
-      rb_hash_aset(res, rb_id2sym(rb_intern("expiry")), UINT2NUM(resp.expiry.value()));
+      rb_hash_aset(res, cb_symbols.expiry, UINT2NUM(resp.expiry.value()));
     }
     return res;
   } catch (const std::system_error& se) {
@@ -362,7 +602,7 @@ cb_Backend_document_get_and_lock(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::get_and_lock_response> promise;
+    cb_promise<core::operations::get_and_lock_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -374,9 +614,9 @@ cb_Backend_document_get_and_lock(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("content")), cb_str_new(resp.value));
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
-    rb_hash_aset(res, rb_id2sym(rb_intern("flags")), UINT2NUM(resp.flags));
+    rb_hash_aset(res, cb_symbols.content, cb_str_new(std::move(resp.value)));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.flags, UINT2NUM(resp.flags));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -422,7 +662,7 @@ cb_Backend_document_get_and_touch(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::get_and_touch_response> promise;
+    cb_promise<core::operations::get_and_touch_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -434,9 +674,9 @@ cb_Backend_document_get_and_touch(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("content")), cb_str_new(resp.value));
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
-    rb_hash_aset(res, rb_id2sym(rb_intern("flags")), UINT2NUM(resp.flags));
+    rb_hash_aset(res, cb_symbols.content, cb_str_new(std::move(resp.value)));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.flags, UINT2NUM(resp.flags));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -482,7 +722,7 @@ cb_Backend_document_touch(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::touch_response> promise;
+    cb_promise<core::operations::touch_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -494,7 +734,7 @@ cb_Backend_document_touch(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -537,7 +777,7 @@ cb_Backend_document_exists(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::exists_response> promise;
+    cb_promise<core::operations::exists_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -549,13 +789,13 @@ cb_Backend_document_exists(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
-    rb_hash_aset(res, rb_id2sym(rb_intern("exists")), resp.exists() ? Qtrue : Qfalse);
-    rb_hash_aset(res, rb_id2sym(rb_intern("deleted")), resp.deleted ? Qtrue : Qfalse);
-    rb_hash_aset(res, rb_id2sym(rb_intern("flags")), UINT2NUM(resp.flags));
-    rb_hash_aset(res, rb_id2sym(rb_intern("expiry")), UINT2NUM(resp.expiry));
-    rb_hash_aset(res, rb_id2sym(rb_intern("sequence_number")), ULL2NUM(resp.sequence_number));
-    rb_hash_aset(res, rb_id2sym(rb_intern("datatype")), UINT2NUM(resp.datatype));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.exists, resp.exists() ? Qtrue : Qfalse);
+    rb_hash_aset(res, cb_symbols.deleted, resp.deleted ? Qtrue : Qfalse);
+    rb_hash_aset(res, cb_symbols.flags, UINT2NUM(resp.flags));
+    rb_hash_aset(res, cb_symbols.expiry, UINT2NUM(resp.expiry));
+    rb_hash_aset(res, cb_symbols.sequence_number, ULL2NUM(resp.sequence_number));
+    rb_hash_aset(res, cb_symbols.datatype, UINT2NUM(resp.datatype));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -600,7 +840,7 @@ cb_Backend_document_unlock(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::unlock_response> promise;
+    cb_promise<core::operations::unlock_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -612,7 +852,7 @@ cb_Backend_document_unlock(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -664,7 +904,7 @@ cb_Backend_document_upsert(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::upsert_response> promise;
+    cb_promise<core::operations::upsert_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -690,7 +930,7 @@ cb_Backend_document_upsert(VALUE self,
       cb_throw_error(resp.ctx, "unable to upsert");
     }
 
-    return cb_create_mutation_result(resp);
+    return cb_create_mutation_response(resp);
 
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -738,7 +978,7 @@ cb_Backend_document_append(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::append_response> promise;
+    cb_promise<core::operations::append_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -764,7 +1004,7 @@ cb_Backend_document_append(VALUE self,
       cb_throw_error(resp.ctx, "unable to append");
     }
 
-    return cb_create_mutation_result(resp);
+    return cb_create_mutation_response(resp);
 
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -812,7 +1052,7 @@ cb_Backend_document_prepend(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::prepend_response> promise;
+    cb_promise<core::operations::prepend_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -838,7 +1078,7 @@ cb_Backend_document_prepend(VALUE self,
       cb_throw_error(resp.ctx, "unable to prepend");
     }
 
-    return cb_create_mutation_result(resp);
+    return cb_create_mutation_response(resp);
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -890,7 +1130,7 @@ cb_Backend_document_replace(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::replace_response> promise;
+    cb_promise<core::operations::replace_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -915,7 +1155,7 @@ cb_Backend_document_replace(VALUE self,
     if (resp.ctx.ec()) {
       cb_throw_error(resp.ctx, "unable to replace");
     }
-    return cb_create_mutation_result(resp);
+    return cb_create_mutation_response(resp);
 
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -966,7 +1206,7 @@ cb_Backend_document_insert(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::insert_response> promise;
+    cb_promise<core::operations::insert_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -990,7 +1230,7 @@ cb_Backend_document_insert(VALUE self,
     if (resp.ctx.ec()) {
       cb_throw_error(resp.ctx, "unable to insert");
     }
-    return cb_create_mutation_result(resp);
+    return cb_create_mutation_response(resp);
 
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -1035,7 +1275,7 @@ cb_Backend_document_remove(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::remove_response> promise;
+    cb_promise<core::operations::remove_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -1060,7 +1300,7 @@ cb_Backend_document_remove(VALUE self,
     if (resp.ctx.ec()) {
       cb_throw_error(resp.ctx, "unable to remove");
     }
-    return cb_create_mutation_result(resp);
+    return cb_create_mutation_response(resp);
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -1107,7 +1347,7 @@ cb_Backend_document_increment(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::increment_response> promise;
+    cb_promise<core::operations::increment_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -1134,7 +1374,7 @@ cb_Backend_document_increment(VALUE self,
     }
 
     VALUE res = cb_create_mutation_result(resp);
-    rb_hash_aset(res, rb_id2sym(rb_intern("content")), ULL2NUM(resp.content));
+    rb_hash_aset(res, cb_symbols.content, ULL2NUM(resp.content));
     return res;
 
   } catch (const std::system_error& se) {
@@ -1183,7 +1423,7 @@ cb_Backend_document_decrement(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::decrement_response> promise;
+    cb_promise<core::operations::decrement_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -1210,7 +1450,7 @@ cb_Backend_document_decrement(VALUE self,
     }
 
     VALUE res = cb_create_mutation_result(resp);
-    rb_hash_aset(res, rb_id2sym(rb_intern("content")), ULL2NUM(resp.content));
+    rb_hash_aset(res, cb_symbols.content, ULL2NUM(resp.content));
     return res;
 
   } catch (const std::system_error& se) {
@@ -1258,46 +1498,13 @@ cb_Backend_document_lookup_in(VALUE self,
     core::operations::lookup_in_request req{ doc_id };
     cb_extract_timeout(req, options);
     cb_extract_option_bool(req.access_deleted, options, "access_deleted");
+    auto json = cb_extract_json_decode_options(options);
 
-    static VALUE xattr_property = rb_id2sym(rb_intern("xattr"));
-    static VALUE path_property = rb_id2sym(rb_intern("path"));
-    static VALUE opcode_property = rb_id2sym(rb_intern("opcode"));
-
-    auto entries_size = static_cast<std::size_t>(RARRAY_LEN(specs));
-    for (std::size_t i = 0; i < entries_size; ++i) {
-      VALUE entry = rb_ary_entry(specs, static_cast<long>(i));
-      cb_check_type(entry, T_HASH);
-      VALUE operation = rb_hash_aref(entry, opcode_property);
-      cb_check_type(operation, T_SYMBOL);
-      bool xattr = RTEST(rb_hash_aref(entry, xattr_property));
-      VALUE path = rb_hash_aref(entry, path_property);
-      cb_check_type(path, T_STRING);
-      auto opcode = core::impl::subdoc::opcode{};
-      if (ID operation_id = rb_sym2id(operation); operation_id == rb_intern("get_doc")) {
-        opcode = core::impl::subdoc::opcode::get_doc;
-      } else if (operation_id == rb_intern("get")) {
-        opcode = core::impl::subdoc::opcode::get;
-      } else if (operation_id == rb_intern("exists")) {
-        opcode = core::impl::subdoc::opcode::exists;
-      } else if (operation_id == rb_intern("count")) {
-        opcode = core::impl::subdoc::opcode::get_count;
-      } else {
-        throw ruby_exception(
-          exc_invalid_argument(),
-          rb_sprintf("unsupported operation for subdocument lookup: %+" PRIsVALUE, operation));
-      }
-      cb_check_type(path, T_STRING);
-
-      req.specs.emplace_back(core::impl::subdoc::command{
-        opcode,
-        cb_string_new(path),
-        {},
-        core::impl::subdoc::build_lookup_in_path_flags(xattr, false) });
-    }
+    cb_extract_lookup_in_specs(req.specs, specs);
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::lookup_in_response> promise;
+    cb_promise<core::operations::lookup_in_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -1308,41 +1515,7 @@ cb_Backend_document_lookup_in(VALUE self,
       cb_throw_error(resp.ctx, "unable to perform lookup_in operation");
     }
 
-    static VALUE deleted_property = rb_id2sym(rb_intern("deleted"));
-    static VALUE fields_property = rb_id2sym(rb_intern("fields"));
-    static VALUE index_property = rb_id2sym(rb_intern("index"));
-    static VALUE exists_property = rb_id2sym(rb_intern("exists"));
-    static VALUE cas_property = rb_id2sym(rb_intern("cas"));
-    static VALUE value_property = rb_id2sym(rb_intern("value"));
-    static VALUE error_property = rb_id2sym(rb_intern("error"));
-
-    VALUE res = rb_hash_new();
-    rb_hash_aset(res, cas_property, cb_cas_to_num(resp.cas));
-    VALUE fields = rb_ary_new_capa(static_cast<long>(entries_size));
-    rb_hash_aset(res, fields_property, fields);
-    rb_hash_aset(res, deleted_property, resp.deleted ? Qtrue : Qfalse);
-    for (std::size_t i = 0; i < entries_size; ++i) {
-      auto resp_entry = resp.fields.at(i);
-      VALUE entry = rb_hash_new();
-      rb_hash_aset(entry, index_property, ULL2NUM(resp_entry.original_index));
-      rb_hash_aset(entry, exists_property, resp_entry.exists ? Qtrue : Qfalse);
-      rb_hash_aset(entry, path_property, cb_str_new(resp_entry.path));
-      if (!resp_entry.value.empty()) {
-        rb_hash_aset(entry, value_property, cb_str_new(resp_entry.value));
-      }
-      if (resp_entry.ec) {
-        rb_hash_aset(
-          entry,
-          error_property,
-          cb_map_error_code(resp_entry.ec,
-                            fmt::format("error getting result for spec at index {}, path \"{}\"",
-                                        i,
-                                        resp_entry.path)));
-      }
-
-      rb_ary_store(fields, static_cast<long>(i), entry);
-    }
-    return res;
+    return cb_create_lookup_in_result(resp, json);
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -1362,7 +1535,6 @@ cb_Backend_document_lookup_in_any_replica(VALUE self,
                                           VALUE options,
                                           VALUE observability_handler)
 {
-
   auto cluster = cb_backend_to_core_api_cluster(self);
 
   Check_Type(bucket, T_STRING);
@@ -1391,7 +1563,6 @@ cb_Backend_document_lookup_in_any_replica(VALUE self,
     cb_extract_read_preference(req, options);
 
     static VALUE xattr_property = rb_id2sym(rb_intern("xattr"));
-    static VALUE path_property = rb_id2sym(rb_intern("path"));
     static VALUE opcode_property = rb_id2sym(rb_intern("opcode"));
 
     auto entries_size = static_cast<std::size_t>(RARRAY_LEN(specs));
@@ -1401,7 +1572,7 @@ cb_Backend_document_lookup_in_any_replica(VALUE self,
       VALUE operation = rb_hash_aref(entry, opcode_property);
       cb_check_type(operation, T_SYMBOL);
       bool xattr = RTEST(rb_hash_aref(entry, xattr_property));
-      VALUE path = rb_hash_aref(entry, path_property);
+      VALUE path = rb_hash_aref(entry, cb_symbols.path);
       cb_check_type(path, T_STRING);
       auto opcode = core::impl::subdoc::opcode{};
       if (ID operation_id = rb_sym2id(operation); operation_id == rb_intern("get_doc")) {
@@ -1427,7 +1598,7 @@ cb_Backend_document_lookup_in_any_replica(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::lookup_in_any_replica_response> promise;
+    cb_promise<core::operations::lookup_in_any_replica_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -1438,35 +1609,28 @@ cb_Backend_document_lookup_in_any_replica(VALUE self,
       cb_throw_error(resp.ctx, "unable to perform lookup_in_any_replica operation");
     }
 
-    static VALUE deleted_property = rb_id2sym(rb_intern("deleted"));
-    static VALUE fields_property = rb_id2sym(rb_intern("fields"));
-    static VALUE index_property = rb_id2sym(rb_intern("index"));
-    static VALUE exists_property = rb_id2sym(rb_intern("exists"));
-    static VALUE cas_property = rb_id2sym(rb_intern("cas"));
-    static VALUE value_property = rb_id2sym(rb_intern("value"));
-    static VALUE error_property = rb_id2sym(rb_intern("error"));
     static VALUE is_replica_property = rb_id2sym(rb_intern("is_replica"));
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, cas_property, cb_cas_to_num(resp.cas));
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
     VALUE fields = rb_ary_new_capa(static_cast<long>(entries_size));
-    rb_hash_aset(res, fields_property, fields);
-    rb_hash_aset(res, deleted_property, resp.deleted ? Qtrue : Qfalse);
+    rb_hash_aset(res, cb_symbols.fields, fields);
+    rb_hash_aset(res, cb_symbols.deleted, resp.deleted ? Qtrue : Qfalse);
     rb_hash_aset(res, is_replica_property, resp.is_replica ? Qtrue : Qfalse);
 
     for (std::size_t i = 0; i < entries_size; ++i) {
       auto resp_entry = resp.fields.at(i);
       VALUE entry = rb_hash_new();
-      rb_hash_aset(entry, index_property, ULL2NUM(resp_entry.original_index));
-      rb_hash_aset(entry, exists_property, resp_entry.exists ? Qtrue : Qfalse);
-      rb_hash_aset(entry, path_property, cb_str_new(resp_entry.path));
+      rb_hash_aset(entry, cb_symbols.index, ULL2NUM(resp_entry.original_index));
+      rb_hash_aset(entry, cb_symbols.exists, resp_entry.exists ? Qtrue : Qfalse);
+      rb_hash_aset(entry, cb_symbols.path, cb_str_new(resp_entry.path));
       if (!resp_entry.value.empty()) {
-        rb_hash_aset(entry, value_property, cb_str_new(resp_entry.value));
+        rb_hash_aset(entry, cb_symbols.value, cb_str_new(resp_entry.value));
       }
       if (resp_entry.ec) {
         rb_hash_aset(
           entry,
-          error_property,
+          cb_symbols.error,
           cb_map_error_code(resp_entry.ec,
                             fmt::format("error getting result for spec at index {}, path \"{}\"",
                                         i,
@@ -1523,7 +1687,6 @@ cb_Backend_document_lookup_in_all_replicas(VALUE self,
     cb_extract_read_preference(req, options);
 
     static VALUE xattr_property = rb_id2sym(rb_intern("xattr"));
-    static VALUE path_property = rb_id2sym(rb_intern("path"));
     static VALUE opcode_property = rb_id2sym(rb_intern("opcode"));
 
     auto entries_size = static_cast<std::size_t>(RARRAY_LEN(specs));
@@ -1533,7 +1696,7 @@ cb_Backend_document_lookup_in_all_replicas(VALUE self,
       VALUE operation = rb_hash_aref(entry, opcode_property);
       cb_check_type(operation, T_SYMBOL);
       bool xattr = RTEST(rb_hash_aref(entry, xattr_property));
-      VALUE path = rb_hash_aref(entry, path_property);
+      VALUE path = rb_hash_aref(entry, cb_symbols.path);
       cb_check_type(path, T_STRING);
 
       auto opcode = core::impl::subdoc::opcode{};
@@ -1561,7 +1724,7 @@ cb_Backend_document_lookup_in_all_replicas(VALUE self,
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::lookup_in_all_replicas_response> promise;
+    cb_promise<core::operations::lookup_in_all_replicas_response> promise;
     auto f = promise.get_future();
     cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
       promise.set_value(std::forward<decltype(resp)>(resp));
@@ -1572,13 +1735,6 @@ cb_Backend_document_lookup_in_all_replicas(VALUE self,
       cb_throw_error(resp.ctx, "unable to perform lookup_in_all_replicas operation");
     }
 
-    static VALUE deleted_property = rb_id2sym(rb_intern("deleted"));
-    static VALUE fields_property = rb_id2sym(rb_intern("fields"));
-    static VALUE index_property = rb_id2sym(rb_intern("index"));
-    static VALUE exists_property = rb_id2sym(rb_intern("exists"));
-    static VALUE cas_property = rb_id2sym(rb_intern("cas"));
-    static VALUE value_property = rb_id2sym(rb_intern("value"));
-    static VALUE error_property = rb_id2sym(rb_intern("error"));
     static VALUE is_replica_property = rb_id2sym(rb_intern("is_replica"));
 
     auto lookup_in_entries_size = resp.entries.size();
@@ -1586,10 +1742,11 @@ cb_Backend_document_lookup_in_all_replicas(VALUE self,
     for (std::size_t j = 0; j < lookup_in_entries_size; ++j) {
       auto lookup_in_entry = resp.entries.at(j);
       VALUE lookup_in_entry_res = rb_hash_new();
-      rb_hash_aset(lookup_in_entry_res, cas_property, cb_cas_to_num(lookup_in_entry.cas));
+      rb_hash_aset(lookup_in_entry_res, cb_symbols.cas, cb_cas_to_num(lookup_in_entry.cas));
       VALUE fields = rb_ary_new_capa(static_cast<long>(entries_size));
-      rb_hash_aset(lookup_in_entry_res, fields_property, fields);
-      rb_hash_aset(lookup_in_entry_res, deleted_property, lookup_in_entry.deleted ? Qtrue : Qfalse);
+      rb_hash_aset(lookup_in_entry_res, cb_symbols.fields, fields);
+      rb_hash_aset(
+        lookup_in_entry_res, cb_symbols.deleted, lookup_in_entry.deleted ? Qtrue : Qfalse);
 
       rb_hash_aset(
         lookup_in_entry_res, is_replica_property, lookup_in_entry.is_replica ? Qtrue : Qfalse);
@@ -1597,16 +1754,16 @@ cb_Backend_document_lookup_in_all_replicas(VALUE self,
       for (std::size_t i = 0; i < entries_size; ++i) {
         auto field_entry = lookup_in_entry.fields.at(i);
         VALUE entry = rb_hash_new();
-        rb_hash_aset(entry, index_property, ULL2NUM(field_entry.original_index));
-        rb_hash_aset(entry, exists_property, field_entry.exists ? Qtrue : Qfalse);
-        rb_hash_aset(entry, path_property, cb_str_new(field_entry.path));
+        rb_hash_aset(entry, cb_symbols.index, ULL2NUM(field_entry.original_index));
+        rb_hash_aset(entry, cb_symbols.exists, field_entry.exists ? Qtrue : Qfalse);
+        rb_hash_aset(entry, cb_symbols.path, cb_str_new(field_entry.path));
         if (!field_entry.value.empty()) {
-          rb_hash_aset(entry, value_property, cb_str_new(field_entry.value));
+          rb_hash_aset(entry, cb_symbols.value, cb_str_new(field_entry.value));
         }
         if (field_entry.ec) {
           rb_hash_aset(
             entry,
-            error_property,
+            cb_symbols.error,
             cb_map_error_code(field_entry.ec,
                               fmt::format("error getting result for spec at index {}, path \"{}\"",
                                           i,
@@ -1672,108 +1829,11 @@ cb_Backend_document_mutate_in(VALUE self,
     cb_extract_cas(req, options);
     cb_extract_store_semantics(req, options);
 
-    static VALUE xattr_property = rb_id2sym(rb_intern("xattr"));
-    static VALUE create_path_property = rb_id2sym(rb_intern("create_path"));
-    static VALUE expand_macros_property = rb_id2sym(rb_intern("expand_macros"));
-    static VALUE path_property = rb_id2sym(rb_intern("path"));
-    static VALUE opcode_property = rb_id2sym(rb_intern("opcode"));
-    static VALUE param_property = rb_id2sym(rb_intern("param"));
-
-    couchbase::mutate_in_specs cxx_specs;
-    {
-      auto entries_size = static_cast<std::size_t>(RARRAY_LEN(specs));
-      for (std::size_t i = 0; i < entries_size; ++i) {
-        VALUE entry = rb_ary_entry(specs, static_cast<long>(i));
-        cb_check_type(entry, T_HASH);
-        bool xattr = RTEST(rb_hash_aref(entry, xattr_property));
-        bool create_path = RTEST(rb_hash_aref(entry, create_path_property));
-        bool expand_macros = RTEST(rb_hash_aref(entry, expand_macros_property));
-        VALUE path = rb_hash_aref(entry, path_property);
-        cb_check_type(path, T_STRING);
-        VALUE operation = rb_hash_aref(entry, opcode_property);
-        cb_check_type(operation, T_SYMBOL);
-        VALUE param = rb_hash_aref(entry, param_property);
-        if (ID operation_id = rb_sym2id(operation); operation_id == rb_intern("dict_add")) {
-          cb_check_type(param, T_STRING);
-          cxx_specs.push_back(couchbase::mutate_in_specs::insert_raw(
-                                cb_string_new(path), cb_binary_new(param), expand_macros)
-                                .xattr(xattr)
-                                .create_path(create_path));
-        } else if (operation_id == rb_intern("dict_upsert")) {
-          cb_check_type(param, T_STRING);
-
-          cxx_specs.push_back(couchbase::mutate_in_specs::upsert_raw(
-                                cb_string_new(path), cb_binary_new(param), expand_macros)
-                                .xattr(xattr)
-                                .create_path(create_path));
-        } else if (operation_id == rb_intern("remove")) {
-          cxx_specs.push_back(couchbase::mutate_in_specs::remove(cb_string_new(path)).xattr(xattr));
-        } else if (operation_id == rb_intern("replace")) {
-          cb_check_type(param, T_STRING);
-          cxx_specs.push_back(couchbase::mutate_in_specs::replace_raw(
-                                cb_string_new(path), cb_binary_new(param), expand_macros)
-                                .xattr(xattr));
-        } else if (operation_id == rb_intern("array_push_last")) {
-          cb_check_type(param, T_STRING);
-          cxx_specs.push_back(
-            couchbase::mutate_in_specs::array_append_raw(cb_string_new(path), cb_binary_new(param))
-              .xattr(xattr)
-              .create_path(create_path));
-        } else if (operation_id == rb_intern("array_push_first")) {
-          cb_check_type(param, T_STRING);
-          cxx_specs.push_back(
-            couchbase::mutate_in_specs::array_prepend_raw(cb_string_new(path), cb_binary_new(param))
-              .xattr(xattr)
-              .create_path(create_path));
-        } else if (operation_id == rb_intern("array_insert")) {
-          cb_check_type(param, T_STRING);
-          cxx_specs.push_back(
-            couchbase::mutate_in_specs::array_insert_raw(cb_string_new(path), cb_binary_new(param))
-              .xattr(xattr)
-              .create_path(create_path));
-        } else if (operation_id == rb_intern("array_add_unique")) {
-          cb_check_type(param, T_STRING);
-          cxx_specs.push_back(couchbase::mutate_in_specs::array_add_unique_raw(
-                                cb_string_new(path), cb_binary_new(param), expand_macros)
-                                .xattr(xattr)
-                                .create_path(create_path));
-        } else if (operation_id == rb_intern("counter")) {
-          if (TYPE(param) == T_FIXNUM || TYPE(param) == T_BIGNUM) {
-            if (std::int64_t num = NUM2LL(param); num < 0) {
-              cxx_specs.push_back(
-                couchbase::mutate_in_specs::decrement(cb_string_new(path), -1 * num)
-                  .xattr(xattr)
-                  .create_path(create_path));
-            } else {
-              cxx_specs.push_back(couchbase::mutate_in_specs::increment(cb_string_new(path), num)
-                                    .xattr(xattr)
-                                    .create_path(create_path));
-            }
-          } else {
-            throw ruby_exception(
-              exc_invalid_argument(),
-              rb_sprintf("subdocument counter operation expects number, but given: %+" PRIsVALUE,
-                         param));
-          }
-        } else if (operation_id == rb_intern("set_doc")) {
-          cb_check_type(param, T_STRING);
-          cxx_specs.push_back(
-            couchbase::mutate_in_specs::replace_raw("", cb_binary_new(param), expand_macros)
-              .xattr(xattr));
-        } else if (operation_id == rb_intern("remove_doc")) {
-          cxx_specs.push_back(couchbase::mutate_in_specs::remove("").xattr(xattr));
-        } else {
-          throw ruby_exception(
-            exc_invalid_argument(),
-            rb_sprintf("unsupported operation for subdocument mutation: %+" PRIsVALUE, operation));
-        }
-      }
-    }
-    req.specs = cxx_specs.specs();
+    cb_extract_mutate_in_specs(req.specs, specs);
 
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::mutate_in_response> promise;
+    cb_promise<core::operations::mutate_in_response> promise;
     auto f = promise.get_future();
 
     if (const auto legacy_durability = extract_legacy_durability_constraints(options);
@@ -1799,28 +1859,283 @@ cb_Backend_document_mutate_in(VALUE self,
       cb_throw_error(resp.ctx, "unable to mutate_in");
     }
 
-    static VALUE deleted_property = rb_id2sym(rb_intern("deleted"));
-    static VALUE fields_property = rb_id2sym(rb_intern("fields"));
-    static VALUE index_property = rb_id2sym(rb_intern("index"));
-    static VALUE value_property = rb_id2sym(rb_intern("value"));
+    return cb_create_mutate_in_result(resp, specs);
 
-    VALUE res = cb_create_mutation_result(resp);
-    rb_hash_aset(res, deleted_property, resp.deleted ? Qtrue : Qfalse);
-    VALUE fields = rb_ary_new_capa(static_cast<long>(resp.fields.size()));
-    rb_hash_aset(res, fields_property, fields);
-    for (std::size_t i = 0; i < resp.fields.size(); ++i) {
-      VALUE entry = rb_hash_new();
-      rb_hash_aset(entry, index_property, ULL2NUM(i));
-      rb_hash_aset(entry,
-                   path_property,
-                   rb_hash_aref(rb_ary_entry(specs, static_cast<long>(i)), path_property));
-      if (!resp.fields.at(i).value.empty()) {
-        rb_hash_aset(entry, value_property, cb_str_new(resp.fields.at(i).value));
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+/**
+ * Dispatches request without waiting, the response will be converted by the builder only when
+ * the PendingResult#value is requested.
+ */
+template<typename Request, typename Builder>
+VALUE
+cb_execute_async(core::cluster& cluster, Request&& req, Builder builder)
+{
+  cb_promise<cb_result_builder> promise;
+  auto f = promise.get_future();
+  cluster.execute(std::forward<Request>(req),
+                  [promise = std::move(promise), builder](auto&& resp) mutable {
+                    promise.set_value(cb_result_builder{
+                      [resp = std::forward<decltype(resp)>(resp), builder]() mutable {
+                        return builder(resp);
+                      },
+                    });
+                  });
+  return cb_pending_result_new(std::move(f));
+}
+
+template<typename Request, typename Builder>
+VALUE
+cb_execute_mutation_async(core::cluster& cluster, Request&& req, VALUE options, Builder builder)
+{
+  if (const auto legacy_durability = extract_legacy_durability_constraints(options);
+      legacy_durability.has_value()) {
+    return cb_execute_async(
+      cluster,
+      typename with_legacy_durability<std::decay_t<Request>>::type{
+        std::forward<Request>(req),
+        legacy_durability.value().first,
+        legacy_durability.value().second,
+      },
+      builder);
+  }
+  return cb_execute_async(cluster, std::forward<Request>(req), builder);
+}
+
+VALUE
+cb_Backend_document_get_async(VALUE self,
+                              VALUE bucket,
+                              VALUE scope,
+                              VALUE collection,
+                              VALUE id,
+                              VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(bucket, T_STRING);
+  Check_Type(scope, T_STRING);
+  Check_Type(collection, T_STRING);
+  Check_Type(id, T_STRING);
+
+  try {
+    core::operations::get_request req{ core::document_id{
+      cb_string_new(bucket),
+      cb_string_new(scope),
+      cb_string_new(collection),
+      cb_string_new(id),
+    } };
+    cb_extract_timeout(req, options);
+    auto json = cb_extract_json_decode_options(options);
+
+    return cb_execute_async(cluster, std::move(req), [json](auto& resp) {
+      if (resp.ctx.ec()) {
+        cb_throw_error(resp.ctx, "unable to fetch document");
       }
-      rb_ary_store(fields, static_cast<long>(i), entry);
+      return cb_create_get_response(std::move(resp), json);
+    });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+template<typename Request>
+VALUE
+cb_document_store_async(VALUE self,
+                        VALUE bucket,
+                        VALUE scope,
+                        VALUE collection,
+                        VALUE id,
+                        VALUE content,
+                        VALUE flags,
+                        VALUE options,
+                        const char* error_message)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(bucket, T_STRING);
+  Check_Type(scope, T_STRING);
+  Check_Type(collection, T_STRING);
+  Check_Type(id, T_STRING);
+  Check_Type(content, T_STRING);
+  Check_Type(flags, T_FIXNUM);
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    Request req{
+      core::document_id{
+        cb_string_new(bucket),
+        cb_string_new(scope),
+        cb_string_new(collection),
+        cb_string_new(id),
+      },
+    };
+    cb_extract_content(req, content);
+    cb_extract_flags(req, flags);
+    cb_extract_timeout(req, options);
+    cb_extract_expiry(req, options);
+    cb_extract_durability_level(req, options);
+    if constexpr (!std::is_same_v<Request, core::operations::insert_request>) {
+      cb_extract_preserve_expiry(req, options);
     }
-    return res;
+    if constexpr (std::is_same_v<Request, core::operations::replace_request>) {
+      cb_extract_cas(req, options);
+    }
+
+    return cb_execute_mutation_async(
+      cluster, std::move(req), options, [error_message](const auto& resp) {
+        if (resp.ctx.ec()) {
+          cb_throw_error(resp.ctx, error_message);
+        }
+        return cb_create_mutation_response(resp);
+      });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_upsert_async(VALUE self,
+                                 VALUE bucket,
+                                 VALUE scope,
+                                 VALUE collection,
+                                 VALUE id,
+                                 VALUE content,
+                                 VALUE flags,
+                                 VALUE options)
+{
+  return cb_document_store_async<core::operations::upsert_request>(
+    self, bucket, scope, collection, id, content, flags, options, "unable to upsert");
+}
+
+VALUE
+cb_Backend_document_insert_async(VALUE self,
+                                 VALUE bucket,
+                                 VALUE scope,
+                                 VALUE collection,
+                                 VALUE id,
+                                 VALUE content,
+                                 VALUE flags,
+                                 VALUE options)
+{
+  return cb_document_store_async<core::operations::insert_request>(
+    self, bucket, scope, collection, id, content, flags, options, "unable to insert");
+}
+
+VALUE
+cb_Backend_document_replace_async(VALUE self,
+                                  VALUE bucket,
+                                  VALUE scope,
+                                  VALUE collection,
+                                  VALUE id,
+                                  VALUE content,
+                                  VALUE flags,
+                                  VALUE options)
+{
+  return cb_document_store_async<core::operations::replace_request>(
+    self, bucket, scope, collection, id, content, flags, options, "unable to replace");
+}
+
+VALUE
+cb_Backend_document_remove_async(VALUE self,
+                                 VALUE bucket,
+                                 VALUE scope,
+                                 VALUE collection,
+                                 VALUE id,
+                                 VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(bucket, T_STRING);
+  Check_Type(scope, T_STRING);
+  Check_Type(collection, T_STRING);
+  Check_Type(id, T_STRING);
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
 
+  try {
+    core::operations::remove_request req{
+      core::document_id{
+        cb_string_new(bucket),
+        cb_string_new(scope),
+        cb_string_new(collection),
+        cb_string_new(id),
+      },
+    };
+    cb_extract_timeout(req, options);
+    cb_extract_durability_level(req, options);
+    cb_extract_cas(req, options);
+
+    return cb_execute_mutation_async(cluster, std::move(req), options, [](const auto& resp) {
+      if (resp.ctx.ec()) {
+        cb_throw_error(resp.ctx, "unable to remove");
+      }
+      return cb_create_mutation_response(resp);
+    });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_touch_async(VALUE self,
+                                VALUE bucket,
+                                VALUE scope,
+                                VALUE collection,
+                                VALUE id,
+                                VALUE expiry,
+                                VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(bucket, T_STRING);
+  Check_Type(scope, T_STRING);
+  Check_Type(collection, T_STRING);
+  Check_Type(id, T_STRING);
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::touch_request req{ core::document_id{
+      cb_string_new(bucket),
+      cb_string_new(scope),
+      cb_string_new(collection),
+      cb_string_new(id),
+    } };
+    cb_extract_timeout(req, options);
+    auto [type, duration] = unpack_expiry(expiry, false);
+    req.expiry = static_cast<std::uint32_t>(duration.count());
+
+    return cb_execute_async(cluster, std::move(req), [](const auto& resp) {
+      if (resp.ctx.ec()) {
+        cb_throw_error(resp.ctx, "unable to touch");
+      }
+      VALUE res = rb_hash_new();
+      rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(resp.cas));
+      return res;
+    });
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -1835,6 +2150,26 @@ cb_Backend_document_mutate_in(VALUE self,
 void
 init_crud(VALUE cBackend)
 {
+  cGetResponse =
+    rb_struct_define_under(cBackend,
+                           "GetResponse",
+                           "content",
+                           "cas",
+                           "flags",
+                           "decoded",
+                           "decoded_content",
+                           nullptr);
+  rb_gc_register_mark_object(cGetResponse);
+  cMutationResponse = rb_struct_define_under(cBackend,
+                                             "MutationResponse",
+                                             "cas",
+                                             "partition_id",
+                                             "partition_uuid",
+                                             "sequence_number",
+                                             "bucket_name",
+                                             nullptr);
+  rb_gc_register_mark_object(cMutationResponse);
+
   rb_define_method(cBackend, "document_get", cb_Backend_document_get, 6);
   rb_define_method(cBackend, "document_get_any_replica", cb_Backend_document_get_any_replica, 6);
   rb_define_method(cBackend, "document_get_all_replicas", cb_Backend_document_get_all_replicas, 6);
@@ -1858,5 +2193,12 @@ init_crud(VALUE cBackend)
   rb_define_method(cBackend, "document_unlock", cb_Backend_document_unlock, 7);
   rb_define_method(cBackend, "document_increment", cb_Backend_document_increment, 6);
   rb_define_method(cBackend, "document_decrement", cb_Backend_document_decrement, 6);
+
+  rb_define_method(cBackend, "document_get_async", cb_Backend_document_get_async, 5);
+  rb_define_method(cBackend, "document_insert_async", cb_Backend_document_insert_async, 7);
+  rb_define_method(cBackend, "document_replace_async", cb_Backend_document_replace_async, 7);
+  rb_define_method(cBackend, "document_upsert_async", cb_Backend_document_upsert_async, 7);
+  rb_define_method(cBackend, "document_remove_async", cb_Backend_document_remove_async, 5);
+  rb_define_method(cBackend, "document_touch_async", cb_Backend_document_touch_async, 6);
 }
 } // namespace couchbase::ruby
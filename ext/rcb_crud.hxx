@@ -18,12 +18,105 @@
 #ifndef COUCHBASE_RUBY_RCB_CRUD_HXX
 #define COUCHBASE_RUBY_RCB_CRUD_HXX
 
+#include <core/impl/subdoc/command.hxx>
+#include <core/operations/document_append.hxx>
+#include <core/operations/document_decrement.hxx>
+#include <core/operations/document_increment.hxx>
+#include <core/operations/document_insert.hxx>
+#include <core/operations/document_lookup_in.hxx>
+#include <core/operations/document_mutate_in.hxx>
+#include <core/operations/document_prepend.hxx>
+#include <core/operations/document_remove.hxx>
+#include <core/operations/document_replace.hxx>
+#include <core/operations/document_upsert.hxx>
+
+#include <optional>
+#include <vector>
+
 #include <ruby/internal/value.h>
 
+#include "rcb_json.hxx"
+
 namespace couchbase::ruby
 {
 void
 init_crud(VALUE cBackend);
+
+void
+cb_extract_lookup_in_specs(std::vector<core::impl::subdoc::command>& commands, VALUE specs);
+
+void
+cb_extract_mutate_in_specs(std::vector<core::impl::subdoc::command>& commands, VALUE specs);
+
+VALUE
+cb_create_lookup_in_result(core::operations::lookup_in_response& resp,
+                           const std::optional<cb_json_decode_options>& json = {});
+
+VALUE
+cb_create_mutate_in_result(const core::operations::mutate_in_response& resp, VALUE specs);
+
+/**
+ * Maps KV request to its wrapper, that implements legacy (observe-based) durability. The
+ * requests that do not support durability at all are marked as not supported.
+ */
+template<typename Request>
+struct with_legacy_durability {
+  static constexpr bool supported = false;
+};
+
+template<>
+struct with_legacy_durability<core::operations::append_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::append_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::decrement_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::decrement_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::increment_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::increment_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::insert_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::insert_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::mutate_in_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::mutate_in_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::prepend_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::prepend_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::remove_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::remove_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::replace_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::replace_request_with_legacy_durability;
+};
+
+template<>
+struct with_legacy_durability<core::operations::upsert_request> {
+  static constexpr bool supported = true;
+  using type = core::operations::upsert_request_with_legacy_durability;
+};
 } // namespace couchbase::ruby
 
 #endif
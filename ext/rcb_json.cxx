@@ -0,0 +1,682 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <couchbase/error_codes.hxx>
+
+#include <spdlog/fmt/bundled/core.h>
+#include <tao/json/events/from_string.hpp>
+#include <tao/json/events/to_stream.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ruby.h>
+#include <ruby/encoding.h>
+#include <ruby/thread.h>
+
+#include "rcb_exceptions.hxx"
+#include "rcb_json.hxx"
+#include "rcb_utils.hxx"
+
+namespace couchbase::ruby
+{
+namespace
+{
+/*
+ * The same limit as the default of JSON.parse and JSON.generate. It also bounds the recursion
+ * depth of the builder and the encoder.
+ */
+constexpr std::size_t cb_json_max_nesting{ 100 };
+
+/*
+ * Releasing and re-acquiring GVL costs more than parsing of the small document.
+ */
+constexpr std::size_t cb_json_without_gvl_threshold{ 64 * 1024 };
+
+[[noreturn]] void
+cb_throw_encoding_failure(const std::string& message)
+{
+  throw ruby_exception(
+    cb_map_error_code(couchbase::errc::common::encoding_failure, message, false));
+}
+
+/**
+ * Flat representation of the parsed document in pre-order. Containers store number of their
+ * entries, and the members of the object are represented as pairs of key and value. It is
+ * filled by the tao::json event parser and does not reference Ruby objects, so that parsing
+ * might happen without GVL.
+ */
+struct cb_json_tape {
+  enum class kind : std::uint8_t {
+    null,
+    boolean,
+    signed_number,
+    unsigned_number,
+    double_number,
+    string,
+    key,
+    array,
+    object,
+  };
+
+  struct token {
+    kind type{ kind::null };
+    bool boolean{ false };
+    std::size_t size{ 0 };
+    union {
+      std::int64_t signed_number;
+      std::uint64_t unsigned_number;
+      double double_number;
+      std::size_t offset;
+    } value{};
+  };
+
+  std::vector<token> tokens{};
+  std::string strings{};
+  std::vector<std::size_t> open_containers{};
+
+  void null()
+  {
+    tokens.emplace_back();
+  }
+
+  void boolean(const bool v)
+  {
+    auto& t = tokens.emplace_back();
+    t.type = kind::boolean;
+    t.boolean = v;
+  }
+
+  void number(const std::int64_t v)
+  {
+    auto& t = tokens.emplace_back();
+    t.type = kind::signed_number;
+    t.value.signed_number = v;
+  }
+
+  void number(const std::uint64_t v)
+  {
+    auto& t = tokens.emplace_back();
+    t.type = kind::unsigned_number;
+    t.value.unsigned_number = v;
+  }
+
+  void number(const double v)
+  {
+    auto& t = tokens.emplace_back();
+    t.type = kind::double_number;
+    t.value.double_number = v;
+  }
+
+  void string(const std::string_view v)
+  {
+    append_string(kind::string, v);
+  }
+
+  void key(const std::string_view v)
+  {
+    append_string(kind::key, v);
+  }
+
+  void begin_array(const std::size_t /* size */ = 0)
+  {
+    begin_container(kind::array);
+  }
+
+  void element()
+  {
+    ++tokens[open_containers.back()].size;
+  }
+
+  void end_array(const std::size_t /* size */ = 0)
+  {
+    open_containers.pop_back();
+  }
+
+  void begin_object(const std::size_t /* size */ = 0)
+  {
+    begin_container(kind::object);
+  }
+
+  void member()
+  {
+    ++tokens[open_containers.back()].size;
+  }
+
+  void end_object(const std::size_t /* size */ = 0)
+  {
+    open_containers.pop_back();
+  }
+
+private:
+  void append_string(kind type, const std::string_view v)
+  {
+    auto& t = tokens.emplace_back();
+    t.type = type;
+    t.size = v.size();
+    t.value.offset = strings.size();
+    strings.append(v);
+  }
+
+  void begin_container(kind type)
+  {
+    if (open_containers.size() >= cb_json_max_nesting) {
+      throw std::runtime_error(
+        fmt::format("nesting of {} is too deep", open_containers.size() + 1));
+    }
+    open_containers.push_back(tokens.size());
+    tokens.emplace_back().type = type;
+  }
+};
+
+/**
+ * Materializes the tape into Ruby objects. Keys of the objects are either deduplicated frozen
+ * strings, or symbols.
+ */
+class cb_json_builder
+{
+public:
+  cb_json_builder(const cb_json_tape& tape, const cb_json_decode_options& options)
+    : tape_{ tape }
+    , options_{ options }
+  {
+  }
+
+  VALUE build()
+  {
+    return next_value();
+  }
+
+private:
+  VALUE next_value()
+  {
+    const auto& t = tape_.tokens[position_++];
+    switch (t.type) {
+      case cb_json_tape::kind::null:
+        return Qnil;
+
+      case cb_json_tape::kind::boolean:
+        return t.boolean ? Qtrue : Qfalse;
+
+      case cb_json_tape::kind::signed_number:
+        return LL2NUM(t.value.signed_number);
+
+      case cb_json_tape::kind::unsigned_number:
+        return ULL2NUM(t.value.unsigned_number);
+
+      case cb_json_tape::kind::double_number:
+        return DBL2NUM(t.value.double_number);
+
+      case cb_json_tape::kind::string:
+        return rb_utf8_str_new(tape_.strings.data() + t.value.offset, static_cast<long>(t.size));
+
+      case cb_json_tape::kind::array: {
+        VALUE array = rb_ary_new_capa(static_cast<long>(t.size));
+        for (std::size_t i = 0; i < t.size; ++i) {
+          rb_ary_push(array, next_value());
+        }
+        return array;
+      }
+
+      case cb_json_tape::kind::object: {
+        VALUE hash = rb_hash_new_capa(static_cast<long>(t.size));
+        for (std::size_t i = 0; i < t.size; ++i) {
+          VALUE key = next_key();
+          rb_hash_aset(hash, key, next_value());
+          RB_GC_GUARD(key);
+        }
+        return hash;
+      }
+
+      case cb_json_tape::kind::key:
+        break;
+    }
+    return Qnil;
+  }
+
+  VALUE next_key()
+  {
+    const auto& t = tape_.tokens[position_++];
+    VALUE key = rb_enc_interned_str(
+      tape_.strings.data() + t.value.offset, static_cast<long>(t.size), rb_utf8_encoding());
+    if (options_.symbolize_names) {
+      return rb_str_intern(key);
+    }
+    return key;
+  }
+
+  const cb_json_tape& tape_;
+  const cb_json_decode_options& options_;
+  std::size_t position_{ 0 };
+};
+
+/**
+ * Walks Ruby objects and feeds them as events to the tao::json writer, so that no intermediate
+ * DOM or Ruby strings are created.
+ */
+class cb_json_encoder
+{
+public:
+  std::string generate(VALUE object)
+  {
+    encode(object, 0);
+    return output_.str();
+  }
+
+private:
+  struct member_args {
+    cb_json_encoder* encoder;
+    std::size_t depth;
+    std::exception_ptr error{};
+  };
+
+  static int encode_member(VALUE key, VALUE value, VALUE arg)
+  {
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    auto* args = reinterpret_cast<member_args*>(arg);
+    try {
+      switch (TYPE(key)) {
+        case T_STRING:
+          break;
+        case T_SYMBOL:
+          key = rb_sym2str(key);
+          break;
+        default:
+          key = rb_obj_as_string(key);
+          break;
+      }
+      args->encoder->writer_.key(utf8_view(key));
+      args->encoder->encode(value, args->depth);
+      args->encoder->writer_.member();
+    } catch (...) {
+      args->error = std::current_exception();
+      return ST_STOP;
+    }
+    return ST_CONTINUE;
+  }
+
+  /*
+   * Returns content of the String as UTF-8, converting it if necessary. The String might be
+   * replaced with the converted copy, so the caller has to keep it reachable.
+   */
+  static std::string_view utf8_view(VALUE& str)
+  {
+    if (int index = rb_enc_get_index(str);
+        index != rb_utf8_encindex() && rb_enc_str_asciionly_p(str) == 0) {
+      if (index == rb_ascii8bit_encindex()) {
+        str = rb_enc_associate_index(rb_str_dup(str), rb_utf8_encindex());
+      } else {
+        str = rb_str_conv_enc(str, rb_enc_from_index(index), rb_utf8_encoding());
+      }
+    }
+    if ((rb_enc_get_index(str) != rb_utf8_encindex() && rb_enc_str_asciionly_p(str) == 0) ||
+        rb_enc_str_coderange(str) == ENC_CODERANGE_BROKEN) {
+      cb_throw_encoding_failure("source sequence is illegal/malformed utf-8");
+    }
+    return { RSTRING_PTR(str), static_cast<std::size_t>(RSTRING_LEN(str)) };
+  }
+
+  void encode_integer(VALUE number)
+  {
+    std::uint64_t magnitude{ 0 };
+    int sign = rb_integer_pack(number, &magnitude, 1, sizeof(magnitude), 0, INTEGER_PACK_NATIVE);
+    if (sign == 1) {
+      writer_.number(magnitude);
+      return;
+    }
+    if (sign == -1 &&
+        magnitude <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1) {
+      writer_.number(static_cast<std::int64_t>(0 - magnitude));
+      return;
+    }
+    cb_throw_encoding_failure("Integer does not fit into 64 bits");
+  }
+
+  void encode(VALUE object, std::size_t depth)
+  {
+    switch (TYPE(object)) {
+      case T_NIL:
+        writer_.null();
+        break;
+
+      case T_TRUE:
+        writer_.boolean(true);
+        break;
+
+      case T_FALSE:
+        writer_.boolean(false);
+        break;
+
+      case T_FIXNUM:
+        writer_.number(static_cast<std::int64_t>(FIX2LONG(object)));
+        break;
+
+      case T_BIGNUM:
+        encode_integer(object);
+        break;
+
+      case T_FLOAT:
+        if (double number = RFLOAT_VALUE(object); std::isfinite(number)) {
+          writer_.number(number);
+        } else {
+          cb_throw_encoding_failure(fmt::format("{} not allowed in JSON", number));
+        }
+        break;
+
+      case T_STRING:
+        writer_.string(utf8_view(object));
+        break;
+
+      case T_SYMBOL: {
+        VALUE name = rb_sym2str(object);
+        writer_.string(utf8_view(name));
+        RB_GC_GUARD(name);
+        break;
+      }
+
+      case T_ARRAY: {
+        check_nesting(depth + 1);
+        writer_.begin_array();
+        for (long i = 0; i < RARRAY_LEN(object); ++i) {
+          encode(rb_ary_entry(object, i), depth + 1);
+          writer_.element();
+        }
+        writer_.end_array();
+        break;
+      }
+
+      case T_HASH: {
+        check_nesting(depth + 1);
+        writer_.begin_object();
+        member_args args{ this, depth + 1 };
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        rb_hash_foreach(object, encode_member, reinterpret_cast<VALUE>(&args));
+        if (args.error) {
+          std::rethrow_exception(args.error);
+        }
+        writer_.end_object();
+        break;
+      }
+
+      default: {
+        static const ID id_to_json = rb_intern("to_json");
+        if (rb_respond_to(object, id_to_json) != 0) {
+          // the object knows how to represent itself, validate and embed its JSON as is
+          VALUE json = rb_funcall(object, id_to_json, 0);
+          cb_check_type(json, T_STRING);
+          try {
+            tao::json::events::from_string(
+              writer_, RSTRING_PTR(json), static_cast<std::size_t>(RSTRING_LEN(json)));
+          } catch (const std::runtime_error& e) {
+            cb_throw_encoding_failure(fmt::format(
+              "{}#to_json returned invalid JSON: {}", rb_obj_classname(object), e.what()));
+          }
+          RB_GC_GUARD(json);
+        } else {
+          VALUE str = rb_obj_as_string(object);
+          writer_.string(utf8_view(str));
+          RB_GC_GUARD(str);
+        }
+        break;
+      }
+    }
+  }
+
+  static void check_nesting(std::size_t depth)
+  {
+    if (depth > cb_json_max_nesting) {
+      cb_throw_encoding_failure(fmt::format("nesting of {} is too deep", depth));
+    }
+  }
+
+  std::ostringstream output_{};
+  tao::json::events::to_stream writer_{ output_ };
+};
+
+VALUE
+cb_Backend_json_parse(VALUE self, VALUE data, VALUE symbolize_names)
+{
+  (void)self;
+  Check_Type(data, T_STRING);
+
+  try {
+    // protects the buffer from modifications while GVL is released
+    VALUE frozen = rb_str_new_frozen(data);
+    VALUE res = cb_json_parse(RSTRING_PTR(frozen),
+                              static_cast<std::size_t>(RSTRING_LEN(frozen)),
+                              cb_json_decode_options{ RTEST(symbolize_names) });
+    RB_GC_GUARD(frozen);
+    return res;
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_json_generate(VALUE self, VALUE object)
+{
+  (void)self;
+
+  try {
+    auto json = cb_json_generate(object);
+    return rb_utf8_str_new(json.data(), static_cast<long>(json.size()));
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+/**
+ * Keeps the body of the natively decoded document, until some other transcoder asks for it.
+ */
+struct cb_document_body_data {
+  std::vector<std::byte> body{};
+  VALUE str{ Qnil };
+};
+
+void
+cb_DocumentBody_mark(void* ptr)
+{
+  const auto* data = static_cast<const cb_document_body_data*>(ptr);
+  rb_gc_mark(data->str);
+}
+
+void
+cb_DocumentBody_free(void* ptr)
+{
+  auto* data = static_cast<cb_document_body_data*>(ptr);
+  rb_gc_adjust_memory_usage(-static_cast<ssize_t>(data->body.capacity()));
+  data->~cb_document_body_data();
+  ruby_xfree(data);
+}
+
+std::size_t
+cb_DocumentBody_memsize(const void* ptr)
+{
+  const auto* data = static_cast<const cb_document_body_data*>(ptr);
+  return sizeof(*data) + data->body.capacity();
+}
+
+const rb_data_type_t cb_document_body_type{
+  "Couchbase/Backend/DocumentBody",
+  {
+    cb_DocumentBody_mark,
+    cb_DocumentBody_free,
+    cb_DocumentBody_memsize,
+// only one reserved field when GC.compact implemented
+#ifdef T_MOVED
+    nullptr,
+#endif
+    {},
+  },
+#ifdef RUBY_TYPED_FREE_IMMEDIATELY
+  nullptr,
+  nullptr,
+  RUBY_TYPED_FREE_IMMEDIATELY,
+#endif
+};
+
+VALUE cDocumentBody{ Qnil };
+
+VALUE
+cb_document_body_new(std::vector<std::byte>&& body)
+{
+  cb_document_body_data* data = nullptr;
+  VALUE obj =
+    TypedData_Make_Struct(cDocumentBody, cb_document_body_data, &cb_document_body_type, data);
+  new (data) cb_document_body_data{ std::move(body) };
+  rb_gc_adjust_memory_usage(static_cast<ssize_t>(data->body.capacity()));
+  return obj;
+}
+
+/**
+ * Returns the body as String. The buffer is handed over to the String on the first call, so large
+ * bodies are not copied at all.
+ */
+VALUE
+cb_DocumentBody_to_s(VALUE self)
+{
+  cb_document_body_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_document_body_data, &cb_document_body_type, data);
+  if (NIL_P(data->str)) {
+    rb_gc_adjust_memory_usage(-static_cast<ssize_t>(data->body.capacity()));
+    data->str = cb_str_new(std::move(data->body));
+    data->body = {};
+  }
+  return data->str;
+}
+
+/**
+ * Parses the text into the tape, releasing GVL for large documents. Returns error message if the
+ * text is not a valid JSON.
+ */
+std::optional<std::string>
+cb_json_tokenize(const char* data, std::size_t size, cb_json_tape& tape)
+{
+  struct parse_args {
+    const char* data;
+    std::size_t size;
+    cb_json_tape& tape;
+    std::optional<std::string> error{};
+  } args{ data, size, tape };
+
+  auto parse = [](void* param) -> void* {
+    auto* args = static_cast<parse_args*>(param);
+    try {
+      tao::json::events::from_string(args->tape, args->data, args->size);
+    } catch (const std::exception& e) {
+      args->error = e.what();
+    }
+    return nullptr;
+  };
+  if (size < cb_json_without_gvl_threshold) {
+    parse(&args);
+  } else {
+    rb_thread_call_without_gvl(parse, &args, nullptr, nullptr);
+  }
+  return args.error;
+}
+} // namespace
+
+VALUE
+cb_json_parse(const char* data, std::size_t size, const cb_json_decode_options& options)
+{
+  cb_json_tape tape{};
+  if (auto error = cb_json_tokenize(data, size, tape); error) {
+    throw ruby_exception(
+      cb_map_error_code(couchbase::errc::common::decoding_failure,
+                        fmt::format("unable to parse JSON: {}", error.value()),
+                        false));
+  }
+  return cb_json_builder{ tape, options }.build();
+}
+
+std::optional<cb_json_decode_options>
+cb_extract_json_decode_options(VALUE options)
+{
+  if (NIL_P(options) || TYPE(options) != T_HASH) {
+    return {};
+  }
+  static VALUE property_name = rb_id2sym(rb_intern("json_decode"));
+  VALUE val = rb_hash_aref(options, property_name);
+  if (NIL_P(val)) {
+    return {};
+  }
+  Check_Type(val, T_HASH);
+  cb_json_decode_options decode_options{};
+  cb_extract_option_bool(decode_options.symbolize_names, val, "symbolize_names");
+  return decode_options;
+}
+
+bool
+cb_json_flags_describe_json(std::uint32_t flags)
+{
+  // common flags are in the upper byte, and zero means legacy document, that is handled as JSON
+  const auto common_flags = flags >> 24U;
+  return common_flags == 0 || (common_flags & 0x0fU) == 2;
+}
+
+cb_json_document
+cb_json_decode_document(std::vector<std::byte>&& body,
+                        std::uint32_t flags,
+                        const std::optional<cb_json_decode_options>& options)
+{
+  cb_json_document document{};
+  if (options && !body.empty() && cb_json_flags_describe_json(flags)) {
+    cb_json_tape tape{};
+    if (!cb_json_tokenize(reinterpret_cast<const char*>(body.data()), body.size(), tape)) {
+      document.decoded = cb_json_builder{ tape, options.value() }.build();
+      // the tape is no longer needed, the String is only created if other transcoder asks for it
+      document.encoded = cb_document_body_new(std::move(body));
+      return document;
+    }
+  }
+  document.encoded = cb_str_new(std::move(body));
+  return document;
+}
+
+std::string
+cb_json_generate(VALUE object)
+{
+  return cb_json_encoder{}.generate(object);
+}
+
+void
+init_json(VALUE cBackend)
+{
+  rb_define_singleton_method(cBackend, "json_parse", cb_Backend_json_parse, 2);
+  rb_define_singleton_method(cBackend, "json_generate", cb_Backend_json_generate, 1);
+
+  cDocumentBody = rb_define_class_under(cBackend, "DocumentBody", rb_cObject);
+  rb_undef_alloc_func(cDocumentBody);
+  rb_define_method(cDocumentBody, "to_s", cb_DocumentBody_to_s, 0);
+}
+} // namespace couchbase::ruby
@@ -0,0 +1,90 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef COUCHBASE_RUBY_RCB_JSON_HXX
+#define COUCHBASE_RUBY_RCB_JSON_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <ruby/internal/special_consts.h>
+#include <ruby/internal/value.h>
+
+namespace couchbase::ruby
+{
+struct cb_json_decode_options {
+  bool symbolize_names{ false };
+};
+
+/**
+ * Parses JSON text into Ruby objects.
+ *
+ * Large documents are parsed without holding GVL into the flat list of tokens, and GVL is only
+ * needed to turn the tokens into Hashes, Arrays and Strings. The caller must guarantee that the
+ * buffer stays unchanged for the duration of the call (e.g. by passing frozen String).
+ */
+VALUE
+cb_json_parse(const char* data, std::size_t size, const cb_json_decode_options& options);
+
+/**
+ * Extracts options of the parser from the :json_decode entry of the operation options. Returns
+ * empty optional if the caller expects document bodies as Strings.
+ */
+std::optional<cb_json_decode_options>
+cb_extract_json_decode_options(VALUE options);
+
+/**
+ * Checks whether the flags of the document describe JSON. Documents without common flags are
+ * considered JSON too.
+ */
+bool
+cb_json_flags_describe_json(std::uint32_t flags);
+
+/**
+ * Body of the document as it has been received from the server, and its decoded representation.
+ * When the document has been decoded, the body is Backend::DocumentBody, which turns into String
+ * only on demand, otherwise it is String.
+ */
+struct cb_json_document {
+  VALUE encoded{ Qnil };
+  std::optional<VALUE> decoded{};
+};
+
+/**
+ * Converts the body of the document into Ruby object right from the buffer received from the
+ * server, if decoding options are given and the flags describe JSON. The original body is always
+ * kept, so that other transcoders see exactly the bytes stored on the server. If the body is not a
+ * valid JSON, it is not decoded, leaving the error reporting to the transcoder.
+ */
+cb_json_document
+cb_json_decode_document(std::vector<std::byte>&& body,
+                        std::uint32_t flags,
+                        const std::optional<cb_json_decode_options>& options);
+
+/**
+ * Serializes Ruby object into JSON text, following the rules of JSON.generate.
+ */
+std::string
+cb_json_generate(VALUE object);
+
+void
+init_json(VALUE cBackend);
+} // namespace couchbase::ruby
+#endif // COUCHBASE_RUBY_RCB_JSON_HXX
@@ -22,29 +22,89 @@
 // This is probably something we should address in the C++ core. Including them all for now.
 #include <core/operations/document_append.hxx>
 #include <core/operations/document_decrement.hxx>
+#include <core/operations/document_exists.hxx>
 #include <core/operations/document_get.hxx>
+#include <core/operations/document_get_and_touch.hxx>
 #include <core/operations/document_increment.hxx>
 #include <core/operations/document_insert.hxx>
+#include <core/operations/document_lookup_in.hxx>
 #include <core/operations/document_mutate_in.hxx>
 #include <core/operations/document_prepend.hxx>
 #include <core/operations/document_remove.hxx>
 #include <core/operations/document_replace.hxx>
+#include <core/operations/document_touch.hxx>
+#include <core/operations/document_unlock.hxx>
 #include <core/operations/document_upsert.hxx>
 
 #include <couchbase/cluster.hxx>
 #include <couchbase/upsert_options.hxx>
 
-#include <future>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 
 #include <ruby.h>
+#include <ruby/thread.h>
 
 #include "rcb_backend.hxx"
+#include "rcb_crud.hxx"
+#include "rcb_exceptions.hxx"
+#include "rcb_json.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_utils.hxx"
 
 namespace couchbase::ruby
 {
 namespace
 {
+/**
+ * Responses of the multi-operation. Shared with the callbacks, so that the batch stays valid even
+ * if the dispatching loop was interrupted by an exception.
+ */
+template<typename Response>
+struct cb_multi_batch {
+  explicit cb_multi_batch(std::size_t size)
+    : responses(size)
+    , latch{ size }
+  {
+    completion_order.reserve(size);
+  }
+
+  /**
+   * Might be called from any thread, the response at the index must be already stored.
+   */
+  void mark_completed(std::size_t index)
+  {
+    {
+      const std::scoped_lock lock(mutex);
+      completion_order.push_back(index);
+    }
+    latch.count_down();
+  }
+
+  /**
+   * Returns indexes of the responses in order of their completion, skipping first "offset" of
+   * them.
+   */
+  auto completed_since(std::size_t offset) -> std::vector<std::size_t>
+  {
+    const std::scoped_lock lock(mutex);
+    if (offset >= completion_order.size()) {
+      return {};
+    }
+    return { completion_order.begin() + static_cast<std::ptrdiff_t>(offset),
+             completion_order.end() };
+  }
+
+  std::vector<Response> responses;
+  cb_countdown_latch latch;
+  std::mutex mutex{};
+  std::vector<std::size_t> completion_order{};
+};
+
 void
 cb_extract_array_of_ids(std::vector<core::document_id>& ids, VALUE arg)
 {
@@ -92,6 +152,60 @@ cb_extract_array_of_ids(std::vector<core::document_id>& ids, VALUE arg)
   }
 }
 
+/**
+ * Tuples of the multi-mutations might be prefixed with [bucket, scope, collection] to target
+ * different collections in one batch, otherwise the keyspace passed to the operation is used.
+ * Returns offset of the ID in the tuple.
+ */
+long
+cb_extract_tuple_document_id(core::document_id& doc_id,
+                             VALUE entry,
+                             long tuple_size,
+                             VALUE bucket_name,
+                             VALUE scope_name,
+                             VALUE collection_name)
+{
+  long offset = 0;
+  if (RARRAY_LEN(entry) == tuple_size + 3) {
+    bucket_name = rb_ary_entry(entry, 0);
+    scope_name = rb_ary_entry(entry, 1);
+    collection_name = rb_ary_entry(entry, 2);
+    offset = 3;
+  }
+  if (TYPE(bucket_name) != T_STRING) {
+    throw ruby_exception(
+      rb_eArgError, rb_sprintf("Bucket must be a String, but given %+" PRIsVALUE, bucket_name));
+  }
+  if (TYPE(scope_name) != T_STRING) {
+    throw ruby_exception(
+      rb_eArgError, rb_sprintf("Scope must be a String, but given %+" PRIsVALUE, scope_name));
+  }
+  if (TYPE(collection_name) != T_STRING) {
+    throw ruby_exception(
+      rb_eArgError,
+      rb_sprintf("Collection must be a String, but given %+" PRIsVALUE, collection_name));
+  }
+  VALUE id = rb_ary_entry(entry, offset);
+  if (TYPE(id) != T_STRING) {
+    throw ruby_exception(rb_eArgError,
+                         rb_sprintf("ID must be a String, but given %+" PRIsVALUE, id));
+  }
+  doc_id = core::document_id{
+    cb_string_new(bucket_name),
+    cb_string_new(scope_name),
+    cb_string_new(collection_name),
+    cb_string_new(id),
+  };
+  return offset;
+}
+
+bool
+cb_is_multi_tuple(VALUE entry, long tuple_size)
+{
+  return TYPE(entry) == T_ARRAY &&
+         (RARRAY_LEN(entry) == tuple_size || RARRAY_LEN(entry) == tuple_size + 3);
+}
+
 void
 cb_extract_array_of_id_content(
   std::vector<std::pair<core::document_id, couchbase::codec::encoded_value>>& id_content,
@@ -100,10 +214,6 @@ cb_extract_array_of_id_content(
   VALUE collection_name,
   VALUE tuples)
 {
-  cb_check_type(bucket_name, T_STRING);
-  cb_check_type(scope_name, T_STRING);
-  cb_check_type(collection_name, T_STRING);
-
   if (TYPE(tuples) != T_ARRAY) {
     throw ruby_exception(
       rb_eArgError,
@@ -117,31 +227,27 @@ cb_extract_array_of_id_content(
   id_content.reserve(num_of_tuples);
   for (std::size_t i = 0; i < num_of_tuples; ++i) {
     VALUE entry = rb_ary_entry(tuples, static_cast<long>(i));
-    if (TYPE(entry) != T_ARRAY || RARRAY_LEN(entry) != 3) {
+    if (!cb_is_multi_tuple(entry, 3)) {
       throw ruby_exception(rb_eArgError,
                            rb_sprintf("ID/content tuple must be represented as an Array[id, "
+                                      "content, flags] or Array[bucket, scope, collection, id, "
                                       "content, flags], but given %+" PRIsVALUE,
                                       entry));
     }
-    VALUE id = rb_ary_entry(entry, 0);
-    if (TYPE(id) != T_STRING) {
-      throw ruby_exception(rb_eArgError,
-                           rb_sprintf("ID must be a String, but given %+" PRIsVALUE, id));
-    }
-    VALUE content = rb_ary_entry(entry, 1);
+    core::document_id doc_id{};
+    auto offset =
+      cb_extract_tuple_document_id(doc_id, entry, 3, bucket_name, scope_name, collection_name);
+    VALUE content = rb_ary_entry(entry, offset + 1);
     if (TYPE(content) != T_STRING) {
       throw ruby_exception(rb_eArgError,
                            rb_sprintf("Content must be a String, but given %+" PRIsVALUE, content));
     }
-    VALUE flags = rb_ary_entry(entry, 2);
+    VALUE flags = rb_ary_entry(entry, offset + 2);
     if (TYPE(flags) != T_FIXNUM) {
       throw ruby_exception(rb_eArgError,
                            rb_sprintf("Flags must be an Integer, but given %+" PRIsVALUE, flags));
     }
-    id_content.emplace_back(core::document_id{ cb_string_new(bucket_name),
-                                               cb_string_new(scope_name),
-                                               cb_string_new(collection_name),
-                                               cb_string_new(id) },
+    id_content.emplace_back(std::move(doc_id),
                             couchbase::codec::encoded_value{
                               cb_binary_new(content),
                               FIX2UINT(flags),
@@ -156,10 +262,6 @@ cb_extract_array_of_id_cas(std::vector<std::pair<core::document_id, couchbase::c
                            VALUE collection_name,
                            VALUE tuples)
 {
-  cb_check_type(bucket_name, T_STRING);
-  cb_check_type(scope_name, T_STRING);
-  cb_check_type(collection_name, T_STRING);
-
   if (TYPE(tuples) != T_ARRAY) {
     throw ruby_exception(
       rb_eArgError,
@@ -172,29 +274,486 @@ cb_extract_array_of_id_cas(std::vector<std::pair<core::document_id, couchbase::c
   id_cas.reserve(num_of_tuples);
   for (std::size_t i = 0; i < num_of_tuples; ++i) {
     VALUE entry = rb_ary_entry(tuples, static_cast<long>(i));
-    if (TYPE(entry) != T_ARRAY || RARRAY_LEN(entry) != 2) {
-      throw ruby_exception(
-        rb_eArgError,
-        rb_sprintf(
-          "ID/content tuple must be represented as an Array[id, CAS], but given %+" PRIsVALUE,
-          entry));
+    if (!cb_is_multi_tuple(entry, 2)) {
+      throw ruby_exception(rb_eArgError,
+                           rb_sprintf("ID/CAS tuple must be represented as an Array[id, CAS] or "
+                                      "Array[bucket, scope, collection, id, CAS], but given "
+                                      "%+" PRIsVALUE,
+                                      entry));
     }
-    VALUE id = rb_ary_entry(entry, 0);
-    if (TYPE(id) != T_STRING) {
+    core::document_id doc_id{};
+    auto offset =
+      cb_extract_tuple_document_id(doc_id, entry, 2, bucket_name, scope_name, collection_name);
+    couchbase::cas cas_val{};
+    if (VALUE cas = rb_ary_entry(entry, offset + 1); !NIL_P(cas)) {
+      cb_extract_cas(cas_val, cas);
+    }
+
+    id_cas.emplace_back(std::move(doc_id), cas_val);
+  }
+}
+
+void
+cb_extract_array_of_id_content_cas(
+  std::vector<std::tuple<core::document_id, couchbase::codec::encoded_value, couchbase::cas>>&
+    id_content_cas,
+  VALUE bucket_name,
+  VALUE scope_name,
+  VALUE collection_name,
+  VALUE tuples)
+{
+  if (TYPE(tuples) != T_ARRAY) {
+    throw ruby_exception(
+      rb_eArgError,
+      rb_sprintf("Type of ID/content/CAS tuples must be an Array, but given %+" PRIsVALUE, tuples));
+  }
+
+  auto num_of_tuples = static_cast<std::size_t>(RARRAY_LEN(tuples));
+  if (num_of_tuples < 1) {
+    throw ruby_exception(rb_eArgError, "Array of ID/content/CAS tuples must not be empty");
+  }
+  id_content_cas.reserve(num_of_tuples);
+  for (std::size_t i = 0; i < num_of_tuples; ++i) {
+    VALUE entry = rb_ary_entry(tuples, static_cast<long>(i));
+    if (!cb_is_multi_tuple(entry, 4)) {
       throw ruby_exception(rb_eArgError,
-                           rb_sprintf("ID must be a String, but given %+" PRIsVALUE, id));
+                           rb_sprintf("ID/content/CAS tuple must be represented as an Array[id, "
+                                      "content, flags, CAS] or Array[bucket, scope, collection, "
+                                      "id, content, flags, CAS], but given %+" PRIsVALUE,
+                                      entry));
+    }
+    core::document_id doc_id{};
+    auto offset =
+      cb_extract_tuple_document_id(doc_id, entry, 4, bucket_name, scope_name, collection_name);
+    VALUE content = rb_ary_entry(entry, offset + 1);
+    if (TYPE(content) != T_STRING) {
+      throw ruby_exception(rb_eArgError,
+                           rb_sprintf("Content must be a String, but given %+" PRIsVALUE, content));
+    }
+    VALUE flags = rb_ary_entry(entry, offset + 2);
+    if (TYPE(flags) != T_FIXNUM) {
+      throw ruby_exception(rb_eArgError,
+                           rb_sprintf("Flags must be an Integer, but given %+" PRIsVALUE, flags));
     }
     couchbase::cas cas_val{};
-    if (VALUE cas = rb_ary_entry(entry, 1); !NIL_P(cas)) {
+    if (VALUE cas = rb_ary_entry(entry, offset + 3); !NIL_P(cas)) {
       cb_extract_cas(cas_val, cas);
     }
+    id_content_cas.emplace_back(std::move(doc_id),
+                                couchbase::codec::encoded_value{
+                                  cb_binary_new(content),
+                                  FIX2UINT(flags),
+                                },
+                                cas_val);
+  }
+}
+
+void
+cb_extract_array_of_id_specs(std::vector<std::pair<core::document_id, VALUE>>& id_specs,
+                             VALUE bucket_name,
+                             VALUE scope_name,
+                             VALUE collection_name,
+                             VALUE tuples)
+{
+  if (TYPE(tuples) != T_ARRAY) {
+    throw ruby_exception(
+      rb_eArgError,
+      rb_sprintf("Type of ID/specs tuples must be an Array, but given %+" PRIsVALUE, tuples));
+  }
+  auto num_of_tuples = static_cast<std::size_t>(RARRAY_LEN(tuples));
+  if (num_of_tuples < 1) {
+    throw ruby_exception(rb_eArgError, "Array of ID/specs tuples must not be empty");
+  }
+  id_specs.reserve(num_of_tuples);
+  for (std::size_t i = 0; i < num_of_tuples; ++i) {
+    VALUE entry = rb_ary_entry(tuples, static_cast<long>(i));
+    if (!cb_is_multi_tuple(entry, 2)) {
+      throw ruby_exception(rb_eArgError,
+                           rb_sprintf("ID/specs tuple must be represented as an Array[id, specs] "
+                                      "or Array[bucket, scope, collection, id, specs], but given "
+                                      "%+" PRIsVALUE,
+                                      entry));
+    }
+    core::document_id doc_id{};
+    auto offset =
+      cb_extract_tuple_document_id(doc_id, entry, 2, bucket_name, scope_name, collection_name);
+    VALUE specs = rb_ary_entry(entry, offset + 1);
+    if (TYPE(specs) != T_ARRAY || RARRAY_LEN(specs) <= 0) {
+      throw ruby_exception(
+        rb_eArgError,
+        rb_sprintf("Specs must be a non-empty Array, but given %+" PRIsVALUE, specs));
+    }
+    id_specs.emplace_back(std::move(doc_id), specs);
+  }
+}
+
+/**
+ * Creates one request per document from the prototype, that already carries all options shared
+ * by the batch, so that the options hash is parsed only once.
+ */
+template<typename Request>
+std::vector<Request>
+cb_make_multi_requests(const Request& prototype, std::vector<core::document_id>&& ids)
+{
+  std::vector<Request> requests{};
+  requests.reserve(ids.size());
+  for (auto& id : ids) {
+    auto& req = requests.emplace_back(prototype);
+    req.id = std::move(id);
+  }
+  return requests;
+}
+
+/**
+ * Keeps at most "window" requests of the batch outstanding. Every completion schedules the next
+ * pending request, so that very large batches do not flood the retry queues of the core.
+ *
+ * The core might invoke the handler synchronously from execute() (e.g. when the cluster has been
+ * closed), so the requests are dispatched by a trampoline: only one thread sends requests at a
+ * time, and completions that arrive meanwhile (on the same or other thread) only add to the
+ * number of slots it has to fill. This keeps the stack flat regardless of the batch size.
+ */
+template<typename Request>
+class cb_multi_dispatcher : public std::enable_shared_from_this<cb_multi_dispatcher<Request>>
+{
+public:
+  using response_type = typename Request::response_type;
+  using legacy_durability_type = std::pair<couchbase::persist_to, couchbase::replicate_to>;
+
+  cb_multi_dispatcher(core::cluster cluster,
+                      std::vector<Request>&& requests,
+                      std::optional<legacy_durability_type> legacy_durability)
+    : cluster_{ std::move(cluster) }
+    , requests_{ std::move(requests) }
+    , legacy_durability_{ legacy_durability }
+    , batch_{ std::make_shared<cb_multi_batch<response_type>>(requests_.size()) }
+  {
+  }
 
-    id_cas.emplace_back(core::document_id{ cb_string_new(bucket_name),
-                                           cb_string_new(scope_name),
-                                           cb_string_new(collection_name),
-                                           cb_string_new(id) },
-                        cas_val);
+  auto batch() const -> std::shared_ptr<cb_multi_batch<response_type>>
+  {
+    return batch_;
   }
+
+  void start(std::size_t window)
+  {
+    schedule(window);
+  }
+
+private:
+  /**
+   * Adds free slots, and fills them unless another call is doing it already further up the stack
+   * or on another thread.
+   */
+  void schedule(std::size_t slots)
+  {
+    if (slots == 0 || free_slots_.fetch_add(slots) > 0) {
+      return;
+    }
+    std::size_t taken = slots;
+    while (true) {
+      for (std::size_t i = 0; i < taken; ++i) {
+        dispatch_next();
+      }
+      // the slots added while dispatching are left for this loop
+      auto remaining = free_slots_.fetch_sub(taken) - taken;
+      if (remaining == 0) {
+        return;
+      }
+      taken = remaining;
+    }
+  }
+
+  auto dispatch_next() -> bool
+  {
+    auto index = next_.fetch_add(1);
+    if (index >= requests_.size()) {
+      return false;
+    }
+    auto handler = [self = this->shared_from_this(), index](auto&& resp) {
+      self->batch_->responses[index] = std::forward<decltype(resp)>(resp);
+      // completion is recorded before the next request leaves, so the order of completions
+      // never shows more than "window" requests outstanding
+      self->batch_->mark_completed(index);
+      self->schedule(1);
+    };
+    if constexpr (with_legacy_durability<Request>::supported) {
+      if (legacy_durability_.has_value()) {
+        cluster_.execute(
+          typename with_legacy_durability<Request>::type{
+            std::move(requests_[index]),
+            legacy_durability_.value().first,
+            legacy_durability_.value().second,
+          },
+          std::move(handler));
+        return true;
+      }
+    }
+    cluster_.execute(std::move(requests_[index]), std::move(handler));
+    return true;
+  }
+
+  core::cluster cluster_;
+  std::vector<Request> requests_;
+  std::optional<legacy_durability_type> legacy_durability_;
+  std::shared_ptr<cb_multi_batch<response_type>> batch_;
+  std::atomic_size_t next_{ 0 };
+  std::atomic_size_t free_slots_{ 0 };
+};
+
+/**
+ * Dispatches all requests of the batch without waiting for the responses. Requests, that support
+ * durability, will be wrapped for legacy durability if the options ask for it. The
+ * "max_in_flight" option limits number of outstanding requests.
+ */
+template<typename Request>
+auto
+cb_dispatch_multi(core::cluster& cluster, std::vector<Request>&& requests, VALUE options)
+{
+  std::optional<std::pair<couchbase::persist_to, couchbase::replicate_to>> legacy_durability{};
+  if constexpr (with_legacy_durability<Request>::supported) {
+    legacy_durability = extract_legacy_durability_constraints(options);
+  }
+  std::size_t window = requests.size();
+  if (!NIL_P(options)) {
+    static const auto sym_max_in_flight = rb_id2sym(rb_intern("max_in_flight"));
+    if (VALUE max_in_flight = rb_hash_aref(options, sym_max_in_flight); !NIL_P(max_in_flight)) {
+      if (!RB_INTEGER_TYPE_P(max_in_flight) ||
+          !RTEST(rb_funcall(max_in_flight, rb_intern("positive?"), 0))) {
+        throw ruby_exception(
+          exc_invalid_argument(),
+          rb_sprintf("max_in_flight must be a positive Integer, but given %+" PRIsVALUE,
+                     max_in_flight));
+      }
+      if (auto limit = NUM2SIZET(max_in_flight); limit < window) {
+        window = limit;
+      }
+    }
+  }
+
+  auto dispatcher =
+    std::make_shared<cb_multi_dispatcher<Request>>(cluster, std::move(requests), legacy_durability);
+  auto batch = dispatcher->batch();
+  dispatcher->start(window);
+  return batch;
+}
+
+/**
+ * Dispatches all requests of the batch, and waits for the responses without holding the GVL.
+ */
+template<typename Request>
+auto
+cb_execute_multi(core::cluster& cluster, std::vector<Request>&& requests, VALUE options)
+{
+  auto batch = cb_dispatch_multi(cluster, std::move(requests), options);
+  cb_wait_for_latch(batch->latch);
+  return batch;
+}
+
+template<typename Response>
+bool
+cb_multi_entry_failed(const Response& resp)
+{
+  return static_cast<bool>(resp.ctx.ec());
+}
+
+bool
+cb_multi_entry_failed(const core::operations::exists_response& resp)
+{
+  return resp.ctx.ec() && resp.ctx.ec() != couchbase::errc::key_value::document_not_found;
+}
+
+/**
+ * Converts single response of the multi-operation into Ruby Hash, the same way as
+ * cb_create_multi_result does for the whole batch.
+ */
+template<typename Response, typename Builder>
+VALUE
+cb_create_multi_entry(Response& resp, const std::string& message, Builder&& build_entry)
+{
+  VALUE entry;
+  if (cb_multi_entry_failed(resp)) {
+    entry = rb_hash_new();
+    rb_hash_aset(entry, cb_symbols.error, cb_map_error(resp.ctx, message));
+  } else {
+    entry = build_entry(resp);
+  }
+  rb_hash_aset(entry, cb_symbols.id, cb_str_new(resp.ctx.id()));
+  return entry;
+}
+
+/**
+ * Converts responses of the batch into Array of Hashes. Failed entries carry only :error and :id,
+ * the builder might also accept index of the entry in the batch.
+ */
+template<typename Response, typename Builder>
+VALUE
+cb_create_multi_result(std::vector<Response>& responses,
+                       const std::string& message,
+                       Builder&& build_entry)
+{
+  VALUE res = rb_ary_new_capa(static_cast<long>(responses.size()));
+  for (std::size_t i = 0; i < responses.size(); ++i) {
+    auto build_indexed_entry = [&build_entry, i](auto& resp) {
+      if constexpr (std::is_invocable_v<Builder, Response&, std::size_t>) {
+        return build_entry(resp, i);
+      } else {
+        return build_entry(resp);
+      }
+    };
+    rb_ary_push(res, cb_create_multi_entry(responses[i], message, build_indexed_entry));
+  }
+  return res;
+}
+
+VALUE
+cb_create_get_multi_entry(core::operations::get_response& resp,
+                          const std::optional<cb_json_decode_options>& json)
+{
+  auto content = cb_json_decode_document(std::move(resp.value), resp.flags, json);
+  VALUE entry = rb_hash_new();
+  rb_hash_aset(entry, cb_symbols.content, content.encoded);
+  rb_hash_aset(entry, cb_symbols.cas, cb_cas_to_num(resp.cas));
+  rb_hash_aset(entry, cb_symbols.flags, UINT2NUM(resp.flags));
+  if (content.decoded) {
+    rb_hash_aset(entry, cb_symbols.decoded, Qtrue);
+    rb_hash_aset(entry, cb_symbols.decoded_content, content.decoded.value());
+  }
+  return entry;
+}
+
+struct cb_get_multi_stream_data {
+  std::shared_ptr<cb_multi_batch<core::operations::get_response>> batch{};
+  std::size_t delivered{ 0 };
+  std::optional<cb_json_decode_options> json{};
+};
+
+void
+cb_GetMultiStream_mark(void* /* ptr */)
+{
+  /* No embedded Ruby objects */
+}
+
+void
+cb_GetMultiStream_free(void* ptr)
+{
+  auto* data = static_cast<cb_get_multi_stream_data*>(ptr);
+  data->~cb_get_multi_stream_data();
+  ruby_xfree(data);
+}
+
+std::size_t
+cb_GetMultiStream_memsize(const void* ptr)
+{
+  const auto* data = static_cast<const cb_get_multi_stream_data*>(ptr);
+  return sizeof(*data);
+}
+
+const rb_data_type_t cb_get_multi_stream_type{
+  "Couchbase/Backend/GetMultiStream",
+  {
+    cb_GetMultiStream_mark,
+    cb_GetMultiStream_free,
+    cb_GetMultiStream_memsize,
+// only one reserved field when GC.compact implemented
+#ifdef T_MOVED
+    nullptr,
+#endif
+    {},
+  },
+#ifdef RUBY_TYPED_FREE_IMMEDIATELY
+  nullptr,
+  nullptr,
+  RUBY_TYPED_FREE_IMMEDIATELY,
+#endif
+};
+
+VALUE cGetMultiStream{ Qnil };
+
+VALUE
+cb_GetMultiStream_allocate(VALUE klass)
+{
+  cb_get_multi_stream_data* data = nullptr;
+  VALUE obj =
+    TypedData_Make_Struct(klass, cb_get_multi_stream_data, &cb_get_multi_stream_type, data);
+  new (data) cb_get_multi_stream_data();
+  return obj;
+}
+
+/**
+ * Waits (without GVL) until at least one more response of the batch arrives, and returns all
+ * responses completed since the previous call in order of their completion. Returns nil when all
+ * responses have been delivered.
+ */
+VALUE
+cb_GetMultiStream_next_completed(VALUE self)
+{
+  cb_get_multi_stream_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_get_multi_stream_data, &cb_get_multi_stream_type, data);
+
+  if (!data->batch || data->delivered >= data->batch->responses.size()) {
+    return Qnil;
+  }
+
+  auto batch = data->batch;
+  struct wait_args {
+    cb_countdown_latch* latch;
+    std::size_t pending;
+  } args{ &batch->latch, batch->responses.size() - data->delivered };
+  rb_thread_call_without_gvl(
+    [](void* param) -> void* {
+      auto* args = static_cast<wait_args*>(param);
+      args->latch->wait_below(args->pending);
+      return nullptr;
+    },
+    &args,
+    nullptr,
+    nullptr);
+  flush_logger();
+
+  auto completed = batch->completed_since(data->delivered);
+  data->delivered += completed.size();
+
+  VALUE res = rb_ary_new_capa(static_cast<long>(completed.size()));
+  for (auto index : completed) {
+    rb_ary_push(res,
+                cb_create_multi_entry(
+                  batch->responses[index], "unable to (multi)fetch document", [data](auto& resp) {
+                    return cb_create_get_multi_entry(resp, data->json);
+                  }));
+  }
+  if (data->delivered >= batch->responses.size()) {
+    data->batch.reset();
+  }
+  return res;
+}
+
+VALUE
+cb_Backend_document_get_multi_stream(VALUE self, VALUE keys, VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  try {
+    core::operations::get_request prototype{};
+    cb_extract_timeout(prototype, options);
+
+    std::vector<core::document_id> ids{};
+    cb_extract_array_of_ids(ids, keys);
+
+    VALUE stream = rb_class_new_instance(0, nullptr, cGetMultiStream);
+    cb_get_multi_stream_data* data = nullptr;
+    TypedData_Get_Struct(stream, cb_get_multi_stream_data, &cb_get_multi_stream_type, data);
+    data->json = cb_extract_json_decode_options(options);
+    data->batch =
+      cb_dispatch_multi(cluster, cb_make_multi_requests(prototype, std::move(ids)), options);
+    return stream;
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
 }
 
 VALUE
@@ -203,45 +762,289 @@ cb_Backend_document_get_multi(VALUE self, VALUE keys, VALUE options)
   auto cluster = cb_backend_to_core_api_cluster(self);
 
   try {
-    std::chrono::milliseconds timeout{ 0 };
-    cb_extract_timeout(timeout, options);
+    core::operations::get_request prototype{};
+    cb_extract_timeout(prototype, options);
 
     std::vector<core::document_id> ids{};
     cb_extract_array_of_ids(ids, keys);
 
-    auto num_of_ids = ids.size();
-    std::vector<std::future<core::operations::get_response>> futures;
-    futures.reserve(num_of_ids);
+    auto json = cb_extract_json_decode_options(options);
+    auto batch =
+      cb_execute_multi(cluster, cb_make_multi_requests(prototype, std::move(ids)), options);
 
-    for (auto& id : ids) {
-      core::operations::get_request req{ std::move(id) };
-      if (timeout.count() > 0) {
-        req.timeout = timeout;
-      }
-      std::promise<core::operations::get_response> promise;
-      futures.emplace_back(promise.get_future());
-      cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
-        promise.set_value(std::forward<decltype(resp)>(resp));
+    return cb_create_multi_result(
+      batch->responses, "unable to (multi)fetch document", [&json](auto& resp) {
+        return cb_create_get_multi_entry(resp, json);
       });
-    }
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_get_and_touch_multi(VALUE self, VALUE keys, VALUE expiry, VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::get_and_touch_request prototype{};
+    cb_extract_timeout(prototype, options);
+    auto [type, duration] = unpack_expiry(expiry, false);
+    prototype.expiry = static_cast<std::uint32_t>(duration.count());
+
+    std::vector<core::document_id> ids{};
+    cb_extract_array_of_ids(ids, keys);
+
+    auto batch =
+      cb_execute_multi(cluster, cb_make_multi_requests(prototype, std::move(ids)), options);
+
+    return cb_create_multi_result(
+      batch->responses, "unable to (multi)fetch and touch", [](auto& resp) {
+        VALUE entry = rb_hash_new();
+        rb_hash_aset(entry, cb_symbols.content, cb_str_new(std::move(resp.value)));
+        rb_hash_aset(entry, cb_symbols.cas, cb_cas_to_num(resp.cas));
+        rb_hash_aset(entry, cb_symbols.flags, UINT2NUM(resp.flags));
+        return entry;
+      });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_touch_multi(VALUE self, VALUE keys, VALUE expiry, VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
 
-    VALUE res = rb_ary_new_capa(static_cast<long>(num_of_ids));
-    for (auto& future : futures) {
-      auto resp = future.get();
+  try {
+    core::operations::touch_request prototype{};
+    cb_extract_timeout(prototype, options);
+    auto [type, duration] = unpack_expiry(expiry, false);
+    prototype.expiry = static_cast<std::uint32_t>(duration.count());
+
+    std::vector<core::document_id> ids{};
+    cb_extract_array_of_ids(ids, keys);
+
+    auto batch =
+      cb_execute_multi(cluster, cb_make_multi_requests(prototype, std::move(ids)), options);
+
+    return cb_create_multi_result(batch->responses, "unable to (multi)touch", [](const auto& resp) {
       VALUE entry = rb_hash_new();
-      if (resp.ctx.ec()) {
-        rb_hash_aset(entry,
-                     rb_id2sym(rb_intern("error")),
-                     cb_map_error(resp.ctx, "unable to (multi)fetch document"));
+      rb_hash_aset(entry, cb_symbols.cas, cb_cas_to_num(resp.cas));
+      return entry;
+    });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_exists_multi(VALUE self, VALUE keys, VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::exists_request prototype{};
+    cb_extract_timeout(prototype, options);
+
+    std::vector<core::document_id> ids{};
+    cb_extract_array_of_ids(ids, keys);
+
+    auto batch =
+      cb_execute_multi(cluster, cb_make_multi_requests(prototype, std::move(ids)), options);
+
+    return cb_create_multi_result(
+      batch->responses, "unable to (multi)exists", [](const auto& resp) {
+        VALUE entry = rb_hash_new();
+        rb_hash_aset(entry, cb_symbols.cas, cb_cas_to_num(resp.cas));
+        rb_hash_aset(entry, cb_symbols.exists, resp.exists() ? Qtrue : Qfalse);
+        rb_hash_aset(entry, cb_symbols.deleted, resp.deleted ? Qtrue : Qfalse);
+        rb_hash_aset(entry, cb_symbols.flags, UINT2NUM(resp.flags));
+        rb_hash_aset(entry, cb_symbols.expiry, UINT2NUM(resp.expiry));
+        rb_hash_aset(entry, cb_symbols.sequence_number, ULL2NUM(resp.sequence_number));
+        rb_hash_aset(entry, cb_symbols.datatype, UINT2NUM(resp.datatype));
+        return entry;
+      });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+template<typename Request>
+VALUE
+cb_document_counter_multi(VALUE self, VALUE keys, VALUE options, const std::string& message)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    Request prototype{};
+    cb_extract_timeout(prototype, options);
+    cb_extract_expiry(prototype, options);
+    cb_extract_option_uint64(prototype.delta, options, "delta");
+    cb_extract_option_uint64(prototype.initial_value, options, "initial_value");
+    cb_extract_durability_level(prototype, options);
+
+    std::vector<core::document_id> ids{};
+    cb_extract_array_of_ids(ids, keys);
+
+    auto batch =
+      cb_execute_multi(cluster, cb_make_multi_requests(prototype, std::move(ids)), options);
+
+    return cb_create_multi_result(batch->responses, message, [](const auto& resp) {
+      VALUE entry = cb_create_mutation_result(resp);
+      rb_hash_aset(entry, cb_symbols.content, ULL2NUM(resp.content));
+      return entry;
+    });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+VALUE
+cb_Backend_document_increment_multi(VALUE self, VALUE keys, VALUE options)
+{
+  return cb_document_counter_multi<core::operations::increment_request>(
+    self, keys, options, "unable to (multi)increment");
+}
+
+VALUE
+cb_Backend_document_decrement_multi(VALUE self, VALUE keys, VALUE options)
+{
+  return cb_document_counter_multi<core::operations::decrement_request>(
+    self, keys, options, "unable to (multi)decrement");
+}
+
+VALUE
+cb_Backend_document_lookup_in_multi(VALUE self, VALUE keys, VALUE specs, VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(specs, T_ARRAY);
+  if (RARRAY_LEN(specs) <= 0) {
+    rb_raise(rb_eArgError, "Array with specs cannot be empty");
+    return Qnil;
+  }
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::lookup_in_request prototype{};
+    cb_extract_timeout(prototype, options);
+    cb_extract_option_bool(prototype.access_deleted, options, "access_deleted");
+    cb_extract_lookup_in_specs(prototype.specs, specs);
+    auto json = cb_extract_json_decode_options(options);
+
+    std::vector<core::document_id> ids{};
+    cb_extract_array_of_ids(ids, keys);
+
+    auto batch =
+      cb_execute_multi(cluster, cb_make_multi_requests(prototype, std::move(ids)), options);
+
+    return cb_create_multi_result(
+      batch->responses, "unable to perform (multi)lookup_in operation", [&json](auto& resp) {
+        return cb_create_lookup_in_result(resp, json);
+      });
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+template<typename Request>
+VALUE
+cb_document_store_multi(VALUE self,
+                        VALUE bucket,
+                        VALUE scope,
+                        VALUE collection,
+                        VALUE id_content,
+                        VALUE options,
+                        const std::string& message)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    Request prototype{};
+    cb_extract_timeout(prototype, options);
+    cb_extract_expiry(prototype, options);
+    cb_extract_durability_level(prototype, options);
+    if constexpr (!std::is_same_v<Request, core::operations::insert_request>) {
+      cb_extract_preserve_expiry(prototype, options);
+    }
+
+    std::vector<Request> requests{};
+    if constexpr (std::is_same_v<Request, core::operations::replace_request>) {
+      std::vector<std::tuple<core::document_id, couchbase::codec::encoded_value, couchbase::cas>>
+        tuples{};
+      cb_extract_array_of_id_content_cas(tuples, bucket, scope, collection, id_content);
+      requests.reserve(tuples.size());
+      for (auto& [id, content, cas] : tuples) {
+        auto& req = requests.emplace_back(prototype);
+        req.id = std::move(id);
+        req.value = std::move(content.data);
+        req.flags = content.flags;
+        req.cas = cas;
+      }
+    } else {
+      std::vector<std::pair<core::document_id, couchbase::codec::encoded_value>> tuples{};
+      cb_extract_array_of_id_content(tuples, bucket, scope, collection, id_content);
+      requests.reserve(tuples.size());
+      for (auto& [id, content] : tuples) {
+        auto& req = requests.emplace_back(prototype);
+        req.id = std::move(id);
+        req.value = std::move(content.data);
+        req.flags = content.flags;
       }
-      rb_hash_aset(entry, rb_id2sym(rb_intern("id")), cb_str_new(resp.ctx.id()));
-      rb_hash_aset(entry, rb_id2sym(rb_intern("content")), cb_str_new(resp.value));
-      rb_hash_aset(entry, rb_id2sym(rb_intern("cas")), cb_cas_to_num(resp.cas));
-      rb_hash_aset(entry, rb_id2sym(rb_intern("flags")), UINT2NUM(resp.flags));
-      rb_ary_push(res, entry);
     }
 
-    return res;
+    auto batch = cb_execute_multi(cluster, std::move(requests), options);
+
+    return cb_create_multi_result(batch->responses, message, [](const auto& resp) {
+      return cb_create_mutation_result(resp);
+    });
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -258,73 +1061,80 @@ cb_Backend_document_upsert_multi(VALUE self,
                                  VALUE collection,
                                  VALUE id_content,
                                  VALUE options)
+{
+  return cb_document_store_multi<core::operations::upsert_request>(
+    self, bucket, scope, collection, id_content, options, "unable (multi)upsert");
+}
+
+VALUE
+cb_Backend_document_insert_multi(VALUE self,
+                                 VALUE bucket,
+                                 VALUE scope,
+                                 VALUE collection,
+                                 VALUE id_content,
+                                 VALUE options)
+{
+  return cb_document_store_multi<core::operations::insert_request>(
+    self, bucket, scope, collection, id_content, options, "unable (multi)insert");
+}
+
+VALUE
+cb_Backend_document_replace_multi(VALUE self,
+                                  VALUE bucket,
+                                  VALUE scope,
+                                  VALUE collection,
+                                  VALUE id_content_cas,
+                                  VALUE options)
+{
+  return cb_document_store_multi<core::operations::replace_request>(
+    self, bucket, scope, collection, id_content_cas, options, "unable (multi)replace");
+}
+
+template<typename Request>
+VALUE
+cb_document_id_cas_multi(VALUE self,
+                         VALUE bucket,
+                         VALUE scope,
+                         VALUE collection,
+                         VALUE id_cas,
+                         VALUE options,
+                         const std::string& message)
 {
   auto cluster = cb_backend_to_core_api_cluster(self);
 
-  Check_Type(bucket, T_STRING);
-  Check_Type(scope, T_STRING);
-  Check_Type(collection, T_STRING);
   if (!NIL_P(options)) {
     Check_Type(options, T_HASH);
   }
 
   try {
-    std::vector<std::pair<core::document_id, couchbase::codec::encoded_value>> tuples{};
-    cb_extract_array_of_id_content(tuples, bucket, scope, collection, id_content);
-
-    auto num_of_tuples = tuples.size();
-    std::vector<std::pair<std::string, std::future<core::operations::upsert_response>>> futures;
-    futures.reserve(num_of_tuples);
-
-    for (auto& [id, content] : tuples) {
-      core::operations::upsert_request req{
-        id,
-        std::move(content.data),
-      };
-      req.flags = content.flags;
-      cb_extract_timeout(req, options);
-      cb_extract_expiry(req, options);
-      cb_extract_durability_level(req, options);
-      cb_extract_preserve_expiry(req, options);
-
-      std::promise<core::operations::upsert_response> promise;
-      futures.emplace_back(id.key(), promise.get_future());
-
-      if (const auto legacy_durability = extract_legacy_durability_constraints(options);
-          legacy_durability.has_value()) {
-        cluster.execute(
-          core::operations::upsert_request_with_legacy_durability{
-            std::move(req),
-            legacy_durability.value().first,
-            legacy_durability.value().second,
-          },
-          [promise = std::move(promise)](auto&& resp) mutable {
-            promise.set_value(std::forward<decltype(resp)>(resp));
-          });
-      } else {
-        cluster.execute(std::move(req), [promise = std::move(promise)](auto&& resp) mutable {
-          promise.set_value(std::forward<decltype(resp)>(resp));
-        });
-      }
+    Request prototype{};
+    cb_extract_timeout(prototype, options);
+    if constexpr (with_legacy_durability<Request>::supported) {
+      cb_extract_durability_level(prototype, options);
     }
 
-    VALUE res = rb_ary_new_capa(static_cast<long>(num_of_tuples));
-    for (auto& [id, f] : futures) {
-      auto resp = f.get();
-      VALUE entry;
-      if (resp.ctx.ec()) {
-        entry = rb_hash_new();
-        static const auto sym_error = rb_id2sym(rb_intern("error"));
-        rb_hash_aset(entry, sym_error, cb_map_error(resp.ctx, "unable (multi)upsert"));
-      } else {
-        entry = cb_create_mutation_result(resp);
-      }
-      static const auto sym_id = rb_id2sym(rb_intern("id"));
-      rb_hash_aset(entry, sym_id, cb_str_new(id));
-      rb_ary_push(res, entry);
+    std::vector<std::pair<core::document_id, couchbase::cas>> tuples{};
+    cb_extract_array_of_id_cas(tuples, bucket, scope, collection, id_cas);
+
+    std::vector<Request> requests{};
+    requests.reserve(tuples.size());
+    for (auto& [id, cas] : tuples) {
+      auto& req = requests.emplace_back(prototype);
+      req.id = std::move(id);
+      req.cas = cas;
     }
-    return res;
 
+    auto batch = cb_execute_multi(cluster, std::move(requests), options);
+
+    return cb_create_multi_result(batch->responses, message, [](const auto& resp) {
+      if constexpr (std::is_same_v<Request, core::operations::unlock_request>) {
+        VALUE entry = rb_hash_new();
+        rb_hash_aset(entry, cb_symbols.cas, cb_cas_to_num(resp.cas));
+        return entry;
+      } else {
+        return cb_create_mutation_result(resp);
+      }
+    });
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -341,70 +1151,66 @@ cb_Backend_document_remove_multi(VALUE self,
                                  VALUE collection,
                                  VALUE id_cas,
                                  VALUE options)
+{
+  return cb_document_id_cas_multi<core::operations::remove_request>(
+    self, bucket, scope, collection, id_cas, options, "unable (multi)remove");
+}
+
+VALUE
+cb_Backend_document_unlock_multi(VALUE self,
+                                 VALUE bucket,
+                                 VALUE scope,
+                                 VALUE collection,
+                                 VALUE id_cas,
+                                 VALUE options)
+{
+  return cb_document_id_cas_multi<core::operations::unlock_request>(
+    self, bucket, scope, collection, id_cas, options, "unable (multi)unlock");
+}
+
+VALUE
+cb_Backend_document_mutate_in_multi(VALUE self,
+                                    VALUE bucket,
+                                    VALUE scope,
+                                    VALUE collection,
+                                    VALUE id_specs,
+                                    VALUE options)
 {
   auto cluster = cb_backend_to_core_api_cluster(self);
 
-  Check_Type(bucket, T_STRING);
-  Check_Type(scope, T_STRING);
-  Check_Type(collection, T_STRING);
   if (!NIL_P(options)) {
     Check_Type(options, T_HASH);
   }
 
   try {
-    std::vector<std::pair<core::document_id, couchbase::cas>> tuples{};
-    cb_extract_array_of_id_cas(tuples, bucket, scope, collection, id_cas);
-
-    auto num_of_tuples = tuples.size();
-    std::vector<std::pair<std::string, std::future<core::operations::remove_response>>> futures;
-    futures.reserve(num_of_tuples);
-
-    for (const auto& [id, cas] : tuples) {
-      core::operations::remove_request req{
-        id,
-      };
-      cb_extract_timeout(req, options);
-      cb_extract_durability_level(req, options);
-      req.cas = cas;
+    core::operations::mutate_in_request prototype{};
+    cb_extract_timeout(prototype, options);
+    cb_extract_durability_level(prototype, options);
+    cb_extract_expiry(prototype, options);
+    cb_extract_preserve_expiry(prototype, options);
+    cb_extract_option_bool(prototype.access_deleted, options, "access_deleted");
+    cb_extract_option_bool(prototype.create_as_deleted, options, "create_as_deleted");
+    cb_extract_store_semantics(prototype, options);
 
-      std::promise<core::operations::remove_response> promise;
-      futures.emplace_back(id.key(), promise.get_future());
+    std::vector<std::pair<core::document_id, VALUE>> tuples{};
+    cb_extract_array_of_id_specs(tuples, bucket, scope, collection, id_specs);
 
-      if (const auto legacy_durability = extract_legacy_durability_constraints(options);
-          legacy_durability.has_value()) {
-        cluster.execute(
-          core::operations::remove_request_with_legacy_durability{
-            std::move(req),
-            legacy_durability.value().first,
-            legacy_durability.value().second,
-          },
-          [promise = std::move(promise)](auto&& resp) mutable {
-            promise.set_value(std::forward<decltype(resp)>(resp));
-          });
-      } else {
-        cluster.execute(std::move(req), [promise = std::move(promise)](auto&& resp) mutable {
-          promise.set_value(std::forward<decltype(resp)>(resp));
-        });
-      }
+    std::vector<core::operations::mutate_in_request> requests{};
+    requests.reserve(tuples.size());
+    for (auto& [id, specs] : tuples) {
+      auto& req = requests.emplace_back(prototype);
+      req.id = std::move(id);
+      cb_extract_mutate_in_specs(req.specs, specs);
     }
 
-    VALUE res = rb_ary_new_capa(static_cast<long>(num_of_tuples));
-    for (auto& [id, f] : futures) {
-      auto resp = f.get();
-      VALUE entry;
-      if (resp.ctx.ec()) {
-        entry = rb_hash_new();
-        static const auto sym_error = rb_id2sym(rb_intern("error"));
-        rb_hash_aset(entry, sym_error, cb_map_error(resp.ctx, "unable (multi)remove"));
-      } else {
-        entry = cb_create_mutation_result(resp);
-      }
-      static const auto sym_id = rb_id2sym(rb_intern("id"));
-      rb_hash_aset(entry, sym_id, cb_str_new(id));
-      rb_ary_push(res, entry);
-    }
-    return res;
+    auto batch = cb_execute_multi(cluster, std::move(requests), options);
 
+    // re-read specs from the arguments instead of keeping VALUEs in the vector while waiting
+    return cb_create_multi_result(
+      batch->responses, "unable to (multi)mutate_in", [id_specs](const auto& resp, std::size_t i) {
+        VALUE entry = rb_ary_entry(id_specs, static_cast<long>(i));
+        return cb_create_mutate_in_result(resp, rb_ary_entry(entry, RARRAY_LEN(entry) - 1));
+      });
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -420,7 +1226,28 @@ void
 init_multi(VALUE cBackend)
 {
   rb_define_method(cBackend, "document_get_multi", cb_Backend_document_get_multi, 2);
+  rb_define_method(
+    cBackend, "document_get_multi_stream", cb_Backend_document_get_multi_stream, 2);
+  rb_define_method(
+    cBackend, "document_get_and_touch_multi", cb_Backend_document_get_and_touch_multi, 3);
+  rb_define_method(cBackend, "document_touch_multi", cb_Backend_document_touch_multi, 3);
+  rb_define_method(cBackend, "document_exists_multi", cb_Backend_document_exists_multi, 2);
+  rb_define_method(cBackend, "document_unlock_multi", cb_Backend_document_unlock_multi, 5);
   rb_define_method(cBackend, "document_remove_multi", cb_Backend_document_remove_multi, 5);
+  rb_define_method(cBackend, "document_insert_multi", cb_Backend_document_insert_multi, 5);
   rb_define_method(cBackend, "document_upsert_multi", cb_Backend_document_upsert_multi, 5);
+  rb_define_method(cBackend, "document_replace_multi", cb_Backend_document_replace_multi, 5);
+  rb_define_method(
+    cBackend, "document_increment_multi", cb_Backend_document_increment_multi, 2);
+  rb_define_method(
+    cBackend, "document_decrement_multi", cb_Backend_document_decrement_multi, 2);
+  rb_define_method(
+    cBackend, "document_lookup_in_multi", cb_Backend_document_lookup_in_multi, 3);
+  rb_define_method(
+    cBackend, "document_mutate_in_multi", cb_Backend_document_mutate_in_multi, 5);
+
+  cGetMultiStream = rb_define_class_under(cBackend, "GetMultiStream", rb_cObject);
+  rb_define_alloc_func(cGetMultiStream, cb_GetMultiStream_allocate);
+  rb_define_method(cGetMultiStream, "next_completed", cb_GetMultiStream_next_completed, 0);
 }
 } // namespace couchbase::ruby
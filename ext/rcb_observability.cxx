@@ -18,6 +18,7 @@
 #include "rcb_observability.hxx"
 
 #include "rcb_backend.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_utils.hxx"
 
 #include <core/cluster.hxx>
@@ -38,12 +39,6 @@ core_span_to_rb_hash(std::shared_ptr<couchbase::core::tracing::wrapper_sdk_span>
 {
   VALUE res = rb_hash_new();
 
-  static VALUE sym_name = rb_id2sym(rb_intern("name"));
-  static VALUE sym_attributes = rb_id2sym(rb_intern("attributes"));
-  static VALUE sym_start_timestamp = rb_id2sym(rb_intern("start_timestamp"));
-  static VALUE sym_end_timestamp = rb_id2sym(rb_intern("end_timestamp"));
-  static VALUE sym_children = rb_id2sym(rb_intern("children"));
-
   VALUE attributes = rb_hash_new();
 
   for (const auto& [key, value] : core_span->uint_tags()) {
@@ -54,15 +49,15 @@ core_span_to_rb_hash(std::shared_ptr<couchbase::core::tracing::wrapper_sdk_span>
     rb_hash_aset(attributes, cb_str_new(key), cb_str_new(value));
   }
 
-  rb_hash_aset(res, sym_name, cb_str_new(core_span->name()));
-  rb_hash_aset(res, sym_attributes, attributes);
+  rb_hash_aset(res, cb_symbols.name, cb_str_new(core_span->name()));
+  rb_hash_aset(res, cb_symbols.attributes, attributes);
   rb_hash_aset(res,
-               sym_start_timestamp,
+               cb_symbols.start_timestamp,
                LL2NUM(std::chrono::duration_cast<std::chrono::microseconds>(
                         core_span->start_time().time_since_epoch())
                         .count()));
   rb_hash_aset(res,
-               sym_end_timestamp,
+               cb_symbols.end_timestamp,
                LL2NUM(std::chrono::duration_cast<std::chrono::microseconds>(
                         core_span->end_time().time_since_epoch())
                         .count()));
@@ -71,7 +66,7 @@ core_span_to_rb_hash(std::shared_ptr<couchbase::core::tracing::wrapper_sdk_span>
   for (const auto& child : core_span->children()) {
     rb_ary_push(children, core_span_to_rb_hash(child));
   }
-  rb_hash_aset(res, sym_children, children);
+  rb_hash_aset(res, cb_symbols.children, children);
 
   return res;
 }
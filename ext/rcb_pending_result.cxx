@@ -0,0 +1,180 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <optional>
+
+#include <ruby.h>
+
+#include "rcb_exceptions.hxx"
+#include "rcb_pending_result.hxx"
+#include "rcb_utils.hxx"
+
+namespace couchbase::ruby
+{
+namespace
+{
+struct cb_pending_result_data {
+  std::optional<cb_future<cb_result_builder>> future{};
+  // only the thread holding the lock consumes the future, the others wait for the built value
+  VALUE lock{ Qnil };
+  VALUE value{ Qnil };
+  VALUE error{ Qnil };
+};
+
+void
+cb_PendingResult_mark(void* ptr)
+{
+  const auto* data = static_cast<const cb_pending_result_data*>(ptr);
+  rb_gc_mark(data->lock);
+  rb_gc_mark(data->value);
+  rb_gc_mark(data->error);
+}
+
+void
+cb_PendingResult_free(void* ptr)
+{
+  auto* data = static_cast<cb_pending_result_data*>(ptr);
+  data->~cb_pending_result_data();
+  ruby_xfree(data);
+}
+
+std::size_t
+cb_PendingResult_memsize(const void* ptr)
+{
+  const auto* data = static_cast<const cb_pending_result_data*>(ptr);
+  return sizeof(*data);
+}
+
+const rb_data_type_t cb_pending_result_type{
+  "Couchbase/Backend/PendingResult",
+  {
+    cb_PendingResult_mark,
+    cb_PendingResult_free,
+    cb_PendingResult_memsize,
+// only one reserved field when GC.compact implemented
+#ifdef T_MOVED
+    nullptr,
+#endif
+    {},
+  },
+#ifdef RUBY_TYPED_FREE_IMMEDIATELY
+  nullptr,
+  nullptr,
+  RUBY_TYPED_FREE_IMMEDIATELY,
+#endif
+};
+
+VALUE cPendingResult{ Qnil };
+
+VALUE
+cb_PendingResult_allocate(VALUE klass)
+{
+  cb_pending_result_data* data = nullptr;
+  VALUE obj = TypedData_Make_Struct(klass, cb_pending_result_data, &cb_pending_result_type, data);
+  new (data) cb_pending_result_data();
+  data->lock = rb_mutex_new();
+  return obj;
+}
+
+VALUE
+cb_PendingResult_is_ready(VALUE self)
+{
+  const cb_pending_result_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_pending_result_data, &cb_pending_result_type, data);
+  if (!data->future.has_value()) {
+    return Qtrue;
+  }
+  // another thread is waiting for the future, so #value would block until it builds the result
+  if (RTEST(rb_mutex_locked_p(data->lock))) {
+    return Qfalse;
+  }
+  if (data->future->is_ready()) {
+    return Qtrue;
+  }
+  return Qfalse;
+}
+
+/**
+ * Invoked with the lock held. Returns the exception to raise once the lock is released, because
+ * the wait might be interrupted, and in this case the future stays available for the next call.
+ */
+VALUE
+cb_pending_result_resolve(VALUE self)
+{
+  cb_pending_result_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_pending_result_data, &cb_pending_result_type, data);
+
+  if (!data->future.has_value()) {
+    return Qnil;
+  }
+  try {
+    auto build_result = cb_wait_for_future(data->future.value());
+    data->future.reset();
+    try {
+      data->value = build_result();
+    } catch (const ruby_exception& e) {
+      data->error = e.exception_object();
+    }
+  } catch (const std::system_error& se) {
+    return cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false);
+  } catch (const ruby_exception& e) {
+    return e.exception_object();
+  }
+  return Qnil;
+}
+
+VALUE
+cb_PendingResult_value(VALUE self)
+{
+  cb_pending_result_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_pending_result_data, &cb_pending_result_type, data);
+
+  if (data->future.has_value()) {
+    if (VALUE exc = rb_mutex_synchronize(data->lock, cb_pending_result_resolve, self);
+        !NIL_P(exc)) {
+      rb_exc_raise(exc);
+    }
+  }
+  if (!NIL_P(data->error)) {
+    rb_exc_raise(data->error);
+  }
+  return data->value;
+}
+} // namespace
+
+VALUE
+cb_pending_result_new(cb_future<cb_result_builder> future)
+{
+  VALUE obj = rb_class_new_instance(0, nullptr, cPendingResult);
+  cb_pending_result_data* data = nullptr;
+  TypedData_Get_Struct(obj, cb_pending_result_data, &cb_pending_result_type, data);
+  data->future.emplace(std::move(future));
+  return obj;
+}
+
+void
+init_pending_result(VALUE cBackend)
+{
+  cPendingResult = rb_define_class_under(cBackend, "PendingResult", rb_cObject);
+  rb_define_alloc_func(cPendingResult, cb_PendingResult_allocate);
+  rb_define_method(cPendingResult, "value", cb_PendingResult_value, 0);
+  rb_define_method(cPendingResult, "ready?", cb_PendingResult_is_ready, 0);
+}
+} // namespace couchbase::ruby
@@ -0,0 +1,42 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef COUCHBASE_RUBY_RCB_PENDING_RESULT_HXX
+#define COUCHBASE_RUBY_RCB_PENDING_RESULT_HXX
+
+#include <functional>
+
+#include <ruby/internal/value.h>
+
+#include "rcb_utils.hxx"
+
+namespace couchbase::ruby
+{
+/**
+ * Converts response of the core into Ruby value, must be invoked with GVL held. Might throw
+ * ruby_exception, which will be re-raised every time the pending result is requested.
+ */
+using cb_result_builder = std::function<VALUE()>;
+
+VALUE
+cb_pending_result_new(cb_future<cb_result_builder> future);
+
+void
+init_pending_result(VALUE cBackend);
+} // namespace couchbase::ruby
+
+#endif
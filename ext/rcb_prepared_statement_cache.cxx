@@ -0,0 +1,102 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "rcb_prepared_statement_cache.hxx"
+
+namespace couchbase::ruby
+{
+cb_prepared_statement_cache::cb_prepared_statement_cache(std::size_t capacity)
+  : capacity_{ capacity }
+{
+}
+
+auto
+cb_prepared_statement_cache::enabled() const -> bool
+{
+  return capacity_ > 0;
+}
+
+auto
+cb_prepared_statement_cache::get(const std::string& key) -> std::optional<std::string>
+{
+  const std::scoped_lock lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return {};
+  }
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+auto
+cb_prepared_statement_cache::contains(const std::string& key) const -> bool
+{
+  const std::scoped_lock lock(mutex_);
+  return index_.count(key) > 0;
+}
+
+void
+cb_prepared_statement_cache::put(const std::string& key, std::string name)
+{
+  if (capacity_ == 0) {
+    return;
+  }
+  const std::scoped_lock lock(mutex_);
+  if (auto it = index_.find(key); it != index_.end()) {
+    it->second->second = std::move(name);
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+  if (entries_.size() >= capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+    ++evictions_;
+  }
+  entries_.emplace_front(key, std::move(name));
+  index_.try_emplace(key, entries_.begin());
+}
+
+void
+cb_prepared_statement_cache::erase(const std::string& key)
+{
+  const std::scoped_lock lock(mutex_);
+  if (auto it = index_.find(key); it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+}
+
+auto
+cb_prepared_statement_cache::stats() const -> cb_prepared_statement_cache_stats
+{
+  const std::scoped_lock lock(mutex_);
+  return { capacity_, entries_.size(), hits_, misses_, evictions_ };
+}
+
+auto
+cb_prepared_statement_cache::make_key(const std::optional<std::string>& query_context,
+                                      const std::string& statement) -> std::string
+{
+  // the same statement refers to different keyspaces in different scopes
+  std::string key = query_context.value_or("");
+  key.push_back('\n');
+  key.append(statement);
+  return key;
+}
+} // namespace couchbase::ruby
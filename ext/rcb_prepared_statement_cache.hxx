@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef COUCHBASE_RUBY_RCB_PREPARED_STATEMENT_CACHE_HXX
+#define COUCHBASE_RUBY_RCB_PREPARED_STATEMENT_CACHE_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace couchbase::ruby
+{
+struct cb_prepared_statement_cache_stats {
+  std::size_t capacity{ 0 };
+  std::size_t size{ 0 };
+  std::uint64_t hits{ 0 };
+  std::uint64_t misses{ 0 };
+  std::uint64_t evictions{ 0 };
+};
+
+/**
+ * Bounded LRU mapping of the query statements (along with their query context) to the names of
+ * the prepared statements on the server. Owned by the backend, and used for the queries that have
+ * adhoc option turned off.
+ */
+class cb_prepared_statement_cache
+{
+public:
+  explicit cb_prepared_statement_cache(std::size_t capacity);
+
+  auto enabled() const -> bool;
+
+  /**
+   * Returns the name of the prepared statement and moves the entry to the head of the list.
+   * Counts the lookup as hit or miss.
+   */
+  auto get(const std::string& key) -> std::optional<std::string>;
+
+  /**
+   * Checks for the entry without touching the counters or the order of the entries.
+   */
+  auto contains(const std::string& key) const -> bool;
+
+  /**
+   * Inserts or replaces the entry, evicting the least recently used one when the cache is full.
+   */
+  void put(const std::string& key, std::string name);
+
+  void erase(const std::string& key);
+
+  auto stats() const -> cb_prepared_statement_cache_stats;
+
+  static auto make_key(const std::optional<std::string>& query_context,
+                       const std::string& statement) -> std::string;
+
+private:
+  using entry = std::pair<std::string, std::string>;
+
+  mutable std::mutex mutex_{};
+  std::size_t capacity_;
+  std::list<entry> entries_{};
+  std::unordered_map<std::string, std::list<entry>::iterator> index_{};
+  std::uint64_t hits_{ 0 };
+  std::uint64_t misses_{ 0 };
+  std::uint64_t evictions_{ 0 };
+};
+} // namespace couchbase::ruby
+
+#endif
@@ -16,21 +16,34 @@
  */
 
 #include <core/cluster.hxx>
+#include <core/logger/logger.hxx>
 #include <core/operations/document_query.hxx>
 #include <core/operations/management/query_index_build_deferred.hxx>
 #include <core/operations/management/query_index_create.hxx>
 #include <core/operations/management/query_index_drop.hxx>
 #include <core/operations/management/query_index_get_all.hxx>
+#include <core/utils/json.hxx>
 
 #include <gsl/narrow>
+#include <spdlog/fmt/bundled/core.h>
 
+#include <algorithm>
+#include <exception>
 #include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <ruby.h>
 
 #include "rcb_backend.hxx"
+#include "rcb_json.hxx"
 #include "rcb_observability.hxx"
+#include "rcb_prepared_statement_cache.hxx"
+#include "rcb_row_stream.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_utils.hxx"
 
 namespace couchbase::ruby
@@ -79,12 +92,12 @@ cb_Backend_query_index_get_all(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     VALUE indexes = rb_ary_new_capa(static_cast<long>(resp.indexes.size()));
     for (const auto& idx : resp.indexes) {
       VALUE index = rb_hash_new();
       rb_hash_aset(index, rb_id2sym(rb_intern("state")), rb_id2sym(rb_intern(idx.state.c_str())));
-      rb_hash_aset(index, rb_id2sym(rb_intern("name")), cb_str_new(idx.name));
+      rb_hash_aset(index, cb_symbols.name, cb_str_new(idx.name));
       rb_hash_aset(index, rb_id2sym(rb_intern("type")), rb_id2sym(rb_intern(idx.type.c_str())));
       rb_hash_aset(index, rb_id2sym(rb_intern("is_primary")), idx.is_primary ? Qtrue : Qfalse);
       VALUE index_key = rb_ary_new_capa(static_cast<long>(idx.index_key.size()));
@@ -99,7 +112,7 @@ cb_Backend_query_index_get_all(VALUE self,
       if (idx.scope_name) {
         rb_hash_aset(index, rb_id2sym(rb_intern("scope_name")), cb_str_new(idx.scope_name.value()));
       }
-      rb_hash_aset(index, rb_id2sym(rb_intern("bucket_name")), cb_str_new(idx.bucket_name));
+      rb_hash_aset(index, cb_symbols.bucket_name, cb_str_new(idx.bucket_name));
       if (idx.condition) {
         rb_hash_aset(index, rb_id2sym(rb_intern("condition")), cb_str_new(idx.condition.value()));
       }
@@ -206,16 +219,16 @@ cb_Backend_query_index_create(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -291,16 +304,16 @@ cb_Backend_query_index_drop(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -384,16 +397,16 @@ cb_Backend_query_index_create_primary(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
 
     return res;
@@ -471,16 +484,16 @@ cb_Backend_query_index_drop_primary(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -546,16 +559,16 @@ cb_Backend_query_index_build_deferred(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -568,17 +581,11 @@ cb_Backend_query_index_build_deferred(VALUE self,
 }
 
 int
-cb_for_each_named_param(VALUE key, VALUE value, VALUE arg)
+cb_collect_named_param(VALUE key, VALUE value, VALUE arg)
 {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  auto* preq = reinterpret_cast<core::operations::query_request*>(arg);
-  try {
-    cb_check_type(key, T_STRING);
-    cb_check_type(value, T_STRING);
-  } catch (const ruby_exception&) {
-    return ST_STOP;
-  }
-  preq->named_parameters[cb_string_new(key)] = cb_string_new(value);
+  auto* params = reinterpret_cast<std::vector<std::pair<VALUE, VALUE>>*>(arg);
+  params->emplace_back(key, value);
   return ST_CONTINUE;
 }
 
@@ -597,6 +604,288 @@ cb_for_each_raw_param(VALUE key, VALUE value, VALUE arg)
   return ST_CONTINUE;
 }
 
+void
+cb_extract_query_request(core::operations::query_request& req, VALUE statement, VALUE options)
+{
+  req.statement = cb_string_new(statement);
+  if (VALUE client_context_id = rb_hash_aref(options, cb_symbols.client_context_id);
+      !NIL_P(client_context_id)) {
+    cb_check_type(client_context_id, T_STRING);
+    req.client_context_id = cb_string_new(client_context_id);
+  }
+  cb_extract_timeout(req, options);
+  cb_extract_option_bool(req.adhoc, options, "adhoc");
+  cb_extract_option_bool(req.metrics, options, "metrics");
+  cb_extract_option_bool(req.readonly, options, "readonly");
+  cb_extract_option_bool(req.flex_index, options, "flex_index");
+  cb_extract_option_bool(req.preserve_expiry, options, "preserve_expiry");
+  cb_extract_option_bool(req.use_replica, options, "use_replica");
+  cb_extract_option_uint64(req.scan_cap, options, "scan_cap");
+  cb_extract_duration(req.scan_wait, options, "scan_wait");
+  cb_extract_option_uint64(req.max_parallelism, options, "max_parallelism");
+  cb_extract_option_uint64(req.pipeline_cap, options, "pipeline_cap");
+  cb_extract_option_uint64(req.pipeline_batch, options, "pipeline_batch");
+  if (VALUE query_context = rb_hash_aref(options, rb_id2sym(rb_intern("query_context")));
+      !NIL_P(query_context) && TYPE(query_context) == T_STRING) {
+    req.query_context.emplace(cb_string_new(query_context));
+  }
+  if (VALUE profile = rb_hash_aref(options, cb_symbols.profile); !NIL_P(profile)) {
+    cb_check_type(profile, T_SYMBOL);
+    ID mode = rb_sym2id(profile);
+    if (mode == rb_intern("phases")) {
+      req.profile = couchbase::query_profile::phases;
+    } else if (mode == rb_intern("timings")) {
+      req.profile = couchbase::query_profile::timings;
+    } else if (mode == rb_intern("off")) {
+      req.profile = couchbase::query_profile::off;
+    }
+  }
+  if (VALUE positional_params =
+        rb_hash_aref(options, rb_id2sym(rb_intern("positional_parameters")));
+      !NIL_P(positional_params)) {
+    cb_check_type(positional_params, T_ARRAY);
+    auto entries_num = static_cast<std::size_t>(RARRAY_LEN(positional_params));
+    req.positional_parameters.reserve(entries_num);
+    for (std::size_t i = 0; i < entries_num; ++i) {
+      VALUE entry = rb_ary_entry(positional_params, static_cast<long>(i));
+      req.positional_parameters.emplace_back(cb_json_generate(entry));
+    }
+  }
+  if (VALUE named_params = rb_hash_aref(options, rb_id2sym(rb_intern("named_parameters")));
+      !NIL_P(named_params)) {
+    cb_check_type(named_params, T_HASH);
+    // the values are encoded outside of the iteration, as the encoder might throw
+    std::vector<std::pair<VALUE, VALUE>> params{};
+    params.reserve(static_cast<std::size_t>(RHASH_SIZE(named_params)));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    rb_hash_foreach(named_params, cb_collect_named_param, reinterpret_cast<VALUE>(&params));
+    for (const auto& [key, value] : params) {
+      VALUE name = TYPE(key) == T_SYMBOL ? rb_sym2str(key) : rb_obj_as_string(key);
+      req.named_parameters[cb_string_new(name)] = cb_json_generate(value);
+    }
+    RB_GC_GUARD(named_params);
+  }
+  if (VALUE scan_consistency = rb_hash_aref(options, rb_id2sym(rb_intern("scan_consistency")));
+      !NIL_P(scan_consistency)) {
+    cb_check_type(scan_consistency, T_SYMBOL);
+    ID type = rb_sym2id(scan_consistency);
+    if (type == rb_intern("not_bounded")) {
+      req.scan_consistency = couchbase::query_scan_consistency::not_bounded;
+    } else if (type == rb_intern("request_plus")) {
+      req.scan_consistency = couchbase::query_scan_consistency::request_plus;
+    }
+  }
+  if (VALUE mutation_state = rb_hash_aref(options, rb_id2sym(rb_intern("mutation_state")));
+      !NIL_P(mutation_state)) {
+    cb_check_type(mutation_state, T_ARRAY);
+    auto state_size = static_cast<std::size_t>(RARRAY_LEN(mutation_state));
+    req.mutation_state.reserve(state_size);
+    for (std::size_t i = 0; i < state_size; ++i) {
+      VALUE token = rb_ary_entry(mutation_state, static_cast<long>(i));
+      cb_check_type(token, T_HASH);
+      VALUE bucket_name = rb_hash_aref(token, cb_symbols.bucket_name);
+      cb_check_type(bucket_name, T_STRING);
+      VALUE partition_id = rb_hash_aref(token, cb_symbols.partition_id);
+      cb_check_type(partition_id, T_FIXNUM);
+      VALUE partition_uuid = rb_hash_aref(token, cb_symbols.partition_uuid);
+      switch (TYPE(partition_uuid)) {
+        case T_FIXNUM:
+        case T_BIGNUM:
+          break;
+        default:
+          rb_raise(rb_eArgError, "partition_uuid must be an Integer");
+      }
+      VALUE sequence_number = rb_hash_aref(token, cb_symbols.sequence_number);
+      switch (TYPE(sequence_number)) {
+        case T_FIXNUM:
+        case T_BIGNUM:
+          break;
+        default:
+          rb_raise(rb_eArgError, "sequence_number must be an Integer");
+      }
+      req.mutation_state.emplace_back(NUM2ULL(partition_uuid),
+                                      NUM2ULL(sequence_number),
+                                      gsl::narrow_cast<std::uint16_t>(NUM2UINT(partition_id)),
+                                      cb_string_new(bucket_name));
+    }
+  }
+
+  if (VALUE raw_params = rb_hash_aref(options, rb_id2sym(rb_intern("raw_parameters")));
+      !NIL_P(raw_params)) {
+    cb_check_type(raw_params, T_HASH);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    rb_hash_foreach(raw_params, cb_for_each_raw_param, reinterpret_cast<VALUE>(&req));
+  }
+}
+
+void
+cb_check_query_response(const core::operations::query_response& resp)
+{
+  if (resp.ctx.ec) {
+    if (resp.meta.errors && !resp.meta.errors->empty()) {
+      const auto& first_error = resp.meta.errors->front();
+      cb_throw_error(
+        resp.ctx,
+        fmt::format(R"(unable to query ({}: {}))", first_error.code, first_error.message));
+    } else {
+      cb_throw_error(resp.ctx, "unable to query");
+    }
+  }
+}
+
+VALUE
+cb_create_query_meta(const core::operations::query_response& resp)
+{
+  VALUE meta = rb_hash_new();
+  rb_hash_aset(
+    meta,
+    cb_symbols.status,
+    rb_id2sym(rb_intern2(resp.meta.status.data(), static_cast<long>(resp.meta.status.size()))));
+  rb_hash_aset(meta, cb_symbols.request_id, cb_str_new(resp.meta.request_id));
+  rb_hash_aset(meta, cb_symbols.client_context_id, cb_str_new(resp.meta.client_context_id));
+  if (resp.meta.signature) {
+    rb_hash_aset(meta, cb_symbols.signature, cb_str_new(resp.meta.signature.value()));
+  }
+  if (resp.meta.profile) {
+    rb_hash_aset(meta, cb_symbols.profile, cb_str_new(resp.meta.profile.value()));
+  }
+  if (resp.meta.metrics) {
+    VALUE metrics = rb_hash_new();
+    rb_hash_aset(meta, cb_symbols.metrics, metrics);
+    rb_hash_aset(metrics,
+                 cb_symbols.elapsed_time,
+                 ULL2NUM(resp.meta.metrics->elapsed_time.count()));
+    rb_hash_aset(metrics,
+                 cb_symbols.execution_time,
+                 ULL2NUM(resp.meta.metrics->execution_time.count()));
+    rb_hash_aset(metrics, cb_symbols.result_count, ULL2NUM(resp.meta.metrics->result_count));
+    rb_hash_aset(metrics, cb_symbols.result_size, ULL2NUM(resp.meta.metrics->result_size));
+    rb_hash_aset(metrics, cb_symbols.sort_count, ULL2NUM(resp.meta.metrics->sort_count));
+    rb_hash_aset(metrics, cb_symbols.mutation_count, ULL2NUM(resp.meta.metrics->mutation_count));
+    rb_hash_aset(metrics, cb_symbols.error_count, ULL2NUM(resp.meta.metrics->error_count));
+    rb_hash_aset(metrics, cb_symbols.warning_count, ULL2NUM(resp.meta.metrics->warning_count));
+  }
+  return meta;
+}
+
+VALUE
+cb_create_query_result(const core::operations::query_response& resp)
+{
+  VALUE res = rb_hash_new();
+  VALUE rows = rb_ary_new_capa(static_cast<long>(resp.rows.size()));
+  rb_hash_aset(res, cb_symbols.rows, rows);
+  for (const auto& row : resp.rows) {
+    rb_ary_push(rows, cb_str_new(row));
+  }
+  rb_hash_aset(res, cb_symbols.meta, cb_create_query_meta(resp));
+  return res;
+}
+
+auto
+cb_execute_query_request(core::cluster& cluster, const core::operations::query_request& req)
+  -> core::operations::query_response
+{
+  std::promise<core::operations::query_response> promise;
+  auto f = promise.get_future();
+  cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
+    promise.set_value(std::forward<decltype(resp)>(resp));
+  });
+  return cb_wait_for_future(f);
+}
+
+/**
+ * Sends PREPARE for the statement of the request, and remembers the name of the prepared
+ * statement in the cache. Returns the response of PREPARE (which carries the error if the
+ * statement cannot be prepared) along with the name.
+ */
+auto
+cb_prepare_statement(core::cluster& cluster,
+                     cb_prepared_statement_cache& cache,
+                     const core::operations::query_request& req,
+                     const std::string& key)
+  -> std::pair<core::operations::query_response, std::optional<std::string>>
+{
+  core::operations::query_request prepare_req{};
+  prepare_req.statement = fmt::format("PREPARE {}", req.statement);
+  prepare_req.query_context = req.query_context;
+  prepare_req.timeout = req.timeout;
+  prepare_req.parent_span = req.parent_span;
+  auto resp = cb_execute_query_request(cluster, prepare_req);
+  if (resp.ctx.ec || resp.rows.empty()) {
+    return { std::move(resp), {} };
+  }
+
+  std::optional<std::string> name{};
+  try {
+    auto row = core::utils::json::parse(resp.rows.front());
+    if (const auto* value = row.find("name"); value != nullptr && value->is_string()) {
+      name = value->get_string();
+      cache.put(key, name.value());
+    }
+  } catch (const std::exception& e) {
+    CB_LOG_WARNING("unable to parse response of PREPARE: {}", e.what());
+  }
+  return { std::move(resp), std::move(name) };
+}
+
+/**
+ * Server reports these codes when it does not know the prepared statement or cannot use it (for
+ * example, after restart of the query node or change of the indexes).
+ */
+auto
+cb_is_stale_prepared_statement(const core::operations::query_response& resp) -> bool
+{
+  if (!resp.ctx.ec || !resp.meta.errors) {
+    return false;
+  }
+  return std::any_of(resp.meta.errors->begin(), resp.meta.errors->end(), [](const auto& error) {
+    return error.code >= 4040 && error.code <= 4090;
+  });
+}
+
+void
+cb_use_prepared_statement(core::operations::query_request& req, const std::string& name)
+{
+  req.statement = fmt::format("EXECUTE `{}`", name);
+  // the statement has been prepared already, do not let the core prepare it again
+  req.adhoc = true;
+}
+
+/**
+ * Executes non-adhoc query by the name of its prepared statement, sending PREPARE first if the
+ * cache does not know the statement. If the server has forgotten the cached statement, it is
+ * prepared again once.
+ */
+auto
+cb_execute_prepared_query(core::cluster& cluster,
+                          cb_prepared_statement_cache& cache,
+                          const core::operations::query_request& req)
+  -> core::operations::query_response
+{
+  const auto key = cb_prepared_statement_cache::make_key(req.query_context, req.statement);
+  if (auto name = cache.get(key); name) {
+    auto execute_req = req;
+    cb_use_prepared_statement(execute_req, name.value());
+    auto resp = cb_execute_query_request(cluster, execute_req);
+    if (!cb_is_stale_prepared_statement(resp)) {
+      return resp;
+    }
+    cache.erase(key);
+  }
+
+  auto [prepare_resp, name] = cb_prepare_statement(cluster, cache, req, key);
+  if (prepare_resp.ctx.ec) {
+    return std::move(prepare_resp);
+  }
+  if (!name) {
+    // let the core deal with the statement, if the server responded unexpectedly
+    return cb_execute_query_request(cluster, req);
+  }
+  auto execute_req = req;
+  cb_use_prepared_statement(execute_req, name.value());
+  return cb_execute_query_request(cluster, execute_req);
+}
+
 VALUE
 cb_Backend_document_query(VALUE self, VALUE statement, VALUE options, VALUE observability_handler)
 {
@@ -607,174 +896,236 @@ cb_Backend_document_query(VALUE self, VALUE statement, VALUE options, VALUE obse
 
   try {
     core::operations::query_request req;
-    req.statement = cb_string_new(statement);
-    if (VALUE client_context_id = rb_hash_aref(options, rb_id2sym(rb_intern("client_context_id")));
-        !NIL_P(client_context_id)) {
-      cb_check_type(client_context_id, T_STRING);
-      req.client_context_id = cb_string_new(client_context_id);
-    }
-    cb_extract_timeout(req, options);
-    cb_extract_option_bool(req.adhoc, options, "adhoc");
-    cb_extract_option_bool(req.metrics, options, "metrics");
-    cb_extract_option_bool(req.readonly, options, "readonly");
-    cb_extract_option_bool(req.flex_index, options, "flex_index");
-    cb_extract_option_bool(req.preserve_expiry, options, "preserve_expiry");
-    cb_extract_option_bool(req.use_replica, options, "use_replica");
-    cb_extract_option_uint64(req.scan_cap, options, "scan_cap");
-    cb_extract_duration(req.scan_wait, options, "scan_wait");
-    cb_extract_option_uint64(req.max_parallelism, options, "max_parallelism");
-    cb_extract_option_uint64(req.pipeline_cap, options, "pipeline_cap");
-    cb_extract_option_uint64(req.pipeline_batch, options, "pipeline_batch");
-    if (VALUE query_context = rb_hash_aref(options, rb_id2sym(rb_intern("query_context")));
-        !NIL_P(query_context) && TYPE(query_context) == T_STRING) {
-      req.query_context.emplace(cb_string_new(query_context));
+    cb_extract_query_request(req, statement, options);
+    auto parent_span = cb_create_parent_span(req, self);
+
+    auto cache = cb_backend_to_prepared_statement_cache(self);
+    auto resp = (!req.adhoc && cache->enabled())
+                  ? cb_execute_prepared_query(cluster, *cache, req)
+                  : cb_execute_query_request(cluster, req);
+    cb_add_core_spans(observability_handler, std::move(parent_span), resp.ctx.retry_attempts);
+    cb_check_query_response(resp);
+    return cb_create_query_result(resp);
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+struct cb_query_multi_batch {
+  explicit cb_query_multi_batch(std::size_t size)
+    : responses(size)
+    , latch{ size }
+  {
+  }
+
+  std::vector<core::operations::query_response> responses;
+  cb_countdown_latch latch;
+};
+
+/**
+ * Executes independent queries concurrently, and waits for all of them at once without holding
+ * GVL, so that the latency of the batch is the latency of the slowest query. Every query is a
+ * pair of the statement and its options, and has its own observability handler. Every entry of
+ * the result has either :rows and :meta, or :error.
+ *
+ * Non-adhoc queries use the prepared statement only if it is in the cache already, otherwise
+ * they are prepared by the core to avoid the extra blocking round trip. If the server has
+ * forgotten the cached statement, the query is prepared and executed again once.
+ */
+VALUE
+cb_Backend_document_query_multi(VALUE self, VALUE queries, VALUE observability_handlers)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+  auto cache = cb_backend_to_prepared_statement_cache(self);
+
+  Check_Type(queries, T_ARRAY);
+  Check_Type(observability_handlers, T_ARRAY);
+
+  try {
+    auto queries_size = static_cast<std::size_t>(RARRAY_LEN(queries));
+    if (static_cast<std::size_t>(RARRAY_LEN(observability_handlers)) != queries_size) {
+      throw ruby_exception(rb_eArgError, "every query must have its observability handler");
     }
-    if (VALUE profile = rb_hash_aref(options, rb_id2sym(rb_intern("profile"))); !NIL_P(profile)) {
-      cb_check_type(profile, T_SYMBOL);
-      ID mode = rb_sym2id(profile);
-      if (mode == rb_intern("phases")) {
-        req.profile = couchbase::query_profile::phases;
-      } else if (mode == rb_intern("timings")) {
-        req.profile = couchbase::query_profile::timings;
-      } else if (mode == rb_intern("off")) {
-        req.profile = couchbase::query_profile::off;
+    std::vector<core::operations::query_request> requests(queries_size);
+    // original requests of the queries that use cached prepared statements
+    std::vector<std::optional<core::operations::query_request>> prepared_requests(queries_size);
+    std::vector<std::shared_ptr<core::tracing::wrapper_sdk_span>> parent_spans{};
+    parent_spans.reserve(queries_size);
+    for (std::size_t i = 0; i < queries_size; ++i) {
+      VALUE query = rb_ary_entry(queries, static_cast<long>(i));
+      cb_check_type(query, T_ARRAY);
+      if (RARRAY_LEN(query) != 2) {
+        throw ruby_exception(rb_eArgError, "query must be a pair of statement and options");
       }
-    }
-    if (VALUE positional_params =
-          rb_hash_aref(options, rb_id2sym(rb_intern("positional_parameters")));
-        !NIL_P(positional_params)) {
-      cb_check_type(positional_params, T_ARRAY);
-      auto entries_num = static_cast<std::size_t>(RARRAY_LEN(positional_params));
-      req.positional_parameters.reserve(entries_num);
-      for (std::size_t i = 0; i < entries_num; ++i) {
-        VALUE entry = rb_ary_entry(positional_params, static_cast<long>(i));
-        cb_check_type(entry, T_STRING);
-        req.positional_parameters.emplace_back(cb_string_new(entry));
+      VALUE statement = rb_ary_entry(query, 0);
+      cb_check_type(statement, T_STRING);
+      VALUE options = rb_ary_entry(query, 1);
+      cb_check_type(options, T_HASH);
+
+      auto& req = requests[i];
+      cb_extract_query_request(req, statement, options);
+      parent_spans.emplace_back(cb_create_parent_span(req, self));
+      if (!req.adhoc && cache->enabled()) {
+        auto key = cb_prepared_statement_cache::make_key(req.query_context, req.statement);
+        if (auto name = cache->get(key); name) {
+          prepared_requests[i] = req;
+          cb_use_prepared_statement(req, name.value());
+        }
       }
     }
-    if (VALUE named_params = rb_hash_aref(options, rb_id2sym(rb_intern("named_parameters")));
-        !NIL_P(named_params)) {
-      cb_check_type(named_params, T_HASH);
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      rb_hash_foreach(named_params, cb_for_each_named_param, reinterpret_cast<VALUE>(&req));
+
+    auto batch = std::make_shared<cb_query_multi_batch>(queries_size);
+    for (std::size_t i = 0; i < queries_size; ++i) {
+      cluster.execute(std::move(requests[i]), [batch, i](auto&& resp) {
+        batch->responses[i] = std::forward<decltype(resp)>(resp);
+        batch->latch.count_down();
+      });
     }
-    if (VALUE scan_consistency = rb_hash_aref(options, rb_id2sym(rb_intern("scan_consistency")));
-        !NIL_P(scan_consistency)) {
-      cb_check_type(scan_consistency, T_SYMBOL);
-      ID type = rb_sym2id(scan_consistency);
-      if (type == rb_intern("not_bounded")) {
-        req.scan_consistency = couchbase::query_scan_consistency::not_bounded;
-      } else if (type == rb_intern("request_plus")) {
-        req.scan_consistency = couchbase::query_scan_consistency::request_plus;
+    cb_wait_for_latch(batch->latch);
+
+    for (std::size_t i = 0; i < queries_size; ++i) {
+      if (prepared_requests[i] && cb_is_stale_prepared_statement(batch->responses[i])) {
+        const auto& req = prepared_requests[i].value();
+        cache->erase(cb_prepared_statement_cache::make_key(req.query_context, req.statement));
+        batch->responses[i] = cb_execute_prepared_query(cluster, *cache, req);
       }
     }
-    if (VALUE mutation_state = rb_hash_aref(options, rb_id2sym(rb_intern("mutation_state")));
-        !NIL_P(mutation_state)) {
-      cb_check_type(mutation_state, T_ARRAY);
-      auto state_size = static_cast<std::size_t>(RARRAY_LEN(mutation_state));
-      req.mutation_state.reserve(state_size);
-      for (std::size_t i = 0; i < state_size; ++i) {
-        VALUE token = rb_ary_entry(mutation_state, static_cast<long>(i));
-        cb_check_type(token, T_HASH);
-        VALUE bucket_name = rb_hash_aref(token, rb_id2sym(rb_intern("bucket_name")));
-        cb_check_type(bucket_name, T_STRING);
-        VALUE partition_id = rb_hash_aref(token, rb_id2sym(rb_intern("partition_id")));
-        cb_check_type(partition_id, T_FIXNUM);
-        VALUE partition_uuid = rb_hash_aref(token, rb_id2sym(rb_intern("partition_uuid")));
-        switch (TYPE(partition_uuid)) {
-          case T_FIXNUM:
-          case T_BIGNUM:
-            break;
-          default:
-            rb_raise(rb_eArgError, "partition_uuid must be an Integer");
-        }
-        VALUE sequence_number = rb_hash_aref(token, rb_id2sym(rb_intern("sequence_number")));
-        switch (TYPE(sequence_number)) {
-          case T_FIXNUM:
-          case T_BIGNUM:
-            break;
-          default:
-            rb_raise(rb_eArgError, "sequence_number must be an Integer");
-        }
-        req.mutation_state.emplace_back(NUM2ULL(partition_uuid),
-                                        NUM2ULL(sequence_number),
-                                        gsl::narrow_cast<std::uint16_t>(NUM2UINT(partition_id)),
-                                        cb_string_new(bucket_name));
+
+    VALUE res = rb_ary_new_capa(static_cast<long>(queries_size));
+    for (std::size_t i = 0; i < queries_size; ++i) {
+      const auto& resp = batch->responses[i];
+      cb_add_core_spans(rb_ary_entry(observability_handlers, static_cast<long>(i)),
+                        parent_spans[i],
+                        resp.ctx.retry_attempts);
+      VALUE entry;
+      try {
+        cb_check_query_response(resp);
+        entry = cb_create_query_result(resp);
+      } catch (const ruby_exception& e) {
+        entry = rb_hash_new();
+        rb_hash_aset(entry, cb_symbols.error, e.exception_object());
       }
+      rb_ary_push(res, entry);
     }
+    return res;
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
 
-    if (VALUE raw_params = rb_hash_aref(options, rb_id2sym(rb_intern("raw_parameters")));
-        !NIL_P(raw_params)) {
-      cb_check_type(raw_params, T_HASH);
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      rb_hash_foreach(raw_params, cb_for_each_raw_param, reinterpret_cast<VALUE>(&req));
-    }
+/**
+ * Starts the query and returns Backend::RowStream, which delivers rows as they are received
+ * instead of collecting them in the response. Metadata (or error) is available once all rows
+ * have been consumed.
+ */
+VALUE
+cb_Backend_document_query_stream(VALUE self,
+                                 VALUE statement,
+                                 VALUE options,
+                                 VALUE observability_handler)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(statement, T_STRING);
+  Check_Type(options, T_HASH);
+
+  try {
+    core::operations::query_request req;
+    cb_extract_query_request(req, statement, options);
     auto parent_span = cb_create_parent_span(req, self);
 
-    std::promise<core::operations::query_response> promise;
-    auto f = promise.get_future();
-    cluster.execute(req, [promise = std::move(promise)](auto&& resp) mutable {
-      promise.set_value(std::forward<decltype(resp)>(resp));
-    });
-    auto resp = cb_wait_for_future(f);
-    cb_add_core_spans(observability_handler, std::move(parent_span), resp.ctx.retry_attempts);
-    if (resp.ctx.ec) {
-      if (resp.meta.errors && !resp.meta.errors->empty()) {
-        const auto& first_error = resp.meta.errors->front();
-        cb_throw_error(
-          resp.ctx,
-          fmt::format(R"(unable to query ({}: {}))", first_error.code, first_error.message));
-      } else {
-        cb_throw_error(resp.ctx, "unable to query");
+    auto cache = cb_backend_to_prepared_statement_cache(self);
+    std::optional<std::string> prepared_key{};
+    if (!req.adhoc && cache->enabled()) {
+      auto key = cb_prepared_statement_cache::make_key(req.query_context, req.statement);
+      auto name = cache->get(key);
+      if (!name) {
+        auto [prepare_resp, prepared_name] = cb_prepare_statement(cluster, *cache, req, key);
+        cb_check_query_response(prepare_resp);
+        name = std::move(prepared_name);
+      }
+      if (name) {
+        cb_use_prepared_statement(req, name.value());
+        prepared_key = std::move(key);
       }
     }
-    VALUE res = rb_hash_new();
-    VALUE rows = rb_ary_new_capa(static_cast<long>(resp.rows.size()));
-    rb_hash_aset(res, rb_id2sym(rb_intern("rows")), rows);
-    for (const auto& row : resp.rows) {
-      rb_ary_push(rows, cb_str_new(row));
-    }
-    VALUE meta = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("meta")), meta);
-    rb_hash_aset(
-      meta,
-      rb_id2sym(rb_intern("status")),
-      rb_id2sym(rb_intern2(resp.meta.status.data(), static_cast<long>(resp.meta.status.size()))));
-    rb_hash_aset(meta, rb_id2sym(rb_intern("request_id")), cb_str_new(resp.meta.request_id));
-    rb_hash_aset(
-      meta, rb_id2sym(rb_intern("client_context_id")), cb_str_new(resp.meta.client_context_id));
-    if (resp.meta.signature) {
-      rb_hash_aset(
-        meta, rb_id2sym(rb_intern("signature")), cb_str_new(resp.meta.signature.value()));
-    }
-    if (resp.meta.profile) {
-      rb_hash_aset(meta, rb_id2sym(rb_intern("profile")), cb_str_new(resp.meta.profile.value()));
+
+    auto stream = cb_backend_make_row_stream(self);
+    req.row_callback = [stream](std::string row) {
+      return stream->push(std::move(row)) ? core::utils::json::stream_control::next_row
+                                          : core::utils::json::stream_control::stop;
+    };
+    cluster.execute(
+      req, [stream, parent_span, observability_handler, cache, prepared_key](auto&& resp) {
+        stream->finish([resp = std::forward<decltype(resp)>(resp),
+                        parent_span,
+                        observability_handler,
+                        cache,
+                        prepared_key]() -> VALUE {
+          cb_add_core_spans(observability_handler, parent_span, resp.ctx.retry_attempts);
+          if (prepared_key && cb_is_stale_prepared_statement(resp)) {
+            // rows might have been delivered already, so only the next query will prepare again
+            cache->erase(prepared_key.value());
+          }
+          cb_check_query_response(resp);
+          VALUE res = rb_hash_new();
+          rb_hash_aset(res, cb_symbols.meta, cb_create_query_meta(resp));
+          return res;
+        });
+      });
+    return cb_row_stream_new(stream);
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+/**
+ * Prepares the statements that the cache does not know yet, so that the first execution of them
+ * does not pay for the extra round trip. Returns the number of statements that were prepared.
+ */
+VALUE
+cb_Backend_document_query_prepare(VALUE self, VALUE statements, VALUE options)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+  auto cache = cb_backend_to_prepared_statement_cache(self);
+
+  Check_Type(statements, T_ARRAY);
+  Check_Type(options, T_HASH);
+
+  try {
+    std::size_t prepared{ 0 };
+    if (!cache->enabled()) {
+      return ULL2NUM(prepared);
     }
-    if (resp.meta.metrics) {
-      VALUE metrics = rb_hash_new();
-      rb_hash_aset(meta, rb_id2sym(rb_intern("metrics")), metrics);
-      rb_hash_aset(metrics,
-                   rb_id2sym(rb_intern("elapsed_time")),
-                   ULL2NUM(resp.meta.metrics->elapsed_time.count()));
-      rb_hash_aset(metrics,
-                   rb_id2sym(rb_intern("execution_time")),
-                   ULL2NUM(resp.meta.metrics->execution_time.count()));
-      rb_hash_aset(
-        metrics, rb_id2sym(rb_intern("result_count")), ULL2NUM(resp.meta.metrics->result_count));
-      rb_hash_aset(
-        metrics, rb_id2sym(rb_intern("result_size")), ULL2NUM(resp.meta.metrics->result_size));
-      rb_hash_aset(
-        metrics, rb_id2sym(rb_intern("sort_count")), ULL2NUM(resp.meta.metrics->sort_count));
-      rb_hash_aset(metrics,
-                   rb_id2sym(rb_intern("mutation_count")),
-                   ULL2NUM(resp.meta.metrics->mutation_count));
-      rb_hash_aset(
-        metrics, rb_id2sym(rb_intern("error_count")), ULL2NUM(resp.meta.metrics->error_count));
-      rb_hash_aset(
-        metrics, rb_id2sym(rb_intern("warning_count")), ULL2NUM(resp.meta.metrics->warning_count));
+    auto statements_size = static_cast<std::size_t>(RARRAY_LEN(statements));
+    for (std::size_t i = 0; i < statements_size; ++i) {
+      VALUE statement = rb_ary_entry(statements, static_cast<long>(i));
+      cb_check_type(statement, T_STRING);
+      core::operations::query_request req;
+      cb_extract_query_request(req, statement, options);
+      auto key = cb_prepared_statement_cache::make_key(req.query_context, req.statement);
+      if (cache->contains(key)) {
+        continue;
+      }
+      auto [resp, name] = cb_prepare_statement(cluster, *cache, req, key);
+      cb_check_query_response(resp);
+      if (name) {
+        ++prepared;
+      }
     }
-
-    return res;
+    return ULL2NUM(prepared);
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
       se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
@@ -784,6 +1135,20 @@ cb_Backend_document_query(VALUE self, VALUE statement, VALUE options, VALUE obse
   return Qnil;
 }
 
+VALUE
+cb_Backend_document_query_prepared_statement_cache_stats(VALUE self)
+{
+  auto stats = cb_backend_to_prepared_statement_cache(self)->stats();
+
+  VALUE res = rb_hash_new();
+  rb_hash_aset(res, rb_id2sym(rb_intern("capacity")), ULL2NUM(stats.capacity));
+  rb_hash_aset(res, rb_id2sym(rb_intern("size")), ULL2NUM(stats.size));
+  rb_hash_aset(res, rb_id2sym(rb_intern("hits")), ULL2NUM(stats.hits));
+  rb_hash_aset(res, rb_id2sym(rb_intern("misses")), ULL2NUM(stats.misses));
+  rb_hash_aset(res, rb_id2sym(rb_intern("evictions")), ULL2NUM(stats.evictions));
+  return res;
+}
+
 VALUE
 cb_Backend_collection_query_index_get_all(VALUE self,
                                           VALUE bucket_name,
@@ -822,12 +1187,12 @@ cb_Backend_collection_query_index_get_all(VALUE self,
     }
 
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     VALUE indexes = rb_ary_new_capa(static_cast<long>(resp.indexes.size()));
     for (const auto& idx : resp.indexes) {
       VALUE index = rb_hash_new();
       rb_hash_aset(index, rb_id2sym(rb_intern("state")), rb_id2sym(rb_intern(idx.state.c_str())));
-      rb_hash_aset(index, rb_id2sym(rb_intern("name")), cb_str_new(idx.name));
+      rb_hash_aset(index, cb_symbols.name, cb_str_new(idx.name));
       rb_hash_aset(index, rb_id2sym(rb_intern("type")), rb_id2sym(rb_intern(idx.type.c_str())));
       rb_hash_aset(index, rb_id2sym(rb_intern("is_primary")), idx.is_primary ? Qtrue : Qfalse);
       VALUE index_key = rb_ary_new_capa(static_cast<long>(idx.index_key.size()));
@@ -842,7 +1207,7 @@ cb_Backend_collection_query_index_get_all(VALUE self,
       if (idx.scope_name) {
         rb_hash_aset(index, rb_id2sym(rb_intern("scope_name")), cb_str_new(idx.scope_name.value()));
       }
-      rb_hash_aset(index, rb_id2sym(rb_intern("bucket_name")), cb_str_new(idx.bucket_name));
+      rb_hash_aset(index, cb_symbols.bucket_name, cb_str_new(idx.bucket_name));
       if (idx.condition) {
         rb_hash_aset(index, rb_id2sym(rb_intern("condition")), cb_str_new(idx.condition.value()));
       }
@@ -954,16 +1319,16 @@ cb_Backend_collection_query_index_create(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -1045,16 +1410,16 @@ cb_Backend_collection_query_index_drop(VALUE self,
     }
     VALUE res = rb_hash_new();
 
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -1145,16 +1510,16 @@ cb_Backend_collection_query_index_create_primary(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -1238,16 +1603,16 @@ cb_Backend_collection_query_index_drop_primary(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -1307,16 +1672,16 @@ cb_Backend_collection_query_index_build_deferred(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     if (!resp.errors.empty()) {
       VALUE errors = rb_ary_new_capa(static_cast<long>(resp.errors.size()));
       for (const auto& err : resp.errors) {
         VALUE error = rb_hash_new();
-        rb_hash_aset(error, rb_id2sym(rb_intern("code")), ULL2NUM(err.code));
-        rb_hash_aset(error, rb_id2sym(rb_intern("message")), cb_str_new(err.message));
+        rb_hash_aset(error, cb_symbols.code, ULL2NUM(err.code));
+        rb_hash_aset(error, cb_symbols.message, cb_str_new(err.message));
         rb_ary_push(errors, error);
       }
-      rb_hash_aset(res, rb_id2sym(rb_intern("errors")), errors);
+      rb_hash_aset(res, cb_symbols.errors, errors);
     }
     return res;
   } catch (const std::system_error& se) {
@@ -1334,6 +1699,13 @@ void
 init_query(VALUE cBackend)
 {
   rb_define_method(cBackend, "document_query", cb_Backend_document_query, 3);
+  rb_define_method(cBackend, "document_query_stream", cb_Backend_document_query_stream, 3);
+  rb_define_method(cBackend, "document_query_multi", cb_Backend_document_query_multi, 2);
+  rb_define_method(cBackend, "document_query_prepare", cb_Backend_document_query_prepare, 2);
+  rb_define_method(cBackend,
+                   "document_query_prepared_statement_cache_stats",
+                   cb_Backend_document_query_prepared_statement_cache_stats,
+                   0);
 
   rb_define_method(cBackend, "query_index_get_all", cb_Backend_query_index_get_all, 3);
   rb_define_method(cBackend, "query_index_create", cb_Backend_query_index_create, 5);
@@ -16,23 +16,40 @@
  */
 
 #include <core/agent_group.hxx>
-#include <core/agent_group_config.hxx>
 #include <core/cluster.hxx>
 #include <core/range_scan_options.hxx>
 #include <core/range_scan_orchestrator.hxx>
 #include <core/range_scan_orchestrator_options.hxx>
 #include <core/scan_result.hxx>
+#include <core/topology/configuration.hxx>
+#include <core/utils/json.hxx>
 #include <couchbase/error_codes.hxx>
 
 #include <spdlog/fmt/bundled/core.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <future>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 #include <gsl/util>
 #include <ruby.h>
 
 #include "rcb_backend.hxx"
+#include "rcb_json.hxx"
 #include "rcb_range_scan.hxx"
+#include "rcb_scan_agent_cache.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_utils.hxx"
 
 namespace couchbase::ruby
@@ -41,8 +58,116 @@ namespace
 {
 struct cb_core_scan_result_data {
   std::unique_ptr<couchbase::core::scan_result> scan_result;
+  // error (or completion) that ended the previous batch, reported by the following call
+  std::error_code deferred_error;
+  // used to map the keys to vbuckets for the checkpoints
+  std::unique_ptr<couchbase::core::topology::configuration> config;
+  // the last keys delivered for each vbucket before the scan was resumed
+  std::unique_ptr<std::map<std::uint16_t, std::string>> resume_from;
+  // the bodies are dropped before creating Ruby objects, only the metadata is returned
+  bool metadata_only;
+  // fields (each path split by dots) to keep in the JSON bodies
+  std::unique_ptr<std::vector<std::vector<std::string>>> projections;
 };
 
+auto
+cb_scan_item_vbucket(couchbase::core::topology::configuration* config, const std::string& key)
+  -> std::uint16_t
+{
+  return config->map_key(key, 0).first;
+}
+
+/**
+ * Keys of the vbucket are streamed in order, so everything up to the checkpoint has been
+ * delivered by the scan that is being resumed.
+ */
+auto
+cb_scan_item_is_delivered(const std::map<std::uint16_t, std::string>* resume_from,
+                          std::uint16_t vbucket,
+                          const std::string& key) -> bool
+{
+  if (resume_from == nullptr) {
+    return false;
+  }
+  auto it = resume_from->find(vbucket);
+  return it != resume_from->end() && key <= it->second;
+}
+
+/**
+ * Builds the document that only contains the given paths. Returns empty optional if the body is
+ * not a JSON object, so that the transcoder could handle the original body.
+ */
+auto
+cb_project_document(const std::vector<std::byte>& body,
+                    const std::vector<std::vector<std::string>>& projections)
+  -> std::optional<std::vector<std::byte>>
+{
+  tao::json::value document;
+  try {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    document = core::utils::json::parse(reinterpret_cast<const char*>(body.data()), body.size());
+  } catch (const std::exception&) {
+    return {};
+  }
+  if (!document.is_object()) {
+    return {};
+  }
+
+  tao::json::value projected = tao::json::empty_object;
+  for (const auto& path : projections) {
+    const tao::json::value* source = &document;
+    for (const auto& field : path) {
+      source = source->is_object() ? source->find(field) : nullptr;
+      if (source == nullptr) {
+        break;
+      }
+    }
+    if (source == nullptr) {
+      continue;
+    }
+    tao::json::value* target = &projected;
+    for (std::size_t i = 0; i + 1 < path.size() && target->is_object(); ++i) {
+      target = &target->get_object().try_emplace(path[i], tao::json::empty_object).first->second;
+    }
+    if (target->is_object()) {
+      target->get_object().insert_or_assign(path.back(), *source);
+    }
+  }
+
+  auto encoded = core::utils::json::generate(projected);
+  std::vector<std::byte> result(encoded.size());
+  std::transform(encoded.begin(), encoded.end(), result.begin(), [](char c) {
+    return static_cast<std::byte>(c);
+  });
+  return result;
+}
+
+/**
+ * Applies the options of the scan to the received item, and returns false if the item has to be
+ * skipped. Does not require GVL.
+ */
+auto
+cb_prepare_scan_item(const cb_core_scan_result_data* data,
+                     couchbase::core::range_scan_item& item,
+                     std::uint16_t& vbucket) -> bool
+{
+  vbucket = cb_scan_item_vbucket(data->config.get(), item.key);
+  if (cb_scan_item_is_delivered(data->resume_from.get(), vbucket, item.key)) {
+    return false;
+  }
+  if (!item.body.has_value()) {
+    return true;
+  }
+  if (data->metadata_only) {
+    item.body->value = {};
+  } else if (data->projections && cb_json_flags_describe_json(item.body->flags)) {
+    if (auto projected = cb_project_document(item.body->value, *data->projections); projected) {
+      item.body->value = std::move(projected.value());
+    }
+  }
+  return true;
+}
+
 void
 cb_CoreScanResult_mark(void* ptr)
 {
@@ -57,6 +182,9 @@ cb_CoreScanResult_free(void* ptr)
     data->scan_result->cancel();
   }
   data->scan_result.reset();
+  data->config.reset();
+  data->resume_from.reset();
+  data->projections.reset();
   ruby_xfree(data);
 }
 
@@ -78,6 +206,7 @@ cb_CoreScanResult_allocate(VALUE klass)
   cb_core_scan_result_data* data = nullptr;
   VALUE obj =
     TypedData_Make_Struct(klass, cb_core_scan_result_data, &cb_core_scan_result_type, data);
+  data->deferred_error = {};
   return obj;
 }
 
@@ -102,44 +231,173 @@ cb_CoreScanResult_cancel(VALUE self)
   return Qnil;
 }
 
+int
+cb_collect_scan_checkpoint(VALUE vbucket, VALUE key, VALUE arg)
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto* entries = reinterpret_cast<std::vector<std::pair<VALUE, VALUE>>*>(arg);
+  entries->emplace_back(vbucket, key);
+  return ST_CONTINUE;
+}
+
 VALUE
-cb_CoreScanResult_next_item(VALUE self)
+cb_create_scan_item(const couchbase::core::range_scan_item& item,
+                    std::uint16_t vbucket,
+                    bool with_content)
+{
+  VALUE res = rb_hash_new();
+  rb_hash_aset(res, cb_symbols.id, cb_str_new(item.key));
+  rb_hash_aset(res, cb_symbols.partition_id, UINT2NUM(vbucket));
+  if (item.body.has_value()) {
+    const auto& body = item.body.value();
+    if (with_content) {
+      rb_hash_aset(res, cb_symbols.encoded, cb_str_new(body.value));
+    }
+    rb_hash_aset(res, cb_symbols.cas, cb_cas_to_num(body.cas));
+    rb_hash_aset(res, cb_symbols.flags, UINT2NUM(body.flags));
+    rb_hash_aset(res, cb_symbols.expiry, UINT2NUM(body.expiry));
+    rb_hash_aset(res, cb_symbols.id_only, Qfalse);
+  } else {
+    rb_hash_aset(res, cb_symbols.id_only, Qtrue);
+  }
+  return res;
+}
+
+struct cb_scan_batch {
+  const cb_core_scan_result_data* data;
+  std::size_t max_items;
+  std::size_t max_bytes;
+  std::vector<std::pair<couchbase::core::range_scan_item, std::uint16_t>> items{};
+  std::error_code ec{};
+  std::atomic_bool interrupted{ false };
+  bool completed{ false };
+};
+
+/**
+ * Returns the limit of the batch, which must be a positive Integer. Bignums are larger than any
+ * batch could be, so they do not limit it.
+ */
+auto
+cb_extract_scan_batch_limit(VALUE value, const char* name) -> std::size_t
+{
+  if (FIXNUM_P(value) && FIX2LONG(value) > 0) {
+    return static_cast<std::size_t>(FIX2LONG(value));
+  }
+  if (RB_TYPE_P(value, T_BIGNUM) && RBIGNUM_POSITIVE_P(value)) {
+    return std::numeric_limits<std::size_t>::max();
+  }
+  throw ruby_exception(
+    exc_invalid_argument(),
+    rb_sprintf("%s must be a positive Integer, but given %+" PRIsVALUE, name, value));
+}
+
+/**
+ * Pulls the items from the orchestrator until one of the limits is reached or the scan ends.
+ * Called without GVL.
+ */
+void*
+cb_fill_scan_batch(void* param)
+{
+  auto* batch = static_cast<cb_scan_batch*>(param);
+  batch->items.reserve(std::min<std::size_t>(batch->max_items, 1024));
+  std::size_t bytes{ 0 };
+  while (batch->items.size() < batch->max_items && bytes < batch->max_bytes &&
+         !batch->interrupted) {
+    std::promise<std::pair<couchbase::core::range_scan_item, std::error_code>> promise;
+    auto f = promise.get_future();
+    batch->data->scan_result->next([promise = std::move(promise)](
+                                     couchbase::core::range_scan_item item,
+                                     std::error_code ec) mutable {
+      promise.set_value({ std::move(item), ec });
+    });
+    auto [item, ec] = f.get();
+    if (ec) {
+      batch->ec = ec;
+      break;
+    }
+    std::uint16_t vbucket{ 0 };
+    if (!cb_prepare_scan_item(batch->data, item, vbucket)) {
+      continue;
+    }
+    bytes += item.key.size();
+    if (item.body.has_value()) {
+      bytes += item.body->value.size();
+    }
+    batch->items.emplace_back(std::move(item), vbucket);
+  }
+  if (batch->interrupted && !batch->ec) {
+    // the scan has been cancelled, do not let the caller take it for completion
+    batch->ec = couchbase::errc::common::request_canceled;
+  }
+  batch->completed = true;
+  return nullptr;
+}
+
+/**
+ * Unblocking function of cb_fill_scan_batch, invoked when the Ruby thread is interrupted (e.g. by
+ * Thread#raise or signal). Cancels the scan, so that the pending item arrives with an error.
+ */
+void
+cb_interrupt_scan_batch(void* param)
+{
+  auto* batch = static_cast<cb_scan_batch*>(param);
+  batch->interrupted = true;
+  batch->data->scan_result->cancel();
+}
+
+VALUE
+cb_CoreScanResult_next_batch(VALUE self, VALUE max_items, VALUE max_bytes)
 {
   try {
     cb_core_scan_result_data* data = nullptr;
     TypedData_Get_Struct(self, cb_core_scan_result_data, &cb_core_scan_result_type, data);
-    std::promise<tl::expected<couchbase::core::range_scan_item, std::error_code>> promise;
-    auto f = promise.get_future();
-    data->scan_result->next([promise = std::move(promise)](couchbase::core::range_scan_item item,
-                                                           std::error_code ec) mutable {
-      if (ec) {
-        return promise.set_value(tl::unexpected(ec));
-      }
-      return promise.set_value(item);
-    });
-    auto resp = cb_wait_for_future(f);
-    if (!resp.has_value()) {
-      // If the error code is range_scan_completed return nil without raising an exception (nil
-      // signifies that there are no more items)
-      if (resp.error() != couchbase::errc::key_value::range_scan_completed) {
-        cb_throw_error_code(resp.error(), "unable to fetch next scan item");
+
+    if (auto ec = data->deferred_error; ec) {
+      if (ec != couchbase::errc::key_value::range_scan_completed) {
+        data->deferred_error = {};
+        cb_throw_error_code(ec, "unable to fetch next scan items");
       }
-      // Release ownership of scan_result unique pointer
       return Qnil;
     }
-    auto item = resp.value();
-    VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("id")), cb_str_new(item.key));
-    if (item.body.has_value()) {
-      auto body = item.body.value();
-      rb_hash_aset(res, rb_id2sym(rb_intern("id")), cb_str_new(item.key));
-      rb_hash_aset(res, rb_id2sym(rb_intern("encoded")), cb_str_new(body.value));
-      rb_hash_aset(res, rb_id2sym(rb_intern("cas")), cb_cas_to_num(body.cas));
-      rb_hash_aset(res, rb_id2sym(rb_intern("flags")), UINT2NUM(body.flags));
-      rb_hash_aset(res, rb_id2sym(rb_intern("expiry")), UINT2NUM(body.expiry));
-      rb_hash_aset(res, rb_id2sym(rb_intern("id_only")), Qfalse);
-    } else {
-      rb_hash_aset(res, rb_id2sym(rb_intern("id_only")), Qtrue);
+
+    auto items_limit = cb_extract_scan_batch_limit(max_items, "max_items");
+    auto bytes_limit = NIL_P(max_bytes) ? std::numeric_limits<std::size_t>::max()
+                                        : cb_extract_scan_batch_limit(max_bytes, "max_bytes");
+
+    // Pending interrupts of the thread are handled only when the batch does not hold anything,
+    // because raising from them unwinds the stack without running C++ destructors.
+    VALUE res = Qnil;
+    std::error_code ec{};
+    {
+      cb_scan_batch batch{ data, items_limit, bytes_limit };
+      while (!batch.completed) {
+        rb_thread_call_without_gvl2(cb_fill_scan_batch, &batch, cb_interrupt_scan_batch, &batch);
+        if (!batch.completed) {
+          // interrupted before the batch has started
+          rb_thread_check_ints();
+        }
+      }
+      flush_logger();
+
+      if (batch.items.empty()) {
+        if (batch.ec && batch.ec != couchbase::errc::key_value::range_scan_completed) {
+          ec = batch.ec;
+        } else {
+          data->deferred_error = batch.ec;
+        }
+      } else {
+        // the items received before the error are returned, and the error is raised by the next
+        // call
+        data->deferred_error = batch.ec;
+        res = rb_ary_new_capa(static_cast<long>(batch.items.size()));
+        for (const auto& [item, vbucket] : batch.items) {
+          rb_ary_push(res, cb_create_scan_item(item, vbucket, !data->metadata_only));
+        }
+      }
+    }
+    rb_thread_check_ints();
+    if (ec) {
+      cb_throw_error_code(ec, "unable to fetch next scan items");
     }
     return res;
   } catch (const std::system_error& se) {
@@ -151,6 +409,46 @@ cb_CoreScanResult_next_item(VALUE self)
   return Qnil;
 }
 
+VALUE
+cb_CoreScanResult_next_item(VALUE self)
+{
+  try {
+    cb_core_scan_result_data* data = nullptr;
+    TypedData_Get_Struct(self, cb_core_scan_result_data, &cb_core_scan_result_type, data);
+    while (true) {
+      std::promise<tl::expected<couchbase::core::range_scan_item, std::error_code>> promise;
+      auto f = promise.get_future();
+      data->scan_result->next([promise = std::move(promise)](
+                                couchbase::core::range_scan_item item, std::error_code ec) mutable {
+        if (ec) {
+          return promise.set_value(tl::unexpected(ec));
+        }
+        return promise.set_value(item);
+      });
+      auto resp = cb_wait_for_future(f);
+      if (!resp.has_value()) {
+        // If the error code is range_scan_completed return nil without raising an exception (nil
+        // signifies that there are no more items)
+        if (resp.error() != couchbase::errc::key_value::range_scan_completed) {
+          cb_throw_error_code(resp.error(), "unable to fetch next scan item");
+        }
+        // Release ownership of scan_result unique pointer
+        return Qnil;
+      }
+      std::uint16_t vbucket{ 0 };
+      if (cb_prepare_scan_item(data, resp.value(), vbucket)) {
+        return cb_create_scan_item(resp.value(), vbucket, !data->metadata_only);
+      }
+    }
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
 VALUE cCoreScanResult;
 
 VALUE
@@ -162,6 +460,7 @@ cb_Backend_document_scan_create(VALUE self,
                                 VALUE options)
 {
   auto cluster = cb_backend_to_core_api_cluster(self);
+  auto scan_agents = cb_backend_to_scan_agent_cache(self);
 
   Check_Type(bucket, T_STRING);
   Check_Type(scope, T_STRING);
@@ -191,11 +490,11 @@ cb_Backend_document_scan_create(VALUE self,
         for (std::size_t i = 0; i < state_size; ++i) {
           VALUE token = rb_ary_entry(mutation_state, static_cast<long>(i));
           cb_check_type(token, T_HASH);
-          VALUE bucket_name = rb_hash_aref(token, rb_id2sym(rb_intern("bucket_name")));
+          VALUE bucket_name = rb_hash_aref(token, cb_symbols.bucket_name);
           cb_check_type(bucket_name, T_STRING);
-          VALUE partition_id = rb_hash_aref(token, rb_id2sym(rb_intern("partition_id")));
+          VALUE partition_id = rb_hash_aref(token, cb_symbols.partition_id);
           cb_check_type(partition_id, T_FIXNUM);
-          VALUE partition_uuid = rb_hash_aref(token, rb_id2sym(rb_intern("partition_uuid")));
+          VALUE partition_uuid = rb_hash_aref(token, cb_symbols.partition_uuid);
           switch (TYPE(partition_uuid)) {
             case T_FIXNUM:
             case T_BIGNUM:
@@ -203,7 +502,7 @@ cb_Backend_document_scan_create(VALUE self,
             default:
               rb_raise(rb_eArgError, "partition_uuid must be an Integer");
           }
-          VALUE sequence_number = rb_hash_aref(token, rb_id2sym(rb_intern("sequence_number")));
+          VALUE sequence_number = rb_hash_aref(token, cb_symbols.sequence_number);
           switch (TYPE(sequence_number)) {
             case T_FIXNUM:
             case T_BIGNUM:
@@ -226,22 +525,18 @@ cb_Backend_document_scan_create(VALUE self,
     auto scope_name = cb_string_new(scope);
     auto collection_name = cb_string_new(collection);
 
-    // Getting the operation agent
-    auto agent_group = couchbase::core::agent_group(
-      cluster.io_context(), couchbase::core::agent_group_config{ { cluster } });
-    auto err = agent_group.open_bucket(bucket_name);
-    if (err) {
-      cb_throw_error_code(err, "unable to open bucket for range scan");
-      return Qnil;
-    }
-    auto agent = agent_group.get_agent(bucket_name);
+    // Getting the operation agent, the bucket is opened only by the first scan of the backend
+    auto agent = scan_agents->get_agent(cluster, bucket_name);
     if (!agent.has_value()) {
+      if (agent.error()) {
+        cb_throw_error_code(agent.error(), "unable to open bucket for range scan");
+      }
       rb_raise(exc_couchbase_error(),
                "Cannot perform scan operation. Unable to get operation agent");
       return Qnil;
     }
 
-    // Getting the vbucket map
+    // Getting the vbucket map, the configuration is not cached as the map changes on rebalance
     std::promise<tl::expected<couchbase::core::topology::configuration, std::error_code>> promise;
     auto f = promise.get_future();
     cluster.with_bucket_configuration(
@@ -267,6 +562,72 @@ cb_Backend_document_scan_create(VALUE self,
       return Qnil;
     }
 
+    // Extracting the options for the content of the documents
+    bool metadata_only{ false };
+    cb_extract_option_bool(metadata_only, options, "metadata_only");
+    std::unique_ptr<std::vector<std::vector<std::string>>> projections{};
+    VALUE projection_paths = Qnil;
+    cb_extract_option_array(projection_paths, options, "projections");
+    if (!NIL_P(projection_paths) && RARRAY_LEN(projection_paths) > 0) {
+      auto entries_num = static_cast<std::size_t>(RARRAY_LEN(projection_paths));
+      projections = std::make_unique<std::vector<std::vector<std::string>>>();
+      projections->reserve(entries_num);
+      for (std::size_t i = 0; i < entries_num; ++i) {
+        VALUE entry = rb_ary_entry(projection_paths, static_cast<long>(i));
+        cb_check_type(entry, T_STRING);
+        auto& path = projections->emplace_back();
+        std::string field{};
+        for (const char c : cb_string_new(entry)) {
+          if (c == '.') {
+            path.emplace_back(std::move(field));
+            field.clear();
+          } else {
+            field.push_back(c);
+          }
+        }
+        path.emplace_back(std::move(field));
+        if (std::any_of(path.begin(), path.end(), [](const auto& f) {
+              return f.empty();
+            })) {
+          throw ruby_exception(exc_invalid_argument(),
+                               rb_sprintf("Invalid projection path: %+" PRIsVALUE, entry));
+        }
+      }
+    }
+    if (orchestrator_options.ids_only && (metadata_only || projections)) {
+      throw ruby_exception(exc_invalid_argument(),
+                           "ids_only scan cannot be combined with metadata_only or projections");
+    }
+    if (metadata_only && projections) {
+      throw ruby_exception(exc_invalid_argument(),
+                           "metadata_only scan cannot be combined with projections");
+    }
+
+    // Extracting the checkpoint of the interrupted scan
+    std::unique_ptr<std::map<std::uint16_t, std::string>> resume_from{};
+    if (VALUE checkpoint = rb_hash_aref(options, rb_id2sym(rb_intern("resume_from")));
+        !NIL_P(checkpoint)) {
+      cb_check_type(checkpoint, T_HASH);
+      std::vector<std::pair<VALUE, VALUE>> entries{};
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      rb_hash_foreach(checkpoint, cb_collect_scan_checkpoint, reinterpret_cast<VALUE>(&entries));
+      resume_from = std::make_unique<std::map<std::uint16_t, std::string>>();
+      for (const auto& [vbucket, key] : entries) {
+        cb_check_type(vbucket, T_FIXNUM);
+        cb_check_type(key, T_STRING);
+        auto vbucket_id = NUM2UINT(vbucket);
+        if (vbucket_id >= vbucket_map->size()) {
+          throw ruby_exception(
+            exc_invalid_argument(),
+            rb_sprintf("Scan checkpoint refers to vbucket %u, but the bucket has only %lu",
+                       vbucket_id,
+                       static_cast<unsigned long>(vbucket_map->size())));
+        }
+        (*resume_from)[gsl::narrow_cast<std::uint16_t>(vbucket_id)] = cb_string_new(key);
+      }
+      RB_GC_GUARD(checkpoint);
+    }
+
     // Constructing the scan type
     std::variant<std::monostate,
                  couchbase::core::range_scan,
@@ -292,12 +653,30 @@ cb_Backend_document_scan_create(VALUE self,
         cb_extract_option_string(range_scan.to->term, to_hash, "term");
         cb_extract_option_bool(range_scan.to->exclusive, to_hash, "exclusive");
       }
+      // When every vbucket has progressed, the keys below the lowest checkpoint are not
+      // requested again. Otherwise the delivered items are only skipped on the client side.
+      if (resume_from && resume_from->size() == vbucket_map->size()) {
+        const auto& lowest = std::min_element(resume_from->begin(),
+                                              resume_from->end(),
+                                              [](const auto& lhs, const auto& rhs) {
+                                                return lhs.second < rhs.second;
+                                              })
+                               ->second;
+        if (!range_scan.from || range_scan.from->term < lowest) {
+          range_scan.from = couchbase::core::scan_term{ lowest, true };
+        }
+      }
       core_scan_type = range_scan;
     } else if (scan_type_id == rb_intern("prefix")) {
       auto prefix_scan = couchbase::core::prefix_scan{};
       cb_extract_option_string(prefix_scan.prefix, scan_type, "prefix");
       core_scan_type = prefix_scan;
     } else if (scan_type_id == rb_intern("sampling")) {
+      if (resume_from) {
+        // sampled keys are not streamed in order, so the checkpoint cannot tell what was delivered
+        throw ruby_exception(exc_invalid_argument(),
+                             "Sampling scan cannot be resumed from a checkpoint");
+      }
       auto sampling_scan = couchbase::core::sampling_scan{};
       cb_extract_option_number(sampling_scan.limit, scan_type, "limit");
       cb_extract_option_number(sampling_scan.seed, scan_type, "seed");
@@ -329,6 +708,11 @@ cb_Backend_document_scan_create(VALUE self,
     TypedData_Get_Struct(
       core_scan_result_obj, cb_core_scan_result_data, &cb_core_scan_result_type, data);
     data->scan_result = std::make_unique<couchbase::core::scan_result>(resp.value());
+    data->config =
+      std::make_unique<couchbase::core::topology::configuration>(std::move(config.value()));
+    data->resume_from = std::move(resume_from);
+    data->metadata_only = metadata_only;
+    data->projections = std::move(projections);
     return core_scan_result_obj;
 
   } catch (const std::system_error& se) {
@@ -350,6 +734,7 @@ init_range_scan(VALUE mCouchbase, VALUE cBackend)
   cCoreScanResult = rb_define_class_under(mCouchbase, "CoreScanResult", rb_cObject);
   rb_define_alloc_func(cCoreScanResult, cb_CoreScanResult_allocate);
   rb_define_method(cCoreScanResult, "next_item", cb_CoreScanResult_next_item, 0);
+  rb_define_method(cCoreScanResult, "next_batch", cb_CoreScanResult_next_batch, 2);
   rb_define_method(cCoreScanResult, "cancelled?", cb_CoreScanResult_is_cancelled, 0);
   rb_define_method(cCoreScanResult, "cancel", cb_CoreScanResult_cancel, 0);
 }
@@ -0,0 +1,337 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <couchbase/error_codes.hxx>
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <algorithm>
+#include <system_error>
+
+#include <ruby.h>
+#include <ruby/thread.h>
+
+#include "rcb_exceptions.hxx"
+#include "rcb_logger.hxx"
+#include "rcb_row_stream.hxx"
+#include "rcb_utils.hxx"
+
+namespace couchbase::ruby
+{
+cb_row_stream::cb_row_stream(std::size_t max_buffered_bytes)
+  : max_buffered_bytes_{ max_buffered_bytes }
+{
+}
+
+auto
+cb_row_stream::push(std::string&& row) -> bool
+{
+  bool accepted = true;
+  {
+    const std::scoped_lock lock(mutex_);
+    if (cancelled_ || overflowed_) {
+      return false;
+    }
+    if (max_buffered_bytes_ > 0 && buffered_bytes_ + row.size() > max_buffered_bytes_) {
+      // the consumer is too slow, release the memory and let it report the error
+      overflowed_ = true;
+      rows_.clear();
+      buffered_bytes_ = 0;
+      accepted = false;
+    } else {
+      buffered_bytes_ += row.size();
+      rows_.emplace_back(std::move(row));
+    }
+  }
+  ready_.notify_all();
+  return accepted;
+}
+
+void
+cb_row_stream::finish(std::function<VALUE()>&& finisher)
+{
+  {
+    const std::scoped_lock lock(mutex_);
+    finisher_ = std::move(finisher);
+    finished_ = true;
+  }
+  ready_.notify_all();
+}
+
+auto
+cb_row_stream::pop(std::size_t max_rows) -> std::optional<std::vector<std::string>>
+{
+  std::unique_lock lock(mutex_);
+  ready_.wait(lock, [this]() {
+    return !rows_.empty() || finished_ || cancelled_ || overflowed_ || woken_;
+  });
+  if (woken_ && rows_.empty() && !finished_ && !cancelled_ && !overflowed_) {
+    woken_ = false;
+    return {};
+  }
+  woken_ = false;
+  std::vector<std::string> rows{};
+  if (cancelled_ || overflowed_) {
+    return rows;
+  }
+  rows.reserve(std::min(max_rows, rows_.size()));
+  while (!rows_.empty() && rows.size() < max_rows) {
+    buffered_bytes_ -= rows_.front().size();
+    rows.emplace_back(std::move(rows_.front()));
+    rows_.pop_front();
+  }
+  return rows;
+}
+
+void
+cb_row_stream::wake()
+{
+  {
+    const std::scoped_lock lock(mutex_);
+    woken_ = true;
+  }
+  ready_.notify_all();
+}
+
+void
+cb_row_stream::cancel()
+{
+  {
+    const std::scoped_lock lock(mutex_);
+    cancelled_ = true;
+    rows_.clear();
+    buffered_bytes_ = 0;
+  }
+  ready_.notify_all();
+}
+
+auto
+cb_row_stream::take_finisher() -> std::function<VALUE()>
+{
+  const std::scoped_lock lock(mutex_);
+  return std::move(finisher_);
+}
+
+auto
+cb_row_stream::buffered_bytes() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return buffered_bytes_;
+}
+
+auto
+cb_row_stream::max_buffered_bytes() const -> std::size_t
+{
+  return max_buffered_bytes_;
+}
+
+auto
+cb_row_stream::overflowed() const -> bool
+{
+  const std::scoped_lock lock(mutex_);
+  return overflowed_;
+}
+
+namespace
+{
+struct cb_row_stream_data {
+  std::shared_ptr<cb_row_stream> stream{};
+  VALUE meta{ Qnil };
+  bool exhausted{ false };
+};
+
+void
+cb_RowStream_mark(void* ptr)
+{
+  const auto* data = static_cast<cb_row_stream_data*>(ptr);
+  rb_gc_mark(data->meta);
+}
+
+void
+cb_RowStream_free(void* ptr)
+{
+  auto* data = static_cast<cb_row_stream_data*>(ptr);
+  if (data->stream) {
+    // the object might be collected without reaching the end, do not keep reading the response
+    data->stream->cancel();
+  }
+  data->~cb_row_stream_data();
+  ruby_xfree(data);
+}
+
+std::size_t
+cb_RowStream_memsize(const void* ptr)
+{
+  const auto* data = static_cast<const cb_row_stream_data*>(ptr);
+  return sizeof(*data) + (data->stream ? data->stream->buffered_bytes() : 0);
+}
+
+const rb_data_type_t cb_row_stream_type{
+  "Couchbase/Backend/RowStream",
+  {
+    cb_RowStream_mark,
+    cb_RowStream_free,
+    cb_RowStream_memsize,
+// only one reserved field when GC.compact implemented
+#ifdef T_MOVED
+    nullptr,
+#endif
+    {},
+  },
+#ifdef RUBY_TYPED_FREE_IMMEDIATELY
+  nullptr,
+  nullptr,
+  RUBY_TYPED_FREE_IMMEDIATELY,
+#endif
+};
+
+VALUE cRowStream{ Qnil };
+
+VALUE
+cb_RowStream_allocate(VALUE klass)
+{
+  cb_row_stream_data* data = nullptr;
+  VALUE obj = TypedData_Make_Struct(klass, cb_row_stream_data, &cb_row_stream_type, data);
+  new (data) cb_row_stream_data();
+  return obj;
+}
+
+/**
+ * Waits (without GVL) for the next chunk of rows and returns them as Array of Strings, or nil
+ * when all rows have been consumed. In the latter case it also builds metadata of the response
+ * (available through #meta), or raises error if the operation has failed or the rows have been
+ * dropped because the buffer has overflowed.
+ */
+VALUE
+cb_RowStream_next_rows(VALUE self, VALUE max_rows)
+{
+  cb_row_stream_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_row_stream_data, &cb_row_stream_type, data);
+
+  Check_Type(max_rows, T_FIXNUM);
+  if (FIX2LONG(max_rows) <= 0) {
+    rb_raise(rb_eArgError, "max_rows must be a positive Integer");
+  }
+
+  if (data->exhausted || !data->stream) {
+    return Qnil;
+  }
+
+  try {
+    struct pop_args {
+      cb_row_stream* stream;
+      std::size_t max_rows;
+      std::optional<std::vector<std::string>> rows{};
+    } args{ data->stream.get(), static_cast<std::size_t>(FIX2LONG(max_rows)) };
+    while (true) {
+      // interrupts wake up the wait, and rb_thread_check_ints() handles them (or raises) while
+      // nothing is held by C++ objects on the stack
+      rb_thread_call_without_gvl2(
+        [](void* param) -> void* {
+          auto* args = static_cast<pop_args*>(param);
+          args->rows = args->stream->pop(args->max_rows);
+          return nullptr;
+        },
+        &args,
+        [](void* param) {
+          static_cast<cb_row_stream*>(param)->wake();
+        },
+        data->stream.get());
+      if (args.rows) {
+        break;
+      }
+      rb_thread_check_ints();
+    }
+    flush_logger();
+
+    if (args.rows->empty()) {
+      data->exhausted = true;
+      if (data->stream->overflowed()) {
+        throw ruby_exception(
+          cb_map_error_code(couchbase::errc::common::request_canceled,
+                            fmt::format("the consumer of the rows is too slow, more than {} bytes "
+                                        "have been buffered (see row_stream_max_buffered_bytes)",
+                                        data->stream->max_buffered_bytes()),
+                            false));
+      }
+      if (auto finisher = data->stream->take_finisher(); finisher) {
+        data->meta = finisher();
+      }
+      return Qnil;
+    }
+
+    VALUE rows = rb_ary_new_capa(static_cast<long>(args.rows->size()));
+    for (const auto& row : args.rows.value()) {
+      rb_ary_push(rows, cb_str_new(row));
+    }
+    return rows;
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
+/**
+ * Returns metadata of the response, once all rows have been consumed.
+ */
+VALUE
+cb_RowStream_meta(VALUE self)
+{
+  cb_row_stream_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_row_stream_data, &cb_row_stream_type, data);
+  return data->meta;
+}
+
+/**
+ * Stops reading the response. Subsequent calls of #next_rows return nil.
+ */
+VALUE
+cb_RowStream_cancel(VALUE self)
+{
+  cb_row_stream_data* data = nullptr;
+  TypedData_Get_Struct(self, cb_row_stream_data, &cb_row_stream_type, data);
+  if (data->stream && !data->exhausted) {
+    data->stream->cancel();
+    data->exhausted = true;
+  }
+  return Qnil;
+}
+} // namespace
+
+VALUE
+cb_row_stream_new(std::shared_ptr<cb_row_stream> stream)
+{
+  VALUE obj = rb_class_new_instance(0, nullptr, cRowStream);
+  cb_row_stream_data* data = nullptr;
+  TypedData_Get_Struct(obj, cb_row_stream_data, &cb_row_stream_type, data);
+  data->stream = std::move(stream);
+  return obj;
+}
+
+void
+init_row_stream(VALUE cBackend)
+{
+  cRowStream = rb_define_class_under(cBackend, "RowStream", rb_cObject);
+  rb_define_alloc_func(cRowStream, cb_RowStream_allocate);
+  rb_define_method(cRowStream, "next_rows", cb_RowStream_next_rows, 1);
+  rb_define_method(cRowStream, "meta", cb_RowStream_meta, 0);
+  rb_define_method(cRowStream, "cancel", cb_RowStream_cancel, 0);
+}
+} // namespace couchbase::ruby
@@ -0,0 +1,117 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef COUCHBASE_RUBY_RCB_ROW_STREAM_HXX
+#define COUCHBASE_RUBY_RCB_ROW_STREAM_HXX
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <ruby/internal/value.h>
+
+namespace couchbase::ruby
+{
+/**
+ * Buffer of rows between the row callback of the streaming HTTP operation (query, analytics,
+ * search), which is invoked on the IO thread, and the Ruby thread, which consumes the rows in
+ * chunks.
+ *
+ * The IO thread never waits for the consumer: blocking it would stall every other operation of
+ * the cluster, including the ones the consumer issues while handling the rows. So the rows that
+ * have not been consumed yet stay in the buffer as raw JSON, and once they take more than
+ * max_buffered_bytes, the stream stops reading the response and the consumer gets an error instead
+ * of the remaining rows. Zero limit leaves the buffer unbounded.
+ */
+class cb_row_stream
+{
+public:
+  explicit cb_row_stream(std::size_t max_buffered_bytes);
+
+  /**
+   * Called by the IO thread for every row. Returns false if the consumer has cancelled the
+   * stream, or the buffer has overflowed, in which case the operation should stop reading the
+   * response.
+   */
+  auto push(std::string&& row) -> bool;
+
+  /**
+   * Called by the IO thread once the response is complete. The finisher is invoked later on the
+   * Ruby thread (with GVL), and either builds the metadata of the response or throws
+   * ruby_exception.
+   */
+  void finish(std::function<VALUE()>&& finisher);
+
+  /**
+   * Waits without GVL until there are rows to consume or the response is complete, and returns
+   * up to max_rows rows. Empty result means that all rows have been consumed. Returns empty
+   * optional if the wait has been interrupted by wake().
+   */
+  auto pop(std::size_t max_rows) -> std::optional<std::vector<std::string>>;
+
+  /**
+   * Interrupts pop() without affecting the stream, so that the Ruby thread could handle its
+   * interrupts (e.g. Thread#raise, signals), and decide whether to continue waiting.
+   */
+  void wake();
+
+  /**
+   * Requests the operation to stop reading the response, and drops all buffered rows.
+   */
+  void cancel();
+
+  auto take_finisher() -> std::function<VALUE()>;
+
+  auto buffered_bytes() const -> std::size_t;
+
+  auto max_buffered_bytes() const -> std::size_t;
+
+  /**
+   * Tells whether the rows have been dropped, because the consumer could not keep up.
+   */
+  auto overflowed() const -> bool;
+
+private:
+  const std::size_t max_buffered_bytes_;
+  mutable std::mutex mutex_{};
+  std::condition_variable ready_{};
+  std::deque<std::string> rows_{};
+  std::size_t buffered_bytes_{ 0 };
+  std::function<VALUE()> finisher_{};
+  bool finished_{ false };
+  bool cancelled_{ false };
+  bool overflowed_{ false };
+  bool woken_{ false };
+};
+
+/**
+ * Wraps the stream into Backend::RowStream object, that is returned to Ruby.
+ */
+VALUE
+cb_row_stream_new(std::shared_ptr<cb_row_stream> stream);
+
+void
+init_row_stream(VALUE cBackend);
+} // namespace couchbase::ruby
+
+#endif
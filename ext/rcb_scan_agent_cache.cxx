@@ -0,0 +1,52 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <core/agent_group_config.hxx>
+
+#include "rcb_scan_agent_cache.hxx"
+
+namespace couchbase::ruby
+{
+auto
+cb_scan_agent_cache::get_agent(core::cluster& cluster, const std::string& bucket_name)
+  -> tl::expected<core::agent, std::error_code>
+{
+  const std::scoped_lock lock(mutex_);
+  if (auto it = agents_.find(bucket_name); it != agents_.end()) {
+    return it->second;
+  }
+  if (!agent_group_) {
+    agent_group_.emplace(cluster.io_context(), core::agent_group_config{ { cluster } });
+  }
+  if (auto ec = agent_group_->open_bucket(bucket_name); ec) {
+    return tl::unexpected(ec);
+  }
+  auto agent = agent_group_->get_agent(bucket_name);
+  if (agent.has_value()) {
+    agents_.try_emplace(bucket_name, agent.value());
+  }
+  return agent;
+}
+
+void
+cb_scan_agent_cache::clear()
+{
+  const std::scoped_lock lock(mutex_);
+  agents_.clear();
+  agent_group_.reset();
+}
+} // namespace couchbase::ruby
@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef COUCHBASE_RUBY_RCB_SCAN_AGENT_CACHE_HXX
+#define COUCHBASE_RUBY_RCB_SCAN_AGENT_CACHE_HXX
+
+#include <core/agent.hxx>
+#include <core/agent_group.hxx>
+#include <core/cluster.hxx>
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+
+#include <tl/expected.hpp>
+
+namespace couchbase::ruby
+{
+/**
+ * Keeps the agent group and the per-bucket agents used by the range scan orchestrator, so that
+ * creating a scan does not have to open the bucket again. Owned by the backend, and dropped when
+ * the backend is closed or the process is about to fork.
+ */
+class cb_scan_agent_cache
+{
+public:
+  /**
+   * Returns the agent for the bucket, creating the agent group and opening the bucket on the
+   * first use.
+   */
+  auto get_agent(core::cluster& cluster, const std::string& bucket_name)
+    -> tl::expected<core::agent, std::error_code>;
+
+  void clear();
+
+private:
+  std::mutex mutex_{};
+  std::optional<core::agent_group> agent_group_{};
+  std::map<std::string, core::agent, std::less<>> agents_{};
+};
+} // namespace couchbase::ruby
+
+#endif
@@ -15,6 +15,8 @@
  *   limitations under the License.
  */
 
+#include <couchbase/error_codes.hxx>
+
 #include <core/cluster.hxx>
 #include <core/error_context/search.hxx>
 #include <core/operations/document_search.hxx>
@@ -29,17 +31,22 @@
 #include <core/operations/management/search_index_get_documents_count.hxx>
 #include <core/operations/management/search_index_get_stats.hxx>
 #include <core/operations/management/search_index_upsert.hxx>
+#include <core/utils/json.hxx>
 
 #include <gsl/narrow>
 #include <spdlog/fmt/bundled/core.h>
 
+#include <exception>
 #include <future>
 #include <memory>
+#include <string>
 
 #include <ruby.h>
 
 #include "rcb_backend.hxx"
 #include "rcb_observability.hxx"
+#include "rcb_row_stream.hxx"
+#include "rcb_symbols.hxx"
 #include "rcb_utils.hxx"
 
 namespace couchbase::ruby
@@ -50,7 +57,7 @@ void
 cb_extract_search_index(VALUE index, const core::management::search::index& idx)
 {
   rb_hash_aset(index, rb_id2sym(rb_intern("uuid")), cb_str_new(idx.uuid));
-  rb_hash_aset(index, rb_id2sym(rb_intern("name")), cb_str_new(idx.name));
+  rb_hash_aset(index, cb_symbols.name, cb_str_new(idx.name));
   rb_hash_aset(index, rb_id2sym(rb_intern("type")), cb_str_new(idx.type));
   if (!idx.params_json.empty()) {
     rb_hash_aset(index, rb_id2sym(rb_intern("params")), cb_str_new(idx.params_json));
@@ -104,7 +111,7 @@ cb_Backend_search_index_get_all(VALUE self,
       cb_throw_error(resp.ctx, "unable to get list of the search indexes");
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     rb_hash_aset(res, rb_id2sym(rb_intern("impl_version")), cb_str_new(resp.impl_version));
     VALUE indexes = rb_ary_new_capa(static_cast<long>(resp.indexes.size()));
     for (const auto& idx : resp.indexes) {
@@ -200,7 +207,7 @@ cb_Backend_search_index_upsert(VALUE self,
     }
     cb_extract_timeout(req, timeout);
 
-    VALUE index_name = rb_hash_aref(index_definition, rb_id2sym(rb_intern("name")));
+    VALUE index_name = rb_hash_aref(index_definition, cb_symbols.name);
     cb_check_type(index_name, T_STRING);
     req.index.name = cb_string_new(index_name);
 
@@ -268,7 +275,7 @@ cb_Backend_search_index_upsert(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -322,7 +329,7 @@ cb_Backend_search_index_drop(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -381,7 +388,7 @@ cb_Backend_search_index_get_documents_count(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     rb_hash_aset(res, rb_id2sym(rb_intern("count")), ULL2NUM(resp.count));
     return res;
   } catch (const std::system_error& se) {
@@ -511,7 +518,7 @@ cb_Backend_search_index_pause_ingest(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -568,7 +575,7 @@ cb_Backend_search_index_resume_ingest(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -625,7 +632,7 @@ cb_Backend_search_index_allow_querying(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -682,7 +689,7 @@ cb_Backend_search_index_disallow_querying(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -738,7 +745,7 @@ cb_Backend_search_index_freeze_plan(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -795,7 +802,7 @@ cb_Backend_search_index_unfreeze_plan(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -857,7 +864,7 @@ cb_Backend_search_index_analyze_document(VALUE self,
       }
     }
     VALUE res = rb_hash_new();
-    rb_hash_aset(res, rb_id2sym(rb_intern("status")), cb_str_new(resp.status));
+    rb_hash_aset(res, cb_symbols.status, cb_str_new(resp.status));
     rb_hash_aset(res, rb_id2sym(rb_intern("analysis")), cb_str_new(resp.analysis));
     return res;
   } catch (const std::system_error& se) {
@@ -884,197 +891,437 @@ cb_for_each_raw_param(VALUE key, VALUE value, VALUE arg)
   return ST_CONTINUE;
 }
 
-VALUE
-cb_Backend_document_search(VALUE self,
-                           VALUE bucket,
-                           VALUE scope,
-                           VALUE index_name,
-                           VALUE query,
-                           VALUE search_request,
-                           VALUE options,
-                           VALUE observability_handler)
+void
+cb_extract_search_request(core::operations::search_request& req,
+                          VALUE bucket,
+                          VALUE scope,
+                          VALUE index_name,
+                          VALUE query,
+                          VALUE search_request,
+                          VALUE options)
 {
-  auto cluster = cb_backend_to_core_api_cluster(self);
-
-  Check_Type(index_name, T_STRING);
-  Check_Type(query, T_STRING);
-  if (!NIL_P(options)) {
-    Check_Type(options, T_HASH);
+  if (!NIL_P(bucket)) {
+    cb_check_type(bucket, T_STRING);
+    req.bucket_name = cb_string_new(bucket);
+  }
+  if (!NIL_P(scope)) {
+    cb_check_type(scope, T_STRING);
+    req.scope_name = cb_string_new(scope);
+  }
+  if (VALUE client_context_id = rb_hash_aref(options, cb_symbols.client_context_id);
+      !NIL_P(client_context_id)) {
+    cb_check_type(client_context_id, T_STRING);
+    req.client_context_id = cb_string_new(client_context_id);
+  }
+  cb_extract_timeout(req, options);
+  req.index_name = cb_string_new(index_name);
+  req.query = cb_string_new(query);
+
+  cb_extract_option_bool(req.explain, options, "explain");
+  cb_extract_option_bool(req.disable_scoring, options, "disable_scoring");
+  cb_extract_option_bool(req.include_locations, options, "include_locations");
+  cb_extract_option_bool(req.show_request, options, "show_request");
+
+  if (VALUE vector_options = rb_hash_aref(search_request, rb_id2sym(rb_intern("vector_search")));
+      !NIL_P(vector_options)) {
+    cb_check_type(vector_options, T_HASH);
+    if (VALUE vector_queries =
+          rb_hash_aref(vector_options, rb_id2sym(rb_intern("vector_queries")));
+        !NIL_P(vector_queries)) {
+      cb_check_type(vector_queries, T_STRING);
+      req.vector_search = cb_string_new(vector_queries);
+    }
+    if (VALUE vector_query_combination =
+          rb_hash_aref(vector_options, rb_id2sym(rb_intern("vector_query_combination")));
+        !NIL_P(vector_query_combination)) {
+      cb_check_type(vector_query_combination, T_SYMBOL);
+      ID type = rb_sym2id(vector_query_combination);
+      if (type == rb_intern("and")) {
+        req.vector_query_combination = core::vector_query_combination::combination_and;
+      } else if (type == rb_intern("or")) {
+        req.vector_query_combination = core::vector_query_combination::combination_or;
+      }
+    }
   }
 
-  try {
-    core::operations::search_request req;
-    if (!NIL_P(bucket)) {
-      cb_check_type(bucket, T_STRING);
-      req.bucket_name = cb_string_new(bucket);
+  if (VALUE skip = rb_hash_aref(options, rb_id2sym(rb_intern("skip"))); !NIL_P(skip)) {
+    cb_check_type(skip, T_FIXNUM);
+    req.skip = FIX2ULONG(skip);
+  }
+  if (VALUE limit = rb_hash_aref(options, rb_id2sym(rb_intern("limit"))); !NIL_P(limit)) {
+    cb_check_type(limit, T_FIXNUM);
+    req.limit = FIX2ULONG(limit);
+  }
+  if (VALUE highlight_style = rb_hash_aref(options, rb_id2sym(rb_intern("highlight_style")));
+      !NIL_P(highlight_style)) {
+    cb_check_type(highlight_style, T_SYMBOL);
+    ID type = rb_sym2id(highlight_style);
+    if (type == rb_intern("html")) {
+      req.highlight_style = core::search_highlight_style::html;
+    } else if (type == rb_intern("ansi")) {
+      req.highlight_style = core::search_highlight_style::ansi;
     }
-    if (!NIL_P(scope)) {
-      cb_check_type(scope, T_STRING);
-      req.scope_name = cb_string_new(scope);
+  }
+
+  if (VALUE highlight_fields = rb_hash_aref(options, rb_id2sym(rb_intern("highlight_fields")));
+      !NIL_P(highlight_fields)) {
+    cb_check_type(highlight_fields, T_ARRAY);
+    auto highlight_fields_size = static_cast<std::size_t>(RARRAY_LEN(highlight_fields));
+    req.highlight_fields.reserve(highlight_fields_size);
+    for (std::size_t i = 0; i < highlight_fields_size; ++i) {
+      VALUE field = rb_ary_entry(highlight_fields, static_cast<long>(i));
+      cb_check_type(field, T_STRING);
+      req.highlight_fields.emplace_back(cb_string_new(field));
     }
-    if (VALUE client_context_id = rb_hash_aref(options, rb_id2sym(rb_intern("client_context_id")));
-        !NIL_P(client_context_id)) {
-      cb_check_type(client_context_id, T_STRING);
-      req.client_context_id = cb_string_new(client_context_id);
+  }
+
+  if (VALUE scan_consistency = rb_hash_aref(options, rb_id2sym(rb_intern("scan_consistency")));
+      !NIL_P(scan_consistency)) {
+    cb_check_type(scan_consistency, T_SYMBOL);
+    if (ID type = rb_sym2id(scan_consistency); type == rb_intern("not_bounded")) {
+      req.scan_consistency = core::search_scan_consistency::not_bounded;
     }
-    cb_extract_timeout(req, options);
-    req.index_name = cb_string_new(index_name);
-    req.query = cb_string_new(query);
-
-    cb_extract_option_bool(req.explain, options, "explain");
-    cb_extract_option_bool(req.disable_scoring, options, "disable_scoring");
-    cb_extract_option_bool(req.include_locations, options, "include_locations");
-    cb_extract_option_bool(req.show_request, options, "show_request");
-
-    if (VALUE vector_options = rb_hash_aref(search_request, rb_id2sym(rb_intern("vector_search")));
-        !NIL_P(vector_options)) {
-      cb_check_type(vector_options, T_HASH);
-      if (VALUE vector_queries =
-            rb_hash_aref(vector_options, rb_id2sym(rb_intern("vector_queries")));
-          !NIL_P(vector_queries)) {
-        cb_check_type(vector_queries, T_STRING);
-        req.vector_search = cb_string_new(vector_queries);
+  }
+
+  if (VALUE mutation_state = rb_hash_aref(options, rb_id2sym(rb_intern("mutation_state")));
+      !NIL_P(mutation_state)) {
+    cb_check_type(mutation_state, T_ARRAY);
+    auto state_size = static_cast<std::size_t>(RARRAY_LEN(mutation_state));
+    req.mutation_state.reserve(state_size);
+    for (std::size_t i = 0; i < state_size; ++i) {
+      VALUE token = rb_ary_entry(mutation_state, static_cast<long>(i));
+      cb_check_type(token, T_HASH);
+      VALUE bucket_name = rb_hash_aref(token, cb_symbols.bucket_name);
+      cb_check_type(bucket_name, T_STRING);
+      VALUE partition_id = rb_hash_aref(token, cb_symbols.partition_id);
+      cb_check_type(partition_id, T_FIXNUM);
+      VALUE partition_uuid = rb_hash_aref(token, cb_symbols.partition_uuid);
+      switch (TYPE(partition_uuid)) {
+        case T_FIXNUM:
+        case T_BIGNUM:
+          break;
+        default:
+          throw ruby_exception(rb_eArgError, "partition_uuid must be an Integer");
       }
-      if (VALUE vector_query_combination =
-            rb_hash_aref(vector_options, rb_id2sym(rb_intern("vector_query_combination")));
-          !NIL_P(vector_query_combination)) {
-        cb_check_type(vector_query_combination, T_SYMBOL);
-        ID type = rb_sym2id(vector_query_combination);
-        if (type == rb_intern("and")) {
-          req.vector_query_combination = core::vector_query_combination::combination_and;
-        } else if (type == rb_intern("or")) {
-          req.vector_query_combination = core::vector_query_combination::combination_or;
-        }
+      VALUE sequence_number = rb_hash_aref(token, cb_symbols.sequence_number);
+      switch (TYPE(sequence_number)) {
+        case T_FIXNUM:
+        case T_BIGNUM:
+          break;
+        default:
+          throw ruby_exception(rb_eArgError, "sequence_number must be an Integer");
       }
+      req.mutation_state.emplace_back(NUM2ULL(partition_uuid),
+                                      NUM2ULL(sequence_number),
+                                      gsl::narrow_cast<std::uint16_t>(NUM2UINT(partition_id)),
+                                      cb_string_new(bucket_name));
     }
+  }
 
-    if (VALUE skip = rb_hash_aref(options, rb_id2sym(rb_intern("skip"))); !NIL_P(skip)) {
-      cb_check_type(skip, T_FIXNUM);
-      req.skip = FIX2ULONG(skip);
-    }
-    if (VALUE limit = rb_hash_aref(options, rb_id2sym(rb_intern("limit"))); !NIL_P(limit)) {
-      cb_check_type(limit, T_FIXNUM);
-      req.limit = FIX2ULONG(limit);
+  if (VALUE fields = rb_hash_aref(options, cb_symbols.fields); !NIL_P(fields)) {
+    cb_check_type(fields, T_ARRAY);
+    auto fields_size = static_cast<std::size_t>(RARRAY_LEN(fields));
+    req.fields.reserve(fields_size);
+    for (std::size_t i = 0; i < fields_size; ++i) {
+      VALUE field = rb_ary_entry(fields, static_cast<long>(i));
+      cb_check_type(field, T_STRING);
+      req.fields.emplace_back(cb_string_new(field));
     }
-    if (VALUE highlight_style = rb_hash_aref(options, rb_id2sym(rb_intern("highlight_style")));
-        !NIL_P(highlight_style)) {
-      cb_check_type(highlight_style, T_SYMBOL);
-      ID type = rb_sym2id(highlight_style);
-      if (type == rb_intern("html")) {
-        req.highlight_style = core::search_highlight_style::html;
-      } else if (type == rb_intern("ansi")) {
-        req.highlight_style = core::search_highlight_style::ansi;
-      }
+  }
+
+  VALUE collections = rb_hash_aref(options, rb_id2sym(rb_intern("collections")));
+  if (!NIL_P(collections)) {
+    cb_check_type(collections, T_ARRAY);
+    auto collections_size = static_cast<std::size_t>(RARRAY_LEN(collections));
+    req.collections.reserve(collections_size);
+    for (std::size_t i = 0; i < collections_size; ++i) {
+      VALUE collection = rb_ary_entry(collections, static_cast<long>(i));
+      cb_check_type(collection, T_STRING);
+      req.collections.emplace_back(cb_string_new(collection));
     }
+  }
 
-    if (VALUE highlight_fields = rb_hash_aref(options, rb_id2sym(rb_intern("highlight_fields")));
-        !NIL_P(highlight_fields)) {
-      cb_check_type(highlight_fields, T_ARRAY);
-      auto highlight_fields_size = static_cast<std::size_t>(RARRAY_LEN(highlight_fields));
-      req.highlight_fields.reserve(highlight_fields_size);
-      for (std::size_t i = 0; i < highlight_fields_size; ++i) {
-        VALUE field = rb_ary_entry(highlight_fields, static_cast<long>(i));
-        cb_check_type(field, T_STRING);
-        req.highlight_fields.emplace_back(cb_string_new(field));
-      }
+  if (VALUE sort = rb_hash_aref(options, rb_id2sym(rb_intern("sort"))); !NIL_P(sort)) {
+    cb_check_type(sort, T_ARRAY);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(RARRAY_LEN(sort)); ++i) {
+      VALUE sort_spec = rb_ary_entry(sort, static_cast<long>(i));
+      req.sort_specs.emplace_back(cb_string_new(sort_spec));
     }
+  }
 
-    if (VALUE scan_consistency = rb_hash_aref(options, rb_id2sym(rb_intern("scan_consistency")));
-        !NIL_P(scan_consistency)) {
-      cb_check_type(scan_consistency, T_SYMBOL);
-      if (ID type = rb_sym2id(scan_consistency); type == rb_intern("not_bounded")) {
-        req.scan_consistency = core::search_scan_consistency::not_bounded;
+  if (VALUE facets = rb_hash_aref(options, rb_id2sym(rb_intern("facets"))); !NIL_P(facets)) {
+    cb_check_type(facets, T_ARRAY);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(RARRAY_LEN(facets)); ++i) {
+      VALUE facet_pair = rb_ary_entry(facets, static_cast<long>(i));
+      cb_check_type(facet_pair, T_ARRAY);
+      if (RARRAY_LEN(facet_pair) == 2) {
+        VALUE facet_name = rb_ary_entry(facet_pair, 0);
+        cb_check_type(facet_name, T_STRING);
+        VALUE facet_definition = rb_ary_entry(facet_pair, 1);
+        cb_check_type(facet_definition, T_STRING);
+        req.facets.try_emplace(cb_string_new(facet_name), cb_string_new(facet_definition));
       }
     }
+  }
+
+  if (VALUE raw_params = rb_hash_aref(options, rb_id2sym(rb_intern("raw_parameters")));
+      !NIL_P(raw_params)) {
+    cb_check_type(raw_params, T_HASH);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    rb_hash_foreach(raw_params, cb_for_each_raw_param, reinterpret_cast<VALUE>(&req));
+  }
+}
+
+void
+cb_check_search_response(const core::operations::search_response& resp,
+                         const std::string& index_name)
+{
+  if (resp.ctx.ec) {
+    cb_throw_error(
+      resp.ctx,
+      fmt::format("unable to perform search query for index \"{}\": {}", index_name, resp.error));
+  }
+}
 
-    if (VALUE mutation_state = rb_hash_aref(options, rb_id2sym(rb_intern("mutation_state")));
-        !NIL_P(mutation_state)) {
-      cb_check_type(mutation_state, T_ARRAY);
-      auto state_size = static_cast<std::size_t>(RARRAY_LEN(mutation_state));
-      req.mutation_state.reserve(state_size);
-      for (std::size_t i = 0; i < state_size; ++i) {
-        VALUE token = rb_ary_entry(mutation_state, static_cast<long>(i));
-        cb_check_type(token, T_HASH);
-        VALUE bucket_name = rb_hash_aref(token, rb_id2sym(rb_intern("bucket_name")));
-        cb_check_type(bucket_name, T_STRING);
-        VALUE partition_id = rb_hash_aref(token, rb_id2sym(rb_intern("partition_id")));
-        cb_check_type(partition_id, T_FIXNUM);
-        VALUE partition_uuid = rb_hash_aref(token, rb_id2sym(rb_intern("partition_uuid")));
-        switch (TYPE(partition_uuid)) {
-          case T_FIXNUM:
-          case T_BIGNUM:
-            break;
-          default:
-            throw ruby_exception(rb_eArgError, "partition_uuid must be an Integer");
+VALUE
+cb_create_search_meta(const core::operations::search_response& resp)
+{
+  VALUE meta_data = rb_hash_new();
+  rb_hash_aset(meta_data, cb_symbols.client_context_id, cb_str_new(resp.meta.client_context_id));
+
+  VALUE metrics = rb_hash_new();
+  rb_hash_aset(
+    metrics,
+    rb_id2sym(rb_intern("took")),
+    LL2NUM(
+      std::chrono::duration_cast<std::chrono::milliseconds>(resp.meta.metrics.took).count()));
+  rb_hash_aset(
+    metrics, rb_id2sym(rb_intern("total_rows")), ULL2NUM(resp.meta.metrics.total_rows));
+  rb_hash_aset(metrics, rb_id2sym(rb_intern("max_score")), DBL2NUM(resp.meta.metrics.max_score));
+  rb_hash_aset(metrics,
+               rb_id2sym(rb_intern("success_partition_count")),
+               ULL2NUM(resp.meta.metrics.success_partition_count));
+  rb_hash_aset(metrics,
+               rb_id2sym(rb_intern("error_partition_count")),
+               ULL2NUM(resp.meta.metrics.error_partition_count));
+  rb_hash_aset(meta_data, cb_symbols.metrics, metrics);
+
+  if (!resp.meta.errors.empty()) {
+    VALUE errors = rb_hash_new();
+    for (const auto& [code, message] : resp.meta.errors) {
+      rb_hash_aset(errors, cb_str_new(code), cb_str_new(message));
+    }
+    rb_hash_aset(meta_data, cb_symbols.errors, errors);
+  }
+  return meta_data;
+}
+
+VALUE
+cb_create_search_facets(const core::operations::search_response& resp)
+{
+  VALUE result_facets = rb_hash_new();
+  for (const auto& entry : resp.facets) {
+    VALUE facet = rb_hash_new();
+    VALUE facet_name = cb_str_new(entry.name);
+    rb_hash_aset(facet, cb_symbols.name, facet_name);
+    rb_hash_aset(facet, rb_id2sym(rb_intern("field")), cb_str_new(entry.field));
+    rb_hash_aset(facet, rb_id2sym(rb_intern("total")), ULL2NUM(entry.total));
+    rb_hash_aset(facet, rb_id2sym(rb_intern("missing")), ULL2NUM(entry.missing));
+    rb_hash_aset(facet, rb_id2sym(rb_intern("other")), ULL2NUM(entry.other));
+    if (!entry.terms.empty()) {
+      VALUE terms = rb_ary_new_capa(static_cast<long>(entry.terms.size()));
+      for (const auto& item : entry.terms) {
+        VALUE term = rb_hash_new();
+        rb_hash_aset(term, rb_id2sym(rb_intern("term")), cb_str_new(item.term));
+        rb_hash_aset(term, rb_id2sym(rb_intern("count")), ULL2NUM(item.count));
+        rb_ary_push(terms, term);
+      }
+      rb_hash_aset(facet, rb_id2sym(rb_intern("terms")), terms);
+    } else if (!entry.date_ranges.empty()) {
+      VALUE date_ranges = rb_ary_new_capa(static_cast<long>(entry.date_ranges.size()));
+      for (const auto& item : entry.date_ranges) {
+        VALUE date_range = rb_hash_new();
+        rb_hash_aset(date_range, cb_symbols.name, cb_str_new(item.name));
+        rb_hash_aset(date_range, rb_id2sym(rb_intern("count")), ULL2NUM(item.count));
+        if (item.start) {
+          rb_hash_aset(
+            date_range, rb_id2sym(rb_intern("start_time")), cb_str_new(item.start.value()));
         }
-        VALUE sequence_number = rb_hash_aref(token, rb_id2sym(rb_intern("sequence_number")));
-        switch (TYPE(sequence_number)) {
-          case T_FIXNUM:
-          case T_BIGNUM:
-            break;
-          default:
-            throw ruby_exception(rb_eArgError, "sequence_number must be an Integer");
+        if (item.end) {
+          rb_hash_aset(
+            date_range, rb_id2sym(rb_intern("end_time")), cb_str_new(item.end.value()));
         }
-        req.mutation_state.emplace_back(NUM2ULL(partition_uuid),
-                                        NUM2ULL(sequence_number),
-                                        gsl::narrow_cast<std::uint16_t>(NUM2UINT(partition_id)),
-                                        cb_string_new(bucket_name));
+        rb_ary_push(date_ranges, date_range);
       }
-    }
-
-    if (VALUE fields = rb_hash_aref(options, rb_id2sym(rb_intern("fields"))); !NIL_P(fields)) {
-      cb_check_type(fields, T_ARRAY);
-      auto fields_size = static_cast<std::size_t>(RARRAY_LEN(fields));
-      req.fields.reserve(fields_size);
-      for (std::size_t i = 0; i < fields_size; ++i) {
-        VALUE field = rb_ary_entry(fields, static_cast<long>(i));
-        cb_check_type(field, T_STRING);
-        req.fields.emplace_back(cb_string_new(field));
+      rb_hash_aset(facet, rb_id2sym(rb_intern("date_ranges")), date_ranges);
+    } else if (!entry.numeric_ranges.empty()) {
+      VALUE numeric_ranges = rb_ary_new_capa(static_cast<long>(entry.numeric_ranges.size()));
+      for (const auto& item : entry.numeric_ranges) {
+        VALUE numeric_range = rb_hash_new();
+        rb_hash_aset(numeric_range, cb_symbols.name, cb_str_new(item.name));
+        rb_hash_aset(numeric_range, rb_id2sym(rb_intern("count")), ULL2NUM(item.count));
+        if (std::holds_alternative<double>(item.min)) {
+          rb_hash_aset(
+            numeric_range, rb_id2sym(rb_intern("min")), DBL2NUM(std::get<double>(item.min)));
+        } else if (std::holds_alternative<std::uint64_t>(item.min)) {
+          rb_hash_aset(numeric_range,
+                       rb_id2sym(rb_intern("min")),
+                       ULL2NUM(std::get<std::uint64_t>(item.min)));
+        }
+        if (std::holds_alternative<double>(item.max)) {
+          rb_hash_aset(
+            numeric_range, rb_id2sym(rb_intern("max")), DBL2NUM(std::get<double>(item.max)));
+        } else if (std::holds_alternative<std::uint64_t>(item.max)) {
+          rb_hash_aset(numeric_range,
+                       rb_id2sym(rb_intern("max")),
+                       ULL2NUM(std::get<std::uint64_t>(item.max)));
+        }
+        rb_ary_push(numeric_ranges, numeric_range);
       }
+      rb_hash_aset(facet, rb_id2sym(rb_intern("numeric_ranges")), numeric_ranges);
     }
+    rb_hash_aset(result_facets, facet_name, facet);
+  }
+  return result_facets;
+}
 
-    VALUE collections = rb_hash_aref(options, rb_id2sym(rb_intern("collections")));
-    if (!NIL_P(collections)) {
-      cb_check_type(collections, T_ARRAY);
-      auto collections_size = static_cast<std::size_t>(RARRAY_LEN(collections));
-      req.collections.reserve(collections_size);
-      for (std::size_t i = 0; i < collections_size; ++i) {
-        VALUE collection = rb_ary_entry(collections, static_cast<long>(i));
-        cb_check_type(collection, T_STRING);
-        req.collections.emplace_back(cb_string_new(collection));
+/**
+ * Locations, fragments, fields and explanation of the hit are passed to Ruby as JSON text, and
+ * only turn into Ruby objects when the application asks for them (see SearchRow). Locations use
+ * the same layout as in the response of the search service.
+ */
+VALUE
+cb_create_search_row(const core::operations::search_response::search_row& entry)
+{
+  VALUE row = rb_hash_new();
+  rb_hash_aset(row, cb_symbols.index, cb_str_new(entry.index));
+  rb_hash_aset(row, cb_symbols.id, cb_str_new(entry.id));
+  rb_hash_aset(row, rb_id2sym(rb_intern("score")), DBL2NUM(entry.score));
+  if (!entry.locations.empty()) {
+    tao::json::value locations = tao::json::empty_object;
+    for (const auto& loc : entry.locations) {
+      tao::json::value location{
+        { "pos", loc.position },
+        { "start", loc.start_offset },
+        { "end", loc.end_offset },
+      };
+      if (loc.array_positions) {
+        tao::json::value array_positions = tao::json::empty_array;
+        for (const auto& pos : *loc.array_positions) {
+          array_positions.emplace_back(pos);
+        }
+        location.get_object().try_emplace("array_positions", std::move(array_positions));
       }
-    }
-
-    if (VALUE sort = rb_hash_aref(options, rb_id2sym(rb_intern("sort"))); !NIL_P(sort)) {
-      cb_check_type(sort, T_ARRAY);
-      for (std::size_t i = 0; i < static_cast<std::size_t>(RARRAY_LEN(sort)); ++i) {
-        VALUE sort_spec = rb_ary_entry(sort, static_cast<long>(i));
-        req.sort_specs.emplace_back(cb_string_new(sort_spec));
+      auto& terms =
+        locations.get_object().try_emplace(loc.field, tao::json::empty_object).first->second;
+      auto& term_locations =
+        terms.get_object().try_emplace(loc.term, tao::json::empty_array).first->second;
+      term_locations.emplace_back(std::move(location));
+    }
+    rb_hash_aset(row,
+                 rb_id2sym(rb_intern("locations")),
+                 cb_str_new(core::utils::json::generate(locations)));
+  }
+  if (!entry.fragments.empty()) {
+    tao::json::value fragments = tao::json::empty_object;
+    for (const auto& [field, field_fragments] : entry.fragments) {
+      tao::json::value fragments_list = tao::json::empty_array;
+      for (const auto& fragment : field_fragments) {
+        fragments_list.emplace_back(fragment);
       }
+      fragments.get_object().try_emplace(field, std::move(fragments_list));
     }
+    rb_hash_aset(row,
+                 rb_id2sym(rb_intern("fragments")),
+                 cb_str_new(core::utils::json::generate(fragments)));
+  }
+  if (!entry.fields.empty()) {
+    rb_hash_aset(row, cb_symbols.fields, cb_str_new(entry.fields));
+  }
+  if (!entry.explanation.empty()) {
+    rb_hash_aset(row, rb_id2sym(rb_intern("explanation")), cb_str_new(entry.explanation));
+  }
+  return row;
+}
 
-    if (VALUE facets = rb_hash_aref(options, rb_id2sym(rb_intern("facets"))); !NIL_P(facets)) {
-      cb_check_type(facets, T_ARRAY);
-      for (std::size_t i = 0; i < static_cast<std::size_t>(RARRAY_LEN(facets)); ++i) {
-        VALUE facet_pair = rb_ary_entry(facets, static_cast<long>(i));
-        cb_check_type(facet_pair, T_ARRAY);
-        if (RARRAY_LEN(facet_pair) == 2) {
-          VALUE facet_name = rb_ary_entry(facet_pair, 0);
-          cb_check_type(facet_name, T_STRING);
-          VALUE facet_definition = rb_ary_entry(facet_pair, 1);
-          cb_check_type(facet_definition, T_STRING);
-          req.facets.try_emplace(cb_string_new(facet_name), cb_string_new(facet_definition));
-        }
-      }
-    }
+/**
+ * The same as above, but for the raw hit delivered by the streaming search.
+ */
+VALUE
+cb_create_search_row(const tao::json::value& hit)
+{
+  VALUE row = rb_hash_new();
+  if (const auto* index = hit.find("index"); index != nullptr && index->is_string()) {
+    rb_hash_aset(row, cb_symbols.index, cb_str_new(index->get_string()));
+  }
+  if (const auto* id = hit.find("id"); id != nullptr && id->is_string()) {
+    rb_hash_aset(row, cb_symbols.id, cb_str_new(id->get_string()));
+  }
+  if (const auto* score = hit.find("score"); score != nullptr && score->is_number()) {
+    rb_hash_aset(row, rb_id2sym(rb_intern("score")), DBL2NUM(score->as<double>()));
+  }
+  if (const auto* locations = hit.find("locations");
+      locations != nullptr && locations->is_object() && !locations->get_object().empty()) {
+    rb_hash_aset(row,
+                 rb_id2sym(rb_intern("locations")),
+                 cb_str_new(core::utils::json::generate(*locations)));
+  }
+  if (const auto* fragments = hit.find("fragments");
+      fragments != nullptr && fragments->is_object() && !fragments->get_object().empty()) {
+    rb_hash_aset(row,
+                 rb_id2sym(rb_intern("fragments")),
+                 cb_str_new(core::utils::json::generate(*fragments)));
+  }
+  if (const auto* fields = hit.find("fields"); fields != nullptr && fields->is_object()) {
+    rb_hash_aset(row, cb_symbols.fields, cb_str_new(core::utils::json::generate(*fields)));
+  }
+  if (const auto* explanation = hit.find("explanation");
+      explanation != nullptr && explanation->is_object()) {
+    rb_hash_aset(row,
+                 rb_id2sym(rb_intern("explanation")),
+                 cb_str_new(core::utils::json::generate(*explanation)));
+  }
+  return row;
+}
 
-    if (VALUE raw_params = rb_hash_aref(options, rb_id2sym(rb_intern("raw_parameters")));
-        !NIL_P(raw_params)) {
-      cb_check_type(raw_params, T_HASH);
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      rb_hash_foreach(raw_params, cb_for_each_raw_param, reinterpret_cast<VALUE>(&req));
-    }
+VALUE
+cb_Backend_search_row_parse(VALUE self, VALUE hit)
+{
+  (void)self;
+  Check_Type(hit, T_STRING);
 
+  tao::json::value entry;
+  try {
+    entry = core::utils::json::parse(RSTRING_PTR(hit), static_cast<std::size_t>(RSTRING_LEN(hit)));
+  } catch (const std::exception& e) {
+    rb_exc_raise(cb_map_error_code(couchbase::errc::common::decoding_failure,
+                                   fmt::format("unable to parse search hit: {}", e.what()),
+                                   false));
+  }
+  return cb_create_search_row(entry);
+}
+
+VALUE
+cb_Backend_document_search(VALUE self,
+                           VALUE bucket,
+                           VALUE scope,
+                           VALUE index_name,
+                           VALUE query,
+                           VALUE search_request,
+                           VALUE options,
+                           VALUE observability_handler)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(index_name, T_STRING);
+  Check_Type(query, T_STRING);
+  if (!NIL_P(options)) {
+    Check_Type(options, T_HASH);
+  }
+
+  try {
+    core::operations::search_request req;
+    cb_extract_search_request(req, bucket, scope, index_name, query, search_request, options);
     auto parent_span = cb_create_parent_span(req, self);
 
     std::promise<core::operations::search_response> promise;
@@ -1084,158 +1331,18 @@ cb_Backend_document_search(VALUE self,
     });
     auto resp = cb_wait_for_future(f);
     cb_add_core_spans(observability_handler, std::move(parent_span), resp.ctx.retry_attempts);
-    if (resp.ctx.ec) {
-      cb_throw_error(resp.ctx,
-                     fmt::format("unable to perform search query for index \"{}\": {}",
-                                 req.index_name,
-                                 resp.error));
-    }
-    VALUE res = rb_hash_new();
-
-    VALUE meta_data = rb_hash_new();
-    rb_hash_aset(meta_data,
-                 rb_id2sym(rb_intern("client_context_id")),
-                 cb_str_new(resp.meta.client_context_id));
-
-    VALUE metrics = rb_hash_new();
-    rb_hash_aset(
-      metrics,
-      rb_id2sym(rb_intern("took")),
-      LL2NUM(
-        std::chrono::duration_cast<std::chrono::milliseconds>(resp.meta.metrics.took).count()));
-    rb_hash_aset(
-      metrics, rb_id2sym(rb_intern("total_rows")), ULL2NUM(resp.meta.metrics.total_rows));
-    rb_hash_aset(metrics, rb_id2sym(rb_intern("max_score")), DBL2NUM(resp.meta.metrics.max_score));
-    rb_hash_aset(metrics,
-                 rb_id2sym(rb_intern("success_partition_count")),
-                 ULL2NUM(resp.meta.metrics.success_partition_count));
-    rb_hash_aset(metrics,
-                 rb_id2sym(rb_intern("error_partition_count")),
-                 ULL2NUM(resp.meta.metrics.error_partition_count));
-    rb_hash_aset(meta_data, rb_id2sym(rb_intern("metrics")), metrics);
-
-    if (!resp.meta.errors.empty()) {
-      VALUE errors = rb_hash_new();
-      for (const auto& [code, message] : resp.meta.errors) {
-        rb_hash_aset(errors, cb_str_new(code), cb_str_new(message));
-      }
-      rb_hash_aset(meta_data, rb_id2sym(rb_intern("errors")), errors);
-    }
-
-    rb_hash_aset(res, rb_id2sym(rb_intern("meta_data")), meta_data);
+    cb_check_search_response(resp, req.index_name);
 
+    VALUE res = rb_hash_new();
+    rb_hash_aset(res, rb_id2sym(rb_intern("meta_data")), cb_create_search_meta(resp));
     VALUE rows = rb_ary_new_capa(static_cast<long>(resp.rows.size()));
     for (const auto& entry : resp.rows) {
-      VALUE row = rb_hash_new();
-      rb_hash_aset(row, rb_id2sym(rb_intern("index")), cb_str_new(entry.index));
-      rb_hash_aset(row, rb_id2sym(rb_intern("id")), cb_str_new(entry.id));
-      rb_hash_aset(row, rb_id2sym(rb_intern("score")), DBL2NUM(entry.score));
-      VALUE locations = rb_ary_new_capa(static_cast<long>(entry.locations.size()));
-      for (const auto& loc : entry.locations) {
-        VALUE location = rb_hash_new();
-        rb_hash_aset(location, rb_id2sym(rb_intern("field")), cb_str_new(loc.field));
-        rb_hash_aset(location, rb_id2sym(rb_intern("term")), cb_str_new(loc.term));
-        rb_hash_aset(location, rb_id2sym(rb_intern("pos")), ULL2NUM(loc.position));
-        rb_hash_aset(location, rb_id2sym(rb_intern("start_offset")), ULL2NUM(loc.start_offset));
-        rb_hash_aset(location, rb_id2sym(rb_intern("end_offset")), ULL2NUM(loc.end_offset));
-        if (loc.array_positions) {
-          VALUE ap = rb_ary_new_capa(static_cast<long>(loc.array_positions->size()));
-          for (const auto& pos : *loc.array_positions) {
-            rb_ary_push(ap, ULL2NUM(pos));
-          }
-          rb_hash_aset(location, rb_id2sym(rb_intern("array_positions")), ap);
-        }
-        rb_ary_push(locations, location);
-      }
-      rb_hash_aset(row, rb_id2sym(rb_intern("locations")), locations);
-      if (!entry.fragments.empty()) {
-        VALUE fragments = rb_hash_new();
-        for (const auto& [field, field_fragments] : entry.fragments) {
-          VALUE fragments_list = rb_ary_new_capa(static_cast<long>(field_fragments.size()));
-          for (const auto& fragment : field_fragments) {
-            rb_ary_push(fragments_list, cb_str_new(fragment));
-          }
-          rb_hash_aset(fragments, cb_str_new(field), fragments_list);
-        }
-        rb_hash_aset(row, rb_id2sym(rb_intern("fragments")), fragments);
-      }
-      if (!entry.fields.empty()) {
-        rb_hash_aset(row, rb_id2sym(rb_intern("fields")), cb_str_new(entry.fields));
-      }
-      if (!entry.explanation.empty()) {
-        rb_hash_aset(row, rb_id2sym(rb_intern("explanation")), cb_str_new(entry.explanation));
-      }
-      rb_ary_push(rows, row);
+      rb_ary_push(rows, cb_create_search_row(entry));
     }
-    rb_hash_aset(res, rb_id2sym(rb_intern("rows")), rows);
-
+    rb_hash_aset(res, cb_symbols.rows, rows);
     if (!resp.facets.empty()) {
-      VALUE result_facets = rb_hash_new();
-      for (const auto& entry : resp.facets) {
-        VALUE facet = rb_hash_new();
-        VALUE facet_name = cb_str_new(entry.name);
-        rb_hash_aset(facet, rb_id2sym(rb_intern("name")), facet_name);
-        rb_hash_aset(facet, rb_id2sym(rb_intern("field")), cb_str_new(entry.field));
-        rb_hash_aset(facet, rb_id2sym(rb_intern("total")), ULL2NUM(entry.total));
-        rb_hash_aset(facet, rb_id2sym(rb_intern("missing")), ULL2NUM(entry.missing));
-        rb_hash_aset(facet, rb_id2sym(rb_intern("other")), ULL2NUM(entry.other));
-        if (!entry.terms.empty()) {
-          VALUE terms = rb_ary_new_capa(static_cast<long>(entry.terms.size()));
-          for (const auto& item : entry.terms) {
-            VALUE term = rb_hash_new();
-            rb_hash_aset(term, rb_id2sym(rb_intern("term")), cb_str_new(item.term));
-            rb_hash_aset(term, rb_id2sym(rb_intern("count")), ULL2NUM(item.count));
-            rb_ary_push(terms, term);
-          }
-          rb_hash_aset(facet, rb_id2sym(rb_intern("terms")), terms);
-        } else if (!entry.date_ranges.empty()) {
-          VALUE date_ranges = rb_ary_new_capa(static_cast<long>(entry.date_ranges.size()));
-          for (const auto& item : entry.date_ranges) {
-            VALUE date_range = rb_hash_new();
-            rb_hash_aset(date_range, rb_id2sym(rb_intern("name")), cb_str_new(item.name));
-            rb_hash_aset(date_range, rb_id2sym(rb_intern("count")), ULL2NUM(item.count));
-            if (item.start) {
-              rb_hash_aset(
-                date_range, rb_id2sym(rb_intern("start_time")), cb_str_new(item.start.value()));
-            }
-            if (item.end) {
-              rb_hash_aset(
-                date_range, rb_id2sym(rb_intern("end_time")), cb_str_new(item.end.value()));
-            }
-            rb_ary_push(date_ranges, date_range);
-          }
-          rb_hash_aset(facet, rb_id2sym(rb_intern("date_ranges")), date_ranges);
-        } else if (!entry.numeric_ranges.empty()) {
-          VALUE numeric_ranges = rb_ary_new_capa(static_cast<long>(entry.numeric_ranges.size()));
-          for (const auto& item : entry.numeric_ranges) {
-            VALUE numeric_range = rb_hash_new();
-            rb_hash_aset(numeric_range, rb_id2sym(rb_intern("name")), cb_str_new(item.name));
-            rb_hash_aset(numeric_range, rb_id2sym(rb_intern("count")), ULL2NUM(item.count));
-            if (std::holds_alternative<double>(item.min)) {
-              rb_hash_aset(
-                numeric_range, rb_id2sym(rb_intern("min")), DBL2NUM(std::get<double>(item.min)));
-            } else if (std::holds_alternative<std::uint64_t>(item.min)) {
-              rb_hash_aset(numeric_range,
-                           rb_id2sym(rb_intern("min")),
-                           ULL2NUM(std::get<std::uint64_t>(item.min)));
-            }
-            if (std::holds_alternative<double>(item.max)) {
-              rb_hash_aset(
-                numeric_range, rb_id2sym(rb_intern("max")), DBL2NUM(std::get<double>(item.max)));
-            } else if (std::holds_alternative<std::uint64_t>(item.max)) {
-              rb_hash_aset(numeric_range,
-                           rb_id2sym(rb_intern("max")),
-                           ULL2NUM(std::get<std::uint64_t>(item.max)));
-            }
-            rb_ary_push(numeric_ranges, numeric_range);
-          }
-          rb_hash_aset(facet, rb_id2sym(rb_intern("numeric_ranges")), numeric_ranges);
-        }
-        rb_hash_aset(result_facets, facet_name, facet);
-      }
-      rb_hash_aset(res, rb_id2sym(rb_intern("facets")), result_facets);
+      rb_hash_aset(res, rb_id2sym(rb_intern("facets")), cb_create_search_facets(resp));
     }
-
     return res;
   } catch (const std::system_error& se) {
     rb_exc_raise(cb_map_error_code(
@@ -1246,12 +1353,72 @@ cb_Backend_document_search(VALUE self,
   return Qnil;
 }
 
+/**
+ * Starts the search and returns Backend::RowStream, which delivers raw hits as they are received
+ * (see Backend.search_row_parse). Metadata and facets (or error) are available once all hits have
+ * been consumed.
+ */
+VALUE
+cb_Backend_document_search_stream(VALUE self,
+                                  VALUE bucket,
+                                  VALUE scope,
+                                  VALUE index_name,
+                                  VALUE query,
+                                  VALUE search_request,
+                                  VALUE options,
+                                  VALUE observability_handler)
+{
+  auto cluster = cb_backend_to_core_api_cluster(self);
+
+  Check_Type(index_name, T_STRING);
+  Check_Type(query, T_STRING);
+  Check_Type(options, T_HASH);
+
+  try {
+    core::operations::search_request req;
+    cb_extract_search_request(req, bucket, scope, index_name, query, search_request, options);
+    auto parent_span = cb_create_parent_span(req, self);
+
+    auto stream = cb_backend_make_row_stream(self);
+    req.row_callback = [stream](std::string row) {
+      return stream->push(std::move(row)) ? core::utils::json::stream_control::next_row
+                                          : core::utils::json::stream_control::stop;
+    };
+    cluster.execute(
+      req,
+      [stream, parent_span, observability_handler, index_name = req.index_name](auto&& resp) {
+        stream->finish([resp = std::forward<decltype(resp)>(resp),
+                        parent_span,
+                        observability_handler,
+                        index_name]() -> VALUE {
+          cb_add_core_spans(observability_handler, parent_span, resp.ctx.retry_attempts);
+          cb_check_search_response(resp, index_name);
+          VALUE res = rb_hash_new();
+          rb_hash_aset(res, rb_id2sym(rb_intern("meta_data")), cb_create_search_meta(resp));
+          if (!resp.facets.empty()) {
+            rb_hash_aset(res, rb_id2sym(rb_intern("facets")), cb_create_search_facets(resp));
+          }
+          return res;
+        });
+      });
+    return cb_row_stream_new(stream);
+  } catch (const std::system_error& se) {
+    rb_exc_raise(cb_map_error_code(
+      se.code(), fmt::format("failed to perform {}: {}", __func__, se.what()), false));
+  } catch (const ruby_exception& e) {
+    rb_exc_raise(e.exception_object());
+  }
+  return Qnil;
+}
+
 } // namespace
 
 void
 init_search(VALUE cBackend)
 {
   rb_define_method(cBackend, "document_search", cb_Backend_document_search, 7);
+  rb_define_method(cBackend, "document_search_stream", cb_Backend_document_search_stream, 8);
+  rb_define_singleton_method(cBackend, "search_row_parse", cb_Backend_search_row_parse, 1);
 
   rb_define_method(cBackend, "search_get_stats", cb_Backend_search_get_stats, 2);
   rb_define_method(cBackend, "search_index_get_all", cb_Backend_search_index_get_all, 4);
@@ -0,0 +1,35 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "rcb_symbols.hxx"
+
+#include <ruby.h>
+
+namespace couchbase::ruby
+{
+cb_symbol_table cb_symbols{};
+
+void
+init_symbols()
+{
+#define CB_INTERN_SYMBOL(name)                                                                     \
+  cb_symbols.name = rb_id2sym(rb_intern(#name));                                                   \
+  rb_gc_register_mark_object(cb_symbols.name);
+  CB_FOR_EACH_RESULT_SYMBOL(CB_INTERN_SYMBOL)
+#undef CB_INTERN_SYMBOL
+}
+} // namespace couchbase::ruby
@@ -0,0 +1,92 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef COUCHBASE_RUBY_RCB_SYMBOLS_HXX
+#define COUCHBASE_RUBY_RCB_SYMBOLS_HXX
+
+#include <ruby/internal/value.h>
+
+namespace couchbase::ruby
+{
+/*
+ * Keys of the hashes built by the result builders. Interning them on every response costs a
+ * symbol table lookup per key, so they are resolved once in init_symbols() and shared by all
+ * builders.
+ */
+#define CB_FOR_EACH_RESULT_SYMBOL(X)                                                               \
+  X(attributes)                                                                                    \
+  X(bucket_name)                                                                                   \
+  X(cas)                                                                                           \
+  X(children)                                                                                      \
+  X(client_context_id)                                                                             \
+  X(code)                                                                                          \
+  X(content)                                                                                       \
+  X(datatype)                                                                                      \
+  X(decoded)                                                                                       \
+  X(decoded_content)                                                                               \
+  X(decoded_value)                                                                                 \
+  X(deleted)                                                                                       \
+  X(elapsed_time)                                                                                  \
+  X(encoded)                                                                                       \
+  X(end_timestamp)                                                                                 \
+  X(error)                                                                                         \
+  X(error_count)                                                                                   \
+  X(errors)                                                                                        \
+  X(execution_time)                                                                                \
+  X(exists)                                                                                        \
+  X(expiry)                                                                                        \
+  X(fields)                                                                                        \
+  X(flags)                                                                                         \
+  X(id)                                                                                            \
+  X(id_only)                                                                                       \
+  X(index)                                                                                         \
+  X(message)                                                                                       \
+  X(meta)                                                                                          \
+  X(metrics)                                                                                       \
+  X(mutation_count)                                                                                \
+  X(mutation_token)                                                                                \
+  X(name)                                                                                          \
+  X(partition_id)                                                                                  \
+  X(partition_uuid)                                                                                \
+  X(path)                                                                                          \
+  X(profile)                                                                                       \
+  X(replica)                                                                                       \
+  X(request_id)                                                                                    \
+  X(result_count)                                                                                  \
+  X(result_size)                                                                                   \
+  X(rows)                                                                                          \
+  X(sequence_number)                                                                               \
+  X(signature)                                                                                     \
+  X(sort_count)                                                                                    \
+  X(start_timestamp)                                                                               \
+  X(status)                                                                                        \
+  X(value)                                                                                         \
+  X(warning_count)                                                                                 \
+  X(warnings)
+
+struct cb_symbol_table {
+#define CB_DECLARE_SYMBOL(name) VALUE name{};
+  CB_FOR_EACH_RESULT_SYMBOL(CB_DECLARE_SYMBOL)
+#undef CB_DECLARE_SYMBOL
+};
+
+extern cb_symbol_table cb_symbols;
+
+void
+init_symbols();
+} // namespace couchbase::ruby
+#endif // COUCHBASE_RUBY_RCB_SYMBOLS_HXX
@@ -22,8 +22,19 @@
 #include "rcb_exceptions.hxx"
 #include "rcb_utils.hxx"
 
+#include <array>
+#include <cerrno>
 #include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <ruby.h>
+#include <ruby/encoding.h>
+#include <ruby/fiber/scheduler.h>
+#include <ruby/io.h>
 
 namespace couchbase::ruby
 {
@@ -148,8 +159,147 @@ extract_legacy_durability_persist_to(VALUE options)
   return couchbase::persist_to::none;
 }
 
+#ifndef _WIN32
+struct fiber_wait_args {
+  VALUE scheduler;
+  int fd;
+  const std::function<bool()>* ready;
+};
+
+VALUE
+cb_fiber_wait_readable(VALUE arg)
+{
+  // NOLINTNEXTLINE(performance-no-int-to-ptr)
+  const auto* args = reinterpret_cast<const fiber_wait_args*>(arg);
+  VALUE io = rb_io_fdopen(args->fd, O_RDONLY, nullptr);
+  // the descriptor is owned by cb_fiber_signal
+  rb_funcall(io, rb_intern("autoclose="), 1, Qfalse);
+  while (!(*args->ready)()) {
+    rb_fiber_scheduler_io_wait(args->scheduler, io, RB_INT2NUM(RUBY_IO_READABLE), Qnil);
+  }
+  return Qnil;
+}
+#endif
+
+/*
+ * Smaller bodies are copied, as the String either embeds them or the copy is negligible
+ * comparing to bookkeeping of the owner object.
+ */
+constexpr std::size_t cb_adopted_buffer_threshold{ 16 * 1024 };
+
+struct cb_adopted_buffer_data {
+  std::vector<std::byte> buffer{};
+};
+
+void
+cb_AdoptedBuffer_free(void* ptr)
+{
+  auto* data = static_cast<cb_adopted_buffer_data*>(ptr);
+  rb_gc_adjust_memory_usage(-static_cast<ssize_t>(data->buffer.capacity()));
+  data->~cb_adopted_buffer_data();
+  ruby_xfree(data);
+}
+
+std::size_t
+cb_AdoptedBuffer_memsize(const void* ptr)
+{
+  const auto* data = static_cast<const cb_adopted_buffer_data*>(ptr);
+  return sizeof(*data) + data->buffer.capacity();
+}
+
+const rb_data_type_t cb_adopted_buffer_type{
+  "Couchbase/Backend/AdoptedBuffer",
+  {
+    nullptr,
+    cb_AdoptedBuffer_free,
+    cb_AdoptedBuffer_memsize,
+// only one reserved field when GC.compact implemented
+#ifdef T_MOVED
+    nullptr,
+#endif
+    {},
+  },
+#ifdef RUBY_TYPED_FREE_IMMEDIATELY
+  nullptr,
+  nullptr,
+  RUBY_TYPED_FREE_IMMEDIATELY,
+#endif
+};
+
 } // namespace
 
+cb_fiber_signal::cb_fiber_signal(int read_fd, int write_fd)
+  : read_fd_{ read_fd }
+  , write_fd_{ write_fd }
+{
+}
+
+cb_fiber_signal::~cb_fiber_signal()
+{
+#ifndef _WIN32
+  close(read_fd_);
+  close(write_fd_);
+#endif
+}
+
+auto
+cb_fiber_signal::for_current_fiber() -> std::shared_ptr<cb_fiber_signal>
+{
+#ifdef _WIN32
+  return nullptr;
+#else
+  if (NIL_P(rb_fiber_scheduler_current())) {
+    return nullptr;
+  }
+  std::array<int, 2> fds{};
+  if (rb_cloexec_pipe(fds.data()) != 0) {
+    throw ruby_exception(
+      rb_syserr_new(errno, "unable to create completion pipe for the fiber scheduler"));
+  }
+  rb_update_max_fd(fds[0]);
+  rb_update_max_fd(fds[1]);
+  return std::make_shared<cb_fiber_signal>(fds[0], fds[1]);
+#endif
+}
+
+void
+cb_fiber_signal::notify()
+{
+#ifndef _WIN32
+  const char byte{ 1 };
+  while (write(write_fd_, &byte, 1) < 0 && errno == EINTR) {
+    // retry
+  }
+#endif
+}
+
+auto
+cb_fiber_signal::wait(const std::function<bool()>& ready) -> bool
+{
+#ifdef _WIN32
+  return false;
+#else
+  VALUE scheduler = rb_fiber_scheduler_current();
+  if (NIL_P(scheduler)) {
+    return false;
+  }
+  fiber_wait_args args{ scheduler, read_fd_, &ready };
+  int state = 0;
+  rb_protect(cb_fiber_wait_readable, reinterpret_cast<VALUE>(&args), &state);
+  if (state != 0) {
+    // the fiber has been interrupted (e.g. task was stopped), the core will still deliver the
+    // result into the promise, but nobody is going to consume it
+    VALUE exc = rb_errinfo();
+    if (!RTEST(rb_obj_is_kind_of(exc, rb_eException))) {
+      rb_jump_tag(state);
+    }
+    rb_set_errinfo(Qnil);
+    throw ruby_exception(exc);
+  }
+  return true;
+#endif
+}
+
 /*
  * Destructor-friendly rb_check_type from error.c
  *
@@ -192,6 +342,38 @@ cb_str_new(const std::vector<std::byte>& binary)
                              static_cast<long>(binary.size()));
 }
 
+VALUE
+cb_str_new(std::vector<std::byte>&& binary)
+{
+  if (binary.size() < cb_adopted_buffer_threshold || rb_default_internal_encoding() != nullptr) {
+    // the string has to be transcoded anyway, when default internal encoding is set
+    return cb_str_new(binary);
+  }
+  // C API might rely on NUL terminator, keep it inside of the allocation
+  binary.push_back(std::byte{ 0 });
+  binary.pop_back();
+
+  static const ID owner_id = rb_intern("__couchbase_buffer_owner");
+
+  cb_adopted_buffer_data* data = nullptr;
+  VALUE owner = TypedData_Make_Struct(0, cb_adopted_buffer_data, &cb_adopted_buffer_type, data);
+  new (data) cb_adopted_buffer_data{ std::move(binary) };
+  rb_gc_adjust_memory_usage(static_cast<ssize_t>(data->buffer.capacity()));
+
+  // The String does not own the memory, so Ruby will copy it before any modification. It must stay
+  // frozen: Ruby would otherwise move the buffer into a hidden shared root that does not keep the
+  // owner alive. Strings that share the buffer refer to the frozen original instead. The raw
+  // transcoders return a mutable copy-on-write duplicate, so callers observe no difference with
+  // the smaller copied bodies.
+  VALUE str = rb_enc_str_new_static(
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    reinterpret_cast<const char*>(data->buffer.data()),
+    static_cast<long>(data->buffer.size()),
+    rb_default_external_encoding());
+  rb_ivar_set(str, owner_id, owner);
+  return rb_obj_freeze(str);
+}
+
 VALUE
 cb_str_new(const std::byte* data, std::size_t size)
 {
@@ -582,6 +764,29 @@ get_size_t(VALUE options, VALUE name)
   return {};
 }
 
+std::optional<double>
+get_double(VALUE options, VALUE name)
+{
+  if (!NIL_P(options) && TYPE(options) == T_HASH) {
+    cb_check_type(name, T_SYMBOL);
+    VALUE val = rb_hash_aref(options, name);
+    if (NIL_P(val)) {
+      return {};
+    }
+    switch (TYPE(val)) {
+      case T_FIXNUM:
+      case T_BIGNUM:
+      case T_FLOAT:
+        return NUM2DBL(val);
+      default:
+        throw ruby_exception(
+          rb_eArgError,
+          rb_sprintf("%+" PRIsVALUE " must be a Numeric, but given %+" PRIsVALUE, name, val));
+    }
+  }
+  return {};
+}
+
 std::optional<std::uint16_t>
 get_uint16_t(VALUE options, VALUE name)
 {
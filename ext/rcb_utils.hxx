@@ -27,7 +27,12 @@
 #include <couchbase/store_semantics.hxx>
 
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -37,6 +42,7 @@
 
 #include "rcb_exceptions.hxx"
 #include "rcb_logger.hxx"
+#include "rcb_symbols.hxx"
 
 namespace couchbase::ruby
 {
@@ -62,6 +68,201 @@ cb_wait_for_future(Future&& f) -> decltype(f.get())
   return std::move(arg.res);
 }
 
+/**
+ * One-shot completion signal for operations started from a non-blocking fiber.
+ *
+ * The core invokes callbacks on its IO thread, so instead of parking the whole Ruby thread
+ * without GVL, the calling fiber waits on the read end of a pipe through Fiber.scheduler, and
+ * the IO thread writes a byte into it once the result is available.
+ */
+class cb_fiber_signal
+{
+public:
+  cb_fiber_signal(int read_fd, int write_fd);
+  cb_fiber_signal(const cb_fiber_signal&) = delete;
+  cb_fiber_signal(cb_fiber_signal&&) = delete;
+  auto operator=(const cb_fiber_signal&) -> cb_fiber_signal& = delete;
+  auto operator=(cb_fiber_signal&&) -> cb_fiber_signal& = delete;
+  ~cb_fiber_signal();
+
+  /**
+   * @return signal instance, or nullptr if current fiber is blocking (no scheduler installed)
+   */
+  static auto for_current_fiber() -> std::shared_ptr<cb_fiber_signal>;
+
+  /**
+   * Might be called from any thread, does not require GVL.
+   */
+  void notify();
+
+  /**
+   * Yields current fiber to the scheduler until the signal is notified and ready() returns true.
+   * Must be called with GVL held.
+   *
+   * @return false if the scheduler is gone, and the caller have to fall back to blocking wait
+   */
+  auto wait(const std::function<bool()>& ready) -> bool;
+
+private:
+  int read_fd_;
+  int write_fd_;
+};
+
+template<typename T>
+class cb_future
+{
+public:
+  cb_future(std::future<T> future, std::shared_ptr<cb_fiber_signal> signal)
+    : future_{ std::move(future) }
+    , signal_{ std::move(signal) }
+  {
+  }
+
+  [[nodiscard]] auto signal() const -> const std::shared_ptr<cb_fiber_signal>&
+  {
+    return signal_;
+  }
+
+  [[nodiscard]] auto is_ready() const -> bool
+  {
+    return future_.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+  }
+
+  auto get() -> T
+  {
+    return future_.get();
+  }
+
+private:
+  std::future<T> future_;
+  std::shared_ptr<cb_fiber_signal> signal_;
+};
+
+/**
+ * Drop-in replacement for std::promise, which captures Fiber.scheduler of the calling fiber (if
+ * any), so that cb_wait_for_future() could yield to the scheduler instead of blocking the thread.
+ */
+template<typename T>
+class cb_promise
+{
+public:
+  cb_promise()
+    : signal_{ cb_fiber_signal::for_current_fiber() }
+  {
+  }
+
+  auto get_future() -> cb_future<T>
+  {
+    return { promise_.get_future(), signal_ };
+  }
+
+  template<typename V>
+  void set_value(V&& value)
+  {
+    promise_.set_value(std::forward<V>(value));
+    if (signal_) {
+      signal_->notify();
+    }
+  }
+
+private:
+  std::promise<T> promise_{};
+  std::shared_ptr<cb_fiber_signal> signal_;
+};
+
+template<typename T>
+inline auto
+cb_wait_for_future(cb_future<T>& f) -> T
+{
+  if (const auto& signal = f.signal(); signal && signal->wait([&f]() {
+        return f.is_ready();
+      })) {
+    flush_logger();
+    return f.get();
+  }
+  struct arg_pack {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    cb_future<T>& f;
+    T res{};
+  } arg{ f };
+  rb_thread_call_without_gvl(
+    [](void* param) -> void* {
+      auto* pack = static_cast<arg_pack*>(param);
+      pack->res = pack->f.get();
+      return nullptr;
+    },
+    &arg,
+    nullptr,
+    nullptr);
+  flush_logger();
+  return std::move(arg.res);
+}
+
+/**
+ * Synchronization point for batches of operations (like multi-operations), where IO threads of
+ * the core count down completions, and Ruby thread waits for all of them at once.
+ */
+class cb_countdown_latch
+{
+public:
+  explicit cb_countdown_latch(std::size_t count)
+    : count_{ count }
+  {
+  }
+
+  /**
+   * Might be called from any thread, does not require GVL.
+   */
+  void count_down()
+  {
+    const std::scoped_lock lock(mutex_);
+    if (count_ > 0) {
+      --count_;
+      done_.notify_all();
+    }
+  }
+
+  void wait()
+  {
+    wait_below(1);
+  }
+
+  /**
+   * Waits until the counter drops below the given value, and returns its current value.
+   */
+  auto wait_below(std::size_t count) -> std::size_t
+  {
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this, count]() {
+      return count_ < count;
+    });
+    return count_;
+  }
+
+private:
+  std::mutex mutex_{};
+  std::condition_variable done_{};
+  std::size_t count_;
+};
+
+/**
+ * Waits for the latch without holding GVL, so that other Ruby threads could proceed while the
+ * batch is in flight.
+ */
+inline void
+cb_wait_for_latch(cb_countdown_latch& latch)
+{
+  rb_thread_call_without_gvl(
+    [](void* param) -> void* {
+      static_cast<cb_countdown_latch*>(param)->wait();
+      return nullptr;
+    },
+    &latch,
+    nullptr,
+    nullptr);
+  flush_logger();
+}
+
 template<typename StringLike>
 inline VALUE
 cb_str_new(const StringLike str)
@@ -81,6 +282,13 @@ cb_binary_new(VALUE str);
 VALUE
 cb_str_new(const std::vector<std::byte>& binary);
 
+/**
+ * Creates frozen String that adopts the buffer instead of copying it, when the body is large
+ * enough for the copy to matter. The buffer is released together with the String.
+ */
+VALUE
+cb_str_new(std::vector<std::byte>&& binary);
+
 VALUE
 cb_str_new(const std::byte* data, std::size_t size);
 
@@ -101,6 +309,9 @@ get_milliseconds(VALUE options, VALUE name);
 std::optional<std::size_t>
 get_size_t(VALUE options, VALUE name);
 
+std::optional<double>
+get_double(VALUE options, VALUE name);
+
 std::optional<std::uint16_t>
 get_uint16_t(VALUE options, VALUE name);
 
@@ -373,15 +584,14 @@ inline VALUE
 cb_create_mutation_result(Response resp)
 {
   VALUE res = rb_hash_new();
-  rb_hash_aset(res, rb_id2sym(rb_intern("cas")), to_cas_value(resp.cas));
+  rb_hash_aset(res, cb_symbols.cas, to_cas_value(resp.cas));
 
   VALUE token = rb_hash_new();
-  rb_hash_aset(token, rb_id2sym(rb_intern("partition_uuid")), ULL2NUM(resp.token.partition_uuid()));
-  rb_hash_aset(
-    token, rb_id2sym(rb_intern("sequence_number")), ULL2NUM(resp.token.sequence_number()));
-  rb_hash_aset(token, rb_id2sym(rb_intern("partition_id")), UINT2NUM(resp.token.partition_id()));
-  rb_hash_aset(token, rb_id2sym(rb_intern("bucket_name")), cb_str_new(resp.token.bucket_name()));
-  rb_hash_aset(res, rb_id2sym(rb_intern("mutation_token")), token);
+  rb_hash_aset(token, cb_symbols.partition_uuid, ULL2NUM(resp.token.partition_uuid()));
+  rb_hash_aset(token, cb_symbols.sequence_number, ULL2NUM(resp.token.sequence_number()));
+  rb_hash_aset(token, cb_symbols.partition_id, UINT2NUM(resp.token.partition_id()));
+  rb_hash_aset(token, cb_symbols.bucket_name, cb_str_new(resp.token.bucket_name()));
+  rb_hash_aset(res, cb_symbols.mutation_token, token);
 
   return res;
 }
@@ -391,20 +601,18 @@ inline VALUE
 to_mutation_result_value(Response resp)
 {
   VALUE res = rb_hash_new();
-  rb_hash_aset(res, rb_id2sym(rb_intern("cas")), to_cas_value(resp.cas()));
+  rb_hash_aset(res, cb_symbols.cas, to_cas_value(resp.cas()));
   if (resp.mutation_token()) {
     VALUE token = rb_hash_new();
     rb_hash_aset(token,
-                 rb_id2sym(rb_intern("partition_uuid")),
+                 cb_symbols.partition_uuid,
                  ULL2NUM(resp.mutation_token()->partition_uuid()));
     rb_hash_aset(token,
-                 rb_id2sym(rb_intern("sequence_number")),
+                 cb_symbols.sequence_number,
                  ULL2NUM(resp.mutation_token()->sequence_number()));
-    rb_hash_aset(
-      token, rb_id2sym(rb_intern("partition_id")), UINT2NUM(resp.mutation_token()->partition_id()));
-    rb_hash_aset(
-      token, rb_id2sym(rb_intern("bucket_name")), cb_str_new(resp.mutation_token()->bucket_name()));
-    rb_hash_aset(res, rb_id2sym(rb_intern("mutation_token")), token);
+    rb_hash_aset(token, cb_symbols.partition_id, UINT2NUM(resp.mutation_token()->partition_id()));
+    rb_hash_aset(token, cb_symbols.bucket_name, cb_str_new(resp.mutation_token()->bucket_name()));
+    rb_hash_aset(res, cb_symbols.mutation_token, token);
   }
   return res;
 }
@@ -48,10 +48,7 @@ module Couchbase
         obs_handler.add_durability_level(options.durability_level)
         resp = @backend.document_append(@collection.bucket_name, @collection.scope_name, @collection.name,
                                         id, content, options.to_backend, obs_handler)
-        Collection::MutationResult.new do |res|
-          res.cas = resp[:cas]
-          res.mutation_token = @collection.send(:extract_mutation_token, resp)
-        end
+        @collection.extract_mutation_result(resp)
       end
     end
 
@@ -72,10 +69,7 @@ module Couchbase
         obs_handler.add_durability_level(options.durability_level)
         resp = @backend.document_prepend(@collection.bucket_name, @collection.scope_name, @collection.name,
                                          id, content, options.to_backend, obs_handler)
-        Collection::MutationResult.new do |res|
-          res.cas = resp[:cas]
-          res.mutation_token = @collection.send(:extract_mutation_token, resp)
-        end
+        @collection.extract_mutation_result(resp)
       end
     end
 
@@ -99,7 +93,38 @@ module Couchbase
         CounterResult.new do |res|
           res.cas = resp[:cas]
           res.content = resp[:content]
-          res.mutation_token = @collection.send(:extract_mutation_token, resp)
+          res.mutation_token = @collection.extract_mutation_token(resp)
+        end
+      end
+    end
+
+    # Increments multiple counter documents by the number defined in the options
+    #
+    # @note that it will not generate exceptions in this case. The caller should check {CounterResult#error} property
+    #  of the result
+    #
+    # @param [Array<String>] ids the array of document identifiers
+    # @param [Options::IncrementMulti] options custom options to customize the request
+    #
+    # @example Increment two counters by 10, and initialize them to 0 if they do not exist
+    #   res = collection.binary.increment_multi(["foo", "bar"], Options::IncrementMulti(delta: 10, initial: 0))
+    #   res[0].content #=> 0
+    #
+    # @return [Array<CounterResult>]
+    def increment_multi(ids, options = Options::IncrementMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_INCREMENT_MULTI, options.parent_span, self, :kv) do |obs_handler|
+        obs_handler.add_durability_level(options.durability_level)
+        resp = @backend.document_increment_multi(
+          ids.map { |id| [@collection.bucket_name, @collection.scope_name, @collection.name, id] }, options.to_backend
+        )
+        resp.map do |entry|
+          CounterResult.new do |res|
+            res.cas = entry[:cas]
+            res.content = entry[:content]
+            res.mutation_token = @collection.extract_mutation_token(entry)
+            res.error = entry[:error]
+            res.id = entry[:id]
+          end
         end
       end
     end
@@ -124,7 +149,38 @@ module Couchbase
         CounterResult.new do |res|
           res.cas = resp[:cas]
           res.content = resp[:content]
-          res.mutation_token = @collection.send(:extract_mutation_token, resp)
+          res.mutation_token = @collection.extract_mutation_token(resp)
+        end
+      end
+    end
+
+    # Decrements multiple counter documents by the number defined in the options
+    #
+    # @note that it will not generate exceptions in this case. The caller should check {CounterResult#error} property
+    #  of the result
+    #
+    # @param [Array<String>] ids the array of document identifiers
+    # @param [Options::DecrementMulti] options custom options to customize the request
+    #
+    # @example Decrement two counters by 2, and initialize them to 100 if they do not exist
+    #   res = collection.binary.decrement_multi(["foo", "bar"], Options::DecrementMulti(delta: 2, initial: 100))
+    #   res[0].content #=> 100
+    #
+    # @return [Array<CounterResult>]
+    def decrement_multi(ids, options = Options::DecrementMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_DECREMENT_MULTI, options.parent_span, self, :kv) do |obs_handler|
+        obs_handler.add_durability_level(options.durability_level)
+        resp = @backend.document_decrement_multi(
+          ids.map { |id| [@collection.bucket_name, @collection.scope_name, @collection.name, id] }, options.to_backend
+        )
+        resp.map do |entry|
+          CounterResult.new do |res|
+            res.cas = entry[:cas]
+            res.content = entry[:content]
+            res.mutation_token = @collection.extract_mutation_token(entry)
+            res.error = entry[:error]
+            res.id = entry[:id]
+          end
         end
       end
     end
@@ -83,17 +83,17 @@ module Couchbase
     # @return [GetResult]
     def get(id, options = Options::Get::DEFAULT)
       @observability.record_operation(Observability::OP_GET, options.parent_span, self, :kv) do |obs_handler|
-        resp = if options.need_projected_get?
-                 @backend.document_get_projected(bucket_name, @scope_name, @name, id, options.to_backend, obs_handler)
-               else
-                 @backend.document_get(bucket_name, @scope_name, @name, id, options.to_backend, obs_handler)
-               end
-        GetResult.new do |res|
-          res.transcoder = options.transcoder
-          res.cas = resp[:cas]
-          res.flags = resp[:flags]
-          res.encoded = resp[:content]
-          res.expiry = resp[:expiry] if resp.key?(:expiry)
+        if options.need_projected_get?
+          resp = @backend.document_get_projected(bucket_name, @scope_name, @name, id, options.to_backend, obs_handler)
+          GetResult.new do |res|
+            res.transcoder = options.transcoder
+            res.cas = resp[:cas]
+            res.flags = resp[:flags]
+            res.encoded = resp[:content]
+            res.expiry = resp[:expiry] if resp.key?(:expiry)
+          end
+        else
+          extract_get_result(@backend.document_get(bucket_name, @scope_name, @name, id, options.to_backend, obs_handler), options)
         end
       end
     end
@@ -111,19 +111,25 @@ module Couchbase
     #   res[0].content #=> content of "foo"
     #   res[1].content #=> content of "bar"
     #
-    # @return [Array<GetResult>]
+    # @example Handle documents as soon as they arrive
+    #   collection.get_multi(["foo", "bar"]) do |res|
+    #     puts "#{res.id}: #{res.content}" if res.success?
+    #   end
+    #
+    # @yieldparam [GetResult] result if the block given, it will be invoked for each result in order of completion
+    #
+    # @return [Array<GetResult>, nil] results in order of the IDs, or nil if the block was given
     def get_multi(ids, options = Options::GetMulti::DEFAULT)
       @observability.record_operation(Observability::OP_GET_MULTI, options.parent_span, self, :kv) do |_obs_handler|
-        resp = @backend.document_get_multi(ids.map { |id| [bucket_name, @scope_name, @name, id] }, options.to_backend)
-        resp.map do |entry|
-          GetResult.new do |res|
-            res.transcoder = options.transcoder
-            res.id = entry[:id]
-            res.cas = entry[:cas]
-            res.flags = entry[:flags]
-            res.encoded = entry[:content]
-            res.error = entry[:error]
+        keys = ids.map { |id| [bucket_name, @scope_name, @name, id] }
+        if block_given?
+          stream = @backend.document_get_multi_stream(keys, options.to_backend)
+          while (entries = stream.next_completed)
+            entries.each { |entry| yield extract_get_multi_result(entry, options) }
           end
+          nil
+        else
+          @backend.document_get_multi(keys, options.to_backend).map { |entry| extract_get_multi_result(entry, options) }
         end
       end
     end
@@ -182,6 +188,38 @@ module Couchbase
       end
     end
 
+    # Fetches multiple documents and updates their expiration time
+    #
+    # @note that it will not generate {Error::DocumentNotFound} exceptions in this case. The caller should check
+    #  {GetResult#error} property of the result
+    #
+    # @param [Array<String>] ids the array of document identifiers
+    # @param [Integer, #in_seconds, Time, nil] expiry the new expiration time for the documents
+    # @param [Options::GetAndTouchMulti] options request customization
+    #
+    # @example Retrieve documents and prolong their expiration for another 10 seconds
+    #   res = collection.get_and_touch_multi(["foo", "bar"], 10)
+    #   res[0].content #=> content of "foo"
+    #
+    # @return [Array<GetResult>]
+    def get_and_touch_multi(ids, expiry, options = Options::GetAndTouchMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_GET_AND_TOUCH_MULTI, options.parent_span, self, :kv) do |_obs_handler|
+        resp = @backend.document_get_and_touch_multi(ids.map { |id| [bucket_name, @scope_name, @name, id] },
+                                                     Utils::Time.extract_expiry_time(expiry),
+                                                     options.to_backend)
+        resp.map do |entry|
+          GetResult.new do |res|
+            res.transcoder = options.transcoder
+            res.id = entry[:id]
+            res.cas = entry[:cas]
+            res.flags = entry[:flags]
+            res.encoded = entry[:content]
+            res.error = entry[:error]
+          end
+        end
+      end
+    end
+
     # Reads from all available replicas and the active node and returns the results
     #
     # @param [String] id the document id which is used to uniquely identify it.
@@ -258,6 +296,38 @@ module Couchbase
       end
     end
 
+    # Checks if the given documents exist on the server
+    #
+    # @note that it will not generate exceptions in this case. The caller should check {ExistsResult#error} property of
+    #  the result
+    #
+    # @param [Array<String>] ids the array of document identifiers
+    # @param [Options::ExistsMulti] options request customization
+    #
+    # @example Check if two documents exist
+    #   res = collection.exists_multi(["foo", "bar"])
+    #   res[0].exists? #=> true
+    #
+    # @return [Array<ExistsResult>]
+    def exists_multi(ids, options = Options::ExistsMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_EXISTS_MULTI, options.parent_span, self, :kv) do |_obs_handler|
+        resp = @backend.document_exists_multi(ids.map { |id| [bucket_name, @scope_name, @name, id] }, options.to_backend)
+        resp.map do |entry|
+          ExistsResult.new do |res|
+            res.id = entry[:id]
+            res.error = entry[:error]
+            res.deleted = entry[:deleted]
+            res.exists = entry[:exists]
+            res.expiry = entry[:expiry]
+            res.flags = entry[:flags]
+            res.sequence_number = entry[:sequence_number]
+            res.datatype = entry[:datatype]
+            res.cas = entry[:cas]
+          end
+        end
+      end
+    end
+
     # Removes a document from the collection
     #
     # @param [String] id the document id which is used to uniquely identify it.
@@ -282,10 +352,7 @@ module Couchbase
       @observability.record_operation(Observability::OP_REMOVE, options.parent_span, self, :kv) do |obs_handler|
         obs_handler.add_durability_level(options.durability_level)
         resp = @backend.document_remove(bucket_name, @scope_name, @name, id, options.to_backend, obs_handler)
-        MutationResult.new do |res|
-          res.cas = resp[:cas]
-          res.mutation_token = extract_mutation_token(resp)
-        end
+        extract_mutation_result(resp)
       end
     end
 
@@ -294,7 +361,8 @@ module Couchbase
     # @note that it will not generate {Error::DocumentNotFound} or {Error::CasMismatch} exceptions in this case.
     #  The caller should check {MutationResult#error} property of the result
     #
-    # @param [Array<String, Array>] ids the array of document ids, or ID/CAS pairs +[String,Integer]+
+    # @param [Array<String, Array>] ids the array of document ids, or ID/CAS pairs +[String,Integer]+. The pair might
+    #   start with a {Collection}, in this case the document will be removed from that collection instead of the receiver.
     # @param [Options::RemoveMulti] options request customization
     #
     # @example Remove two documents in collection. For "mydoc" apply optimistic lock
@@ -315,7 +383,8 @@ module Couchbase
           when String
             [id, nil]
           when Array
-            id
+            keyspace, (doc_id, cas) = split_multi_entry(id)
+            [*keyspace, doc_id, cas]
           else
             raise ArgumentError, "id argument of remove_multi must be a String or Array<String, Integer>, given: #{id.inspect}"
           end
@@ -355,10 +424,34 @@ module Couchbase
         obs_handler.add_durability_level(options.durability_level)
         blob, flags = encode_content(content, options, obs_handler)
         resp = @backend.document_insert(bucket_name, @scope_name, @name, id, blob, flags, options.to_backend, obs_handler)
-        MutationResult.new do |res|
-          res.cas = resp[:cas]
-          res.mutation_token = extract_mutation_token(resp)
-        end
+        extract_mutation_result(resp)
+      end
+    end
+
+    # Inserts a list of documents which do not exist yet
+    #
+    # @note that it will not generate {Error::DocumentExists} exceptions in this case. The caller should check
+    #  {MutationResult#error} property of the result
+    #
+    # @param [Array<Array>] id_content array of tuples +String,Object+, where first entry treated as document key,
+    #   and the second as value to insert.
+    # @param [Options::InsertMulti] options request customization
+    #
+    # @example Insert two documents with IDs "foo" and "bar" into a collection
+    #   res = collection.insert_multi([
+    #     ["foo", {"foo" => 42}],
+    #     ["bar", {"bar" => "some value"}],
+    #   ])
+    #   res[0].error #=> nil
+    #   res[1].error #=> #<Couchbase::Error::DocumentExists ...> if "bar" exists already
+    #
+    # @return [Array<MutationResult>]
+    def insert_multi(id_content, options = Options::InsertMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_INSERT_MULTI, options.parent_span, self, :kv) do |obs_handler|
+        obs_handler.add_durability_level(options.durability_level)
+        encoded_id_content = encode_content_multi(id_content, options, obs_handler)
+        resp = @backend.document_insert_multi(bucket_name, @scope_name, @name, encoded_id_content, options.to_backend)
+        extract_mutation_results(resp)
       end
     end
 
@@ -378,10 +471,7 @@ module Couchbase
         obs_handler.add_durability_level(options.durability_level)
         blob, flags = encode_content(content, options, obs_handler)
         resp = @backend.document_upsert(bucket_name, @scope_name, @name, id, blob, flags, options.to_backend, obs_handler)
-        MutationResult.new do |res|
-          res.cas = resp[:cas]
-          res.mutation_token = extract_mutation_token(resp)
-        end
+        extract_mutation_result(resp)
       end
     end
 
@@ -391,7 +481,8 @@ module Couchbase
     #  result
     #
     # @param [Array<Array>] id_content array of tuples +String,Object+, where first entry treated as document key,
-    #   and the second as value to upsert.
+    #   and the second as value to upsert. The tuple might start with a {Collection}, in this case the document will be
+    #   stored in that collection instead of the receiver.
     # @param [Options::UpsertMulti] options request customization
     #
     # @example Upsert two documents with IDs "foo" and "bar" into a collection
@@ -402,6 +493,13 @@ module Couchbase
     #   res[0].cas #=> 7751414725654
     #   res[1].cas #=> 7751418925851
     #
+    # @example Store user, session and audit record in one batch
+    #   users.upsert_multi([
+    #     ["user::42", {"name" => "Arthur"}],
+    #     [sessions, "session::42", {"user" => "user::42"}],
+    #     [audit, "audit::42::login", {"event" => "login"}],
+    #   ])
+    #
     # @return [Array<MutationResult>]
     def upsert_multi(id_content, options = Options::UpsertMulti::DEFAULT)
       @observability.record_operation(Observability::OP_UPSERT, options.parent_span, self, :kv) do |obs_handler|
@@ -435,10 +533,36 @@ module Couchbase
         obs_handler.add_durability_level(options.durability_level)
         blob, flags = encode_content(content, options, obs_handler)
         resp = @backend.document_replace(bucket_name, @scope_name, @name, id, blob, flags, options.to_backend, obs_handler)
-        MutationResult.new do |res|
-          res.cas = resp[:cas]
-          res.mutation_token = extract_mutation_token(resp)
-        end
+        extract_mutation_result(resp)
+      end
+    end
+
+    # Replaces a list of documents which already exist
+    #
+    # @note that it will not generate {Error::DocumentNotFound} or {Error::CasMismatch} exceptions in this case.
+    #  The caller should check {MutationResult#error} property of the result
+    #
+    # @param [Array<Array>] id_content array of tuples +String,Object+ or +String,Object,Integer+, where the first entry
+    #   treated as document key, the second as value to replace, and optional third entry as CAS for optimistic lock.
+    # @param [Options::ReplaceMulti] options request customization
+    #
+    # @example Replace two documents, and apply optimistic lock for "foo"
+    #   res = collection.get("foo")
+    #   res = collection.replace_multi([
+    #     ["foo", {"foo" => 42}, res.cas],
+    #     ["bar", {"bar" => "some value"}],
+    #   ])
+    #   if res[0].error.is_a?(Error::CasMismatch)
+    #     puts "Failed to replace the document, it might be changed by other application"
+    #   end
+    #
+    # @return [Array<MutationResult>]
+    def replace_multi(id_content, options = Options::ReplaceMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_REPLACE_MULTI, options.parent_span, self, :kv) do |obs_handler|
+        obs_handler.add_durability_level(options.durability_level)
+        encoded_id_content = encode_content_multi(id_content, options, obs_handler, with_cas: true)
+        resp = @backend.document_replace_multi(bucket_name, @scope_name, @name, encoded_id_content, options.to_backend)
+        extract_mutation_results(resp)
       end
     end
 
@@ -463,6 +587,140 @@ module Couchbase
       end
     end
 
+    # Updates expiration time of multiple documents
+    #
+    # @note that it will not generate {Error::DocumentNotFound} exceptions in this case. The caller should check
+    #  {MutationResult#error} property of the result
+    #
+    # @param [Array<String>] ids the array of document identifiers
+    # @param [Integer, #in_seconds, Time, nil] expiry the new expiration time for the documents
+    # @param [Options::TouchMulti] options request customization
+    #
+    # @example Reset expiration timers for two documents to 30 seconds
+    #   res = collection.touch_multi(["foo", "bar"], 30)
+    #
+    # @return [Array<MutationResult>]
+    def touch_multi(ids, expiry, options = Options::TouchMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_TOUCH_MULTI, options.parent_span, self, :kv) do |_obs_handler|
+        resp = @backend.document_touch_multi(ids.map { |id| [bucket_name, @scope_name, @name, id] },
+                                             Utils::Time.extract_expiry_time(expiry),
+                                             options.to_backend)
+        resp.map do |entry|
+          MutationResult.new do |res|
+            res.cas = entry[:cas]
+            res.error = entry[:error]
+            res.id = entry[:id]
+          end
+        end
+      end
+    end
+
+    # Fetches the full document from the collection without waiting for the response
+    #
+    # Several operations might be dispatched this way to overlap network latency, the result will be decoded only when
+    # it is requested with {PendingResult#value}.
+    #
+    # @note Unlike {#get}, projections and expiry are not supported here.
+    #
+    # @param [String] id the document id which is used to uniquely identify it
+    # @param [Options::Get] options request customization
+    #
+    # @example Fetch two documents concurrently
+    #   user = collection.get_async("user:42")
+    #   cart = collection.get_async("cart:42")
+    #   render(user.value.content, cart.value.content)
+    #
+    # @return [PendingResult] that resolves into {GetResult}
+    def get_async(id, options = Options::Get::DEFAULT)
+      raise Error::InvalidArgument, "get_async does not support projections and expiry" if options.need_projected_get?
+
+      PendingResult.new(@backend.document_get_async(bucket_name, @scope_name, @name, id, options.to_backend)) do |resp|
+        extract_get_result(resp, options)
+      end
+    end
+
+    # Inserts a full document which does not exist yet without waiting for the response
+    #
+    # @param [String] id the document id which is used to uniquely identify it.
+    # @param [Object] content the document content to insert
+    # @param [Options::Insert] options request customization
+    #
+    # @return [PendingResult] that resolves into {MutationResult}
+    def insert_async(id, content, options = Options::Insert::DEFAULT)
+      blob, flags = options.transcoder ? options.transcoder.encode(content) : [content, 0]
+      PendingResult.new(
+        @backend.document_insert_async(bucket_name, @scope_name, @name, id, blob, flags, options.to_backend),
+      ) do |resp|
+        extract_mutation_result(resp)
+      end
+    end
+
+    # Upserts (inserts or updates) a full document without waiting for the response
+    #
+    # @param [String] id the document id which is used to uniquely identify it.
+    # @param [Object] content the document content to upsert
+    # @param [Options::Upsert] options request customization
+    #
+    # @example Store several documents concurrently
+    #   pending = docs.map { |id, doc| collection.upsert_async(id, doc) }
+    #   pending.map(&:value) #=> [#<MutationResult>, ...]
+    #
+    # @return [PendingResult] that resolves into {MutationResult}
+    def upsert_async(id, content, options = Options::Upsert::DEFAULT)
+      blob, flags = options.transcoder ? options.transcoder.encode(content) : [content, 0]
+      PendingResult.new(
+        @backend.document_upsert_async(bucket_name, @scope_name, @name, id, blob, flags, options.to_backend),
+      ) do |resp|
+        extract_mutation_result(resp)
+      end
+    end
+
+    # Replaces a full document which already exists without waiting for the response
+    #
+    # @param [String] id the document id which is used to uniquely identify it.
+    # @param [Object] content the document content to upsert
+    # @param [Options::Replace] options request customization
+    #
+    # @return [PendingResult] that resolves into {MutationResult}
+    def replace_async(id, content, options = Options::Replace::DEFAULT)
+      blob, flags = options.transcoder ? options.transcoder.encode(content) : [content, 0]
+      PendingResult.new(
+        @backend.document_replace_async(bucket_name, @scope_name, @name, id, blob, flags, options.to_backend),
+      ) do |resp|
+        extract_mutation_result(resp)
+      end
+    end
+
+    # Removes a document from the collection without waiting for the response
+    #
+    # @param [String] id the document id which is used to uniquely identify it.
+    # @param [Options::Remove] options request customization
+    #
+    # @return [PendingResult] that resolves into {MutationResult}
+    def remove_async(id, options = Options::Remove::DEFAULT)
+      PendingResult.new(@backend.document_remove_async(bucket_name, @scope_name, @name, id, options.to_backend)) do |resp|
+        extract_mutation_result(resp)
+      end
+    end
+
+    # Update the expiration of the document with the given id without waiting for the response
+    #
+    # @param [String] id the document id which is used to uniquely identify it.
+    # @param [Integer, #in_seconds, Time] expiry new expiration time for the document
+    # @param [Options::Touch] options request customization
+    #
+    # @return [PendingResult] that resolves into {MutationResult}
+    def touch_async(id, expiry, options = Options::Touch::DEFAULT)
+      PendingResult.new(
+        @backend.document_touch_async(bucket_name, @scope_name, @name, id,
+                                      Utils::Time.extract_expiry_time(expiry), options.to_backend),
+      ) do |resp|
+        MutationResult.new do |res|
+          res.cas = resp[:cas]
+        end
+      end
+    end
+
     # Unlocks a document if it has been locked previously
     #
     # @param [String] id the document id which is used to uniquely identify it.
@@ -482,6 +740,36 @@ module Couchbase
       end
     end
 
+    # Unlocks multiple documents which have been locked with {#get_and_lock}
+    #
+    # @note that it will not generate exceptions in this case. The caller should check {MutationResult#error} property
+    #  of the result
+    #
+    # @param [Array<Array>] id_cas array of tuples +String,Integer+ with document key and CAS returned by {#get_and_lock}
+    # @param [Options::UnlockMulti] options request customization
+    #
+    # @example Lock (pessimistically) and unlock two documents
+    #   foo = collection.get_and_lock("foo", 10)
+    #   bar = collection.get_and_lock("bar", 10)
+    #   collection.unlock_multi([["foo", foo.cas], ["bar", bar.cas]])
+    #
+    # @return [Array<MutationResult>]
+    def unlock_multi(id_cas, options = Options::UnlockMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_UNLOCK_MULTI, options.parent_span, self, :kv) do |_obs_handler|
+        resp = @backend.document_unlock_multi(bucket_name, @scope_name, @name, id_cas.map do |entry|
+          keyspace, (id, cas) = split_multi_entry(entry)
+          [*keyspace, id, cas]
+        end, options.to_backend)
+        resp.map do |entry|
+          MutationResult.new do |res|
+            res.cas = entry[:cas]
+            res.error = entry[:error]
+            res.id = entry[:id]
+          end
+        end
+      end
+    end
+
     # Performs lookups to document fragments
     #
     # @param [String] id the document id which is used to uniquely identify it.
@@ -503,28 +791,36 @@ module Couchbase
     def lookup_in(id, specs, options = Options::LookupIn::DEFAULT)
       @observability.record_operation(Observability::OP_LOOKUP_IN, options.parent_span, self, :kv) do |obs_handler|
         resp = @backend.document_lookup_in(
-          bucket_name, @scope_name, @name, id,
-          specs.map do |s|
-            {
-              opcode: s.type,
-              xattr: s.xattr?,
-              path: s.path,
-            }
-          end, options.to_backend, obs_handler
+          bucket_name, @scope_name, @name, id, lookup_in_specs_to_backend(specs), options.to_backend, obs_handler
         )
-        LookupInResult.new do |res|
-          res.transcoder = options.transcoder
-          res.cas = resp[:cas]
-          res.deleted = resp[:deleted]
-          res.encoded = resp[:fields].map do |field|
-            SubDocumentField.new do |f|
-              f.exists = field[:exists]
-              f.index = field[:index]
-              f.path = field[:path]
-              f.value = field[:value]
-              f.error = field[:error]
-            end
-          end
+        extract_lookup_in_result(resp, options)
+      end
+    end
+
+    # Performs lookups to the same document fragments of multiple documents
+    #
+    # @note that it will not generate {Error::DocumentNotFound} exceptions in this case. The caller should check
+    #  {LookupInResult#error} property of the result
+    #
+    # @param [Array<String>] ids the array of document identifiers
+    # @param [Array<LookupInSpec>] specs the list of specifications which describe the types of the lookups to perform
+    # @param [Options::LookupInMulti] options request customization
+    #
+    # @example Get names of two customers
+    #   res = collection.lookup_in_multi(["customer123", "customer456"], [LookupInSpec.get("name")])
+    #   res[0].content(0) #=> name of "customer123"
+    #
+    # @return [Array<LookupInResult>]
+    def lookup_in_multi(ids, specs, options = Options::LookupInMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_LOOKUP_IN_MULTI, options.parent_span, self, :kv) do |_obs_handler|
+        resp = @backend.document_lookup_in_multi(
+          ids.map { |id| [bucket_name, @scope_name, @name, id] }, lookup_in_specs_to_backend(specs), options.to_backend
+        )
+        resp.map do |entry|
+          result = entry.key?(:error) ? LookupInResult.new { |res| res.encoded = [] } : extract_lookup_in_result(entry, options)
+          result.id = entry[:id]
+          result.error = entry[:error]
+          result
         end
       end
     end
@@ -613,30 +909,42 @@ module Couchbase
       @observability.record_operation(Observability::OP_MUTATE_IN, options.parent_span, self, :kv) do |obs_handler|
         obs_handler.add_durability_level(options.durability_level)
         resp = @backend.document_mutate_in(
-          bucket_name, @scope_name, @name, id,
-          specs.map do |s|
-            {
-              opcode: s.type,
-              path: s.path,
-              param: s.param,
-              xattr: s.xattr?,
-              expand_macros: s.expand_macros?,
-              create_path: s.create_path?,
-            }
-          end, options.to_backend, obs_handler
+          bucket_name, @scope_name, @name, id, mutate_in_specs_to_backend(specs), options.to_backend, obs_handler
         )
-        MutateInResult.new do |res|
-          res.transcoder = options.transcoder
-          res.cas = resp[:cas]
-          res.deleted = resp[:deleted]
-          res.mutation_token = extract_mutation_token(resp)
-          res.encoded = resp[:fields].map do |field|
-            SubDocumentField.new do |f|
-              f.index = field[:index]
-              f.path = field[:path]
-              f.value = field[:value]
-            end
-          end
+        extract_mutate_in_result(resp, options)
+      end
+    end
+
+    # Performs mutations of document fragments for multiple documents
+    #
+    # @note that it will not generate exceptions in this case. The caller should check {MutateInResult#error} property
+    #  of the result
+    #
+    # @param [Array<Array>] id_specs array of tuples +String,Array<MutateInSpec>+, where first entry treated as document
+    #   key, and the second as the list of mutations to apply to it.
+    # @param [Options::MutateInMulti] options request customization
+    #
+    # @example Increment visits counter for two customers
+    #   specs = [MutateInSpec.increment("visits", 1)]
+    #   res = collection.mutate_in_multi([["customer123", specs], ["customer456", specs]])
+    #   res[0].content(0) #=> new value of the counter for "customer123"
+    #
+    # @return [Array<MutateInResult>]
+    def mutate_in_multi(id_specs, options = Options::MutateInMulti::DEFAULT)
+      @observability.record_operation(Observability::OP_MUTATE_IN_MULTI, options.parent_span, self, :kv) do |obs_handler|
+        obs_handler.add_durability_level(options.durability_level)
+        resp = @backend.document_mutate_in_multi(
+          bucket_name, @scope_name, @name,
+          id_specs.map do |entry|
+            keyspace, (id, specs) = split_multi_entry(entry)
+            [*keyspace, id, mutate_in_specs_to_backend(specs)]
+          end, options.to_backend
+        )
+        resp.map do |entry|
+          result = entry.key?(:error) ? MutateInResult.new { |res| res.encoded = [] } : extract_mutate_in_result(entry, options)
+          result.id = entry[:id]
+          result.error = entry[:error]
+          result
         end
       end
     end
@@ -674,10 +982,84 @@ module Couchbase
             @bucket_name, @scope_name, @name, scan_type.to_backend, options.to_backend
           ),
           transcoder: options.transcoder,
+          checkpoint: options.resume_from,
+        )
+      end
+    end
+
+    # Splits the key space of the collection into disjoint range scans, that could be executed independently
+    #
+    # The boundaries of the ranges are taken from the ids of a random sample of the documents, so the shards hold
+    # roughly the same number of documents. Together the shards cover all keys, including the documents created after
+    # sampling.
+    #
+    # @param [Integer] count the number of shards to create
+    # @param [Options::Scan] options request customization for the sampling scan
+    # @param [Integer] sample_size the number of ids used to select the boundaries, larger samples give more even shards
+    # @param [Integer, nil] seed the seed for the sampling scan, if set
+    #
+    # @return [Array<RangeScan>] up to +count+ shards ordered by keys, fewer if the sample has not enough distinct ids
+    #
+    # @example Export the collection using four worker processes
+    #   shards = collection.scan_shards(4)
+    #   shards.each do |shard|
+    #     fork { collection.scan(shard).each { |item| export(item) } }
+    #   end
+    def scan_shards(count, options = Options::Scan::DEFAULT, sample_size: 1024, seed: nil)
+      raise ArgumentError, "count must be a positive Integer" unless count.is_a?(Integer) && count.positive?
+      return [RangeScan.new] if count == 1
+
+      ids = ScanResults.new(
+        core_scan_result: @backend.document_scan_create(
+          @bucket_name, @scope_name, @name, SamplingScan.new(sample_size, seed).to_backend,
+          options.to_backend.merge(ids_only: true)
+        ),
+        transcoder: nil,
+      ).map(&:id).uniq.sort
+      boundaries = (1...count).map { |shard| ids[shard * ids.size / count] }.compact.uniq
+      lower_bounds = [nil] + boundaries
+      upper_bounds = boundaries + [nil]
+      lower_bounds.zip(upper_bounds).map do |from, to|
+        RangeScan.new(
+          from: from && ScanTerm.new(from),
+          to: to && ScanTerm.new(to, exclusive: true),
         )
       end
     end
 
+    # @api private
+    #
+    # @param [Backend::MutationResponse] resp
+    #
+    # @return [MutationResult]
+    def extract_mutation_result(resp)
+      MutationResult.new do |res|
+        res.cas = resp.cas
+        res.mutation_token = MutationToken.new do |token|
+          token.partition_id = resp.partition_id
+          token.partition_uuid = resp.partition_uuid
+          token.sequence_number = resp.sequence_number
+          token.bucket_name = resp.bucket_name
+        end
+      end
+    end
+
+    # @api private
+    #
+    # @param [Hash] resp response of the backend, that might contain +:mutation_token+
+    #
+    # @return [MutationToken, nil]
+    def extract_mutation_token(resp)
+      return unless resp.key?(:mutation_token)
+
+      MutationToken.new do |token|
+        token.partition_id = resp[:mutation_token][:partition_id]
+        token.partition_uuid = resp[:mutation_token][:partition_uuid]
+        token.sequence_number = resp[:mutation_token][:sequence_number]
+        token.bucket_name = resp[:mutation_token][:bucket_name]
+      end
+    end
+
     private
 
     def encode_content(content, options, obs_handler)
@@ -688,29 +1070,115 @@ module Couchbase
       end
     end
 
-    def encode_content_multi(id_content_pairs, options, obs_handler)
-      unless options.transcoder
-        return id_content_pairs.map do |(id, content)|
-          [id, content, 0]
-        end
+    def encode_content_multi(id_content_pairs, options, obs_handler, with_cas: false)
+      encode_entry = lambda do |entry|
+        keyspace, (id, content, cas) = split_multi_entry(entry)
+        blob, flags = options.transcoder ? options.transcoder.encode(content) : [content, 0]
+        with_cas ? [*keyspace, id, blob, flags, cas] : [*keyspace, id, blob, flags]
       end
+      return id_content_pairs.map(&encode_entry) unless options.transcoder
 
       obs_handler.with_request_encoding_span do
-        id_content_pairs.map do |(id, content)|
-          blob, flags = options.transcoder.encode(content)
-          [id, blob, flags]
+        id_content_pairs.map(&encode_entry)
+      end
+    end
+
+    # Entries of the multi-mutations might start with the {Collection}, that should be used instead of the receiver
+    def split_multi_entry(entry)
+      return [[], entry] unless entry.first.is_a?(Collection)
+
+      collection, *rest = entry
+      [[collection.bucket_name, collection.scope_name, collection.name], rest]
+    end
+
+    def extract_get_multi_result(entry, options)
+      GetResult.new do |res|
+        res.transcoder = options.transcoder
+        res.id = entry[:id]
+        res.cas = entry[:cas]
+        res.flags = entry[:flags]
+        res.encoded = entry[:content]
+        res.decoded_content = entry[:decoded_content] if entry[:decoded]
+        res.error = entry[:error]
+      end
+    end
+
+    def extract_mutation_results(resp)
+      resp.map do |entry|
+        MutationResult.new do |res|
+          res.cas = entry[:cas]
+          res.mutation_token = extract_mutation_token(entry)
+          res.error = entry[:error]
+          res.id = entry[:id]
         end
       end
     end
 
-    def extract_mutation_token(resp)
-      return unless resp.key?(:mutation_token)
+    def lookup_in_specs_to_backend(specs)
+      specs.map do |s|
+        {
+          opcode: s.type,
+          xattr: s.xattr?,
+          path: s.path,
+        }
+      end
+    end
 
-      MutationToken.new do |token|
-        token.partition_id = resp[:mutation_token][:partition_id]
-        token.partition_uuid = resp[:mutation_token][:partition_uuid]
-        token.sequence_number = resp[:mutation_token][:sequence_number]
-        token.bucket_name = resp[:mutation_token][:bucket_name]
+    def mutate_in_specs_to_backend(specs)
+      specs.map do |s|
+        {
+          opcode: s.type,
+          path: s.path,
+          param: s.param,
+          xattr: s.xattr?,
+          expand_macros: s.expand_macros?,
+          create_path: s.create_path?,
+        }
+      end
+    end
+
+    def extract_lookup_in_result(resp, options)
+      LookupInResult.new do |res|
+        res.transcoder = options.transcoder
+        res.cas = resp[:cas]
+        res.deleted = resp[:deleted]
+        res.encoded = resp[:fields].map do |field|
+          SubDocumentField.new do |f|
+            f.exists = field[:exists]
+            f.index = field[:index]
+            f.path = field[:path]
+            f.value = field[:value]
+            f.decoded_value = field[:decoded_value] if field[:decoded]
+            f.error = field[:error]
+          end
+        end
+      end
+    end
+
+    def extract_mutate_in_result(resp, options)
+      MutateInResult.new do |res|
+        res.transcoder = options.transcoder
+        res.cas = resp[:cas]
+        res.deleted = resp[:deleted]
+        res.mutation_token = extract_mutation_token(resp)
+        res.encoded = resp[:fields].map do |field|
+          SubDocumentField.new do |f|
+            f.index = field[:index]
+            f.path = field[:path]
+            f.value = field[:value]
+          end
+        end
+      end
+    end
+
+    # @param [Backend::GetResponse] resp
+    def extract_get_result(resp, options)
+      GetResult.new do |res|
+        res.transcoder = options.transcoder
+        res.cas = resp.cas
+        res.flags = resp.flags
+        res.encoded = resp.content
+        res.decoded_content = resp.decoded_content if resp.decoded
       end
     end
 
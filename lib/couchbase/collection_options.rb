@@ -17,6 +17,7 @@
 require "rubygems/deprecate"
 
 require "couchbase/json_transcoder"
+require "couchbase/native_json_transcoder"
 require "couchbase/raw_string_transcoder"
 require "couchbase/raw_json_transcoder"
 require "couchbase/raw_binary_transcoder"
@@ -45,17 +46,37 @@ module Couchbase
         !error
       end
 
+      # @api private
+      attr_writer :encoded
+
       # @return [String] The encoded content when loading the document
       # @api private
-      attr_accessor :encoded
+      def encoded
+        # the body of the document decoded by the extension becomes String only when it is requested
+        @encoded = @encoded.to_s if @encoded.instance_of?(Backend::DocumentBody)
+        @encoded
+      end
+
+      # @param [Object] content the document, decoded by the extension for the default transcoder. The encoded content
+      #   is kept as received from the server, so other transcoders do not see modifications of the decoded object.
+      # @api private
+      def decoded_content=(content)
+        @decoded_content = content
+        @decoded = true
+      end
 
       # Decodes the content of the document using given (or default transcoder)
       #
+      # @note if the default transcoder is {NativeJsonTranscoder}, the document is decoded once by the extension,
+      #   and this method returns the same object every time
+      #
       # @param [JsonTranscoder] transcoder custom transcoder
       #
       # @return [Object]
       def content(transcoder = self.transcoder)
-        transcoder ? transcoder.decode(@encoded, @flags) : @encoded
+        return @decoded_content if @decoded && transcoder.equal?(self.transcoder)
+
+        transcoder ? transcoder.decode(encoded, @flags) : encoded
       end
 
       # @return [Time] time when the document will expire
@@ -68,6 +89,7 @@ module Couchbase
         @expiry = nil
         @error = nil
         @id = nil
+        @decoded = false
         yield self if block_given?
       end
 
@@ -104,8 +126,21 @@ module Couchbase
       attr_accessor :exists
       alias exists? exists
 
+      # @return [Error::CouchbaseError, nil] error or nil (used in multi-operations like {Collection#exists_multi})
+      attr_accessor :error
+
+      # @return [String, nil] identifier of the document (used in multi-operations like {Collection#exists_multi})
+      attr_accessor :id
+
+      # @return [Boolean] true if error was not associated with the result (useful for multi-operations)
+      def success?
+        !error
+      end
+
       # @yieldparam [ExistsResult]
       def initialize
+        @error = nil
+        @id = nil
         yield self if block_given?
       end
 
@@ -171,6 +206,7 @@ module Couchbase
         field = get_field_at_index(path_or_index)
 
         raise field.error unless field.error.nil?
+        return field.decoded_value if field.decoded? && transcoder.equal?(self.transcoder)
 
         transcoder.decode(field.value, :json)
       end
@@ -200,9 +236,22 @@ module Couchbase
       # @return [Array<SubDocumentField>] holds the encoded subdocument responses
       attr_accessor :encoded
 
+      # @return [Error::CouchbaseError, nil] error or nil (used in multi-operations like {Collection#lookup_in_multi})
+      attr_accessor :error
+
+      # @return [String, nil] identifier of the document (used in multi-operations like {Collection#lookup_in_multi})
+      attr_accessor :id
+
+      # @return [Boolean] true if error was not associated with the result (useful for multi-operations)
+      def success?
+        !error
+      end
+
       # @yieldparam [LookupInResult] self
       def initialize
         @deleted = false
+        @error = nil
+        @id = nil
         yield self if block_given?
       end
 
@@ -302,8 +351,30 @@ module Couchbase
       # @return [Boolean] true if the path exists in the document
       attr_accessor :exists
 
+      attr_writer :value
+
       # @return [String] value
-      attr_accessor :value
+      def value
+        # the value decoded by the extension becomes String only when it is requested
+        @value = @value.to_s if @value.instance_of?(Backend::DocumentBody)
+        @value
+      end
+
+      # @return [Object] value, decoded by the extension for the default transcoder
+      # @api private
+      attr_reader :decoded_value
+
+      # @api private
+      def decoded_value=(value)
+        @decoded_value = value
+        @decoded = true
+      end
+
+      # @return [Boolean] true if the value has been decoded by the extension
+      # @api private
+      def decoded?
+        @decoded
+      end
 
       # @return [Integer] index
       attr_accessor :index
@@ -316,6 +387,7 @@ module Couchbase
 
       # @yieldparam [SubDocumentField] self
       def initialize
+        @decoded = false
         yield self if block_given?
       end
     end
@@ -364,38 +436,116 @@ module Couchbase
     class ScanResults
       include Enumerable
 
-      def initialize(core_scan_result:, transcoder:)
+      # Maximum number of items fetched from the extension at once by {#each}
+      DEFAULT_BATCH_SIZE = 256
+
+      def initialize(core_scan_result:, transcoder:, checkpoint: nil)
         @core_scan_result = core_scan_result
         @transcoder = transcoder
+        @checkpoint = ScanCheckpoint.new(checkpoint || {})
       end
 
       def each
         return enum_for(:each) unless block_given?
 
         loop do
-          resp = @core_scan_result.next_item
+          batch = @core_scan_result.next_batch(DEFAULT_BATCH_SIZE, nil)
 
-          break if resp.nil?
+          break if batch.nil?
 
-          if resp[:id_only]
-            yield ScanResult.new(
-              id: resp[:id],
-              id_only: resp[:id_only],
-              transcoder: @transcoder,
-            )
-          else
-            yield ScanResult.new(
-              id: resp[:id],
-              id_only: resp[:id_only],
-              cas: resp[:cas],
-              expiry: resp[:expiry],
-              encoded: resp[:encoded],
-              flags: resp[:flags],
-              transcoder: @transcoder,
-            )
+          batch.each do |resp|
+            yield convert_item(resp)
+            @checkpoint.update(resp[:partition_id], resp[:id])
           end
         end
       end
+
+      # Returns the progress of the scan, that can be used to resume it with {Options::Scan#resume_from}
+      #
+      # Only includes the items that have been already yielded by {#each} or returned by {#next_batch}
+      #
+      # @return [ScanCheckpoint]
+      def checkpoint
+        ScanCheckpoint.new(@checkpoint)
+      end
+
+      # Fetches the next portion of the scan results with a single call into the extension
+      #
+      # @param [Integer] max_items the maximum number of items in the batch
+      # @param [Integer, nil] max_bytes the batch is closed once the size of the keys and bodies reaches this limit
+      #
+      # @raise [Error::InvalidArgument] if the limits are not positive Integers
+      #
+      # @return [Array<ScanResult>, nil] the items, or +nil+ when the scan is complete
+      def next_batch(max_items, max_bytes = nil)
+        @core_scan_result.next_batch(max_items, max_bytes)&.map do |resp|
+          @checkpoint.update(resp[:partition_id], resp[:id])
+          convert_item(resp)
+        end
+      end
+
+      private
+
+      def convert_item(resp)
+        if resp[:id_only]
+          ScanResult.new(
+            id: resp[:id],
+            id_only: resp[:id_only],
+            transcoder: @transcoder,
+          )
+        else
+          ScanResult.new(
+            id: resp[:id],
+            id_only: resp[:id_only],
+            cas: resp[:cas],
+            expiry: resp[:expiry],
+            encoded: resp[:encoded],
+            flags: resp[:flags],
+            transcoder: @transcoder,
+          )
+        end
+      end
+    end
+
+    # Result of the operation, that has been dispatched without waiting for the response.
+    #
+    # @see Collection#get_async
+    # @see Collection#upsert_async
+    class PendingResult
+      # @param [Backend::PendingResult] pending_result
+      # @yieldparam [Hash] response of the backend, the block converts it into the result object
+      #
+      # @api private
+      def initialize(pending_result, &block)
+        @pending_result = pending_result
+        @convert = block
+        @resolved = false
+        @lock = Mutex.new
+      end
+
+      # Waits for the response (the GVL is released while waiting) and returns the result
+      #
+      # Might be called from several threads, the result is built only once.
+      #
+      # @raise [Error::CouchbaseError] if the operation has failed
+      #
+      # @return [GetResult, MutationResult]
+      def value
+        return @value if @resolved
+
+        @lock.synchronize do
+          unless @resolved
+            @value = @convert.call(@pending_result.value)
+            @resolved = true
+          end
+        end
+        @value
+      end
+
+      # @return [Boolean] true if the response is available, and {#value} will not block
+      def ready?
+        @resolved || @pending_result.ready?
+      end
     end
   end
 end
@@ -92,6 +92,39 @@ module Couchbase
     end
   end
 
+  # Progress of a key-value scan, that allows to resume the scan after it has been interrupted
+  #
+  # Keys of each vbucket are streamed in order, so the checkpoint holds the last key delivered for each vbucket. The
+  # resumed scan skips the keys up to these ones. The checkpoint might be converted into Hash for persistence.
+  #
+  # @see ScanResults#checkpoint
+  # @see Options::Scan#resume_from
+  class ScanCheckpoint
+    # @return [Hash<Integer, String>] the last delivered key for each vbucket
+    attr_reader :last_keys
+
+    # @param [ScanCheckpoint, Hash<Integer, String>] last_keys the last delivered key for each vbucket, the vbucket
+    #   ids might be also given as Strings (e.g. after JSON round trip)
+    def initialize(last_keys = {})
+      @last_keys = last_keys.to_h.to_h { |vbucket, key| [Integer(vbucket), key] }
+    end
+
+    # @api private
+    def update(vbucket, key)
+      @last_keys[vbucket] = key
+    end
+
+    # @return [Boolean] true if no items have been delivered yet
+    def empty?
+      @last_keys.empty?
+    end
+
+    # @return [Hash<Integer, String>]
+    def to_h
+      @last_keys.dup
+    end
+  end
+
   # A sampling scan performs a scan that randomly selects documents up to a configured limit
   class SamplingScan
     attr_accessor :limit # @return [Integer]
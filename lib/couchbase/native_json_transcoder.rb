@@ -0,0 +1,65 @@
+# frozen_string_literal: true
+
+#  Copyright 2025-Present Couchbase, Inc.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+require "couchbase/libcouchbase"
+require "couchbase/transcoder_flags"
+
+module Couchbase
+  # JSON transcoder, that encodes and decodes documents in the native extension.
+  #
+  # It is a drop-in replacement for {JsonTranscoder}: large documents are parsed without holding GVL, and the
+  # decoded objects are built without intermediate Strings for the keys, which are deduplicated and frozen.
+  #
+  # When it is the transcoder of {Collection#get}, {Collection#get_multi} or {Collection#lookup_in}, JSON documents
+  # are decoded by the extension right from the buffers received from the server, without intermediate Strings.
+  #
+  # @example Use native transcoder for the particular operation
+  #   res = collection.get("mydoc", Options::Get(transcoder: NativeJsonTranscoder.new(symbolize_names: true)))
+  #   res.content #=> {:foo => 42}
+  class NativeJsonTranscoder
+    # @param [Boolean] symbolize_names whether to return keys of the objects as Symbols
+    def initialize(symbolize_names: false)
+      @symbolize_names = symbolize_names
+    end
+
+    # @param [Object] document
+    # @return [Array<String, Integer>] pair of encoded document and flags
+    def encode(document)
+      if document.is_a?(String) && !document.valid_encoding?
+        raise Error::EncodingFailure, "The NativeJsonTranscoder does not support binary data"
+      end
+
+      [Backend.json_generate(document), TranscoderFlags.new(format: :json, lower_bits: 6).encode]
+    end
+
+    # @param [String] blob string of bytes, containing encoded representation of the document
+    # @param [Integer, :json] flags bit field, describing how the data encoded
+    # @return [Object] decoded document
+    def decode(blob, flags)
+      format = TranscoderFlags.decode(flags).format
+      raise Error::DecodingFailure, "Unable to decode #{format} with the NativeJsonTranscoder" unless format == :json || format.nil?
+
+      Backend.json_parse(blob, @symbolize_names) unless blob && blob.empty?
+    end
+
+    # Options for the extension, which allow it to decode document bodies as soon as they are received
+    #
+    # @api private
+    def to_backend
+      {symbolize_names: @symbolize_names}
+    end
+  end
+end
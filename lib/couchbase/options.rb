@@ -51,6 +51,45 @@ module Couchbase
           timeout: Utils::Time.extract_duration(@timeout),
         }
       end
+
+      private
+
+      # Transcoders, that implement +to_backend+ (like {NativeJsonTranscoder}), let the extension decode JSON
+      # documents before passing them to Ruby.
+      def json_decode_options(transcoder)
+        transcoder.to_backend if transcoder.respond_to?(:to_backend)
+      end
+    end
+
+    # Common options of the multi-operations, like {Collection#get_multi} or {Collection#upsert_multi}
+    module MultiOperation
+      attr_reader :max_in_flight # @return [Integer, nil]
+
+      # @param [Integer, nil] max_in_flight if set, limits number of requests of the batch, that might be outstanding
+      #   at the same time. Next request is being sent as soon as any of the outstanding requests completes.
+      #   By default all requests of the batch are sent at once.
+      #
+      # @raise [Error::InvalidArgument] if max_in_flight is not a positive Integer
+      def initialize(max_in_flight: nil, **args, &)
+        self.max_in_flight = max_in_flight
+        super(**args, &)
+      end
+
+      # @param [Integer, nil] value the limit of outstanding requests, or +nil+ to send all requests at once
+      #
+      # @raise [Error::InvalidArgument] if the value is not a positive Integer
+      def max_in_flight=(value)
+        unless value.nil? || (value.is_a?(Integer) && value.positive?)
+          raise Error::InvalidArgument, "max_in_flight must be a positive Integer, but given #{value.inspect}"
+        end
+
+        @max_in_flight = value
+      end
+
+      # @api private
+      def to_backend
+        super.merge(max_in_flight: @max_in_flight)
+      end
     end
 
     # Options for {Collection#get}
@@ -114,6 +153,7 @@ module Couchbase
       def to_backend
         options = {
           timeout: Utils::Time.extract_duration(@timeout),
+          json_decode: json_decode_options(@transcoder),
         }
         options.update(with_expiry: true) if @with_expiry
         unless @projections.nil? || @projections.empty?
@@ -131,6 +171,8 @@ module Couchbase
 
     # Options for {Collection#get_multi}
     class GetMulti < Base
+      prepend MultiOperation
+
       attr_accessor :transcoder # @return [JsonTranscoder, #decode(String, Integer)]
 
       # Creates an instance of options for {Collection#get_multi}
@@ -157,6 +199,7 @@ module Couchbase
       def to_backend
         {
           timeout: Utils::Time.extract_duration(@timeout),
+          json_decode: json_decode_options(@transcoder),
         }
       end
 
@@ -234,6 +277,14 @@ module Couchbase
       DEFAULT = GetAndTouch.new.freeze
     end
 
+    # Options for {Collection#get_and_touch_multi}
+    class GetAndTouchMulti < GetAndTouch
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = GetAndTouchMulti.new.freeze
+    end
+
     # Options for {Collection#get_all_replicas}
     class GetAllReplicas < Base
       attr_accessor :transcoder # @return [JsonTranscoder, #decode(String, Integer)]
@@ -347,6 +398,14 @@ module Couchbase
       DEFAULT = Exists.new.freeze
     end
 
+    # Options for {Collection#exists_multi}
+    class ExistsMulti < Exists
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = ExistsMulti.new.freeze
+    end
+
     # Options for {Collection#touch}
     class Touch < Base
       # Creates an instance of options for {Collection#touch}
@@ -376,6 +435,14 @@ module Couchbase
       DEFAULT = Touch.new.freeze
     end
 
+    # Options for {Collection#touch_multi}
+    class TouchMulti < Touch
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = TouchMulti.new.freeze
+    end
+
     # Options for {Collection#unlock}
     class Unlock < Base
       # Creates an instance of options for {Collection#unlock}
@@ -405,6 +472,14 @@ module Couchbase
       DEFAULT = Unlock.new.freeze
     end
 
+    # Options for {Collection#unlock_multi}
+    class UnlockMulti < Unlock
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = UnlockMulti.new.freeze
+    end
+
     # Options for {Collection#remove}
     class Remove < Base
       attr_accessor :cas # @return [Integer, nil]
@@ -482,6 +557,8 @@ module Couchbase
 
     # Options for {Collection#remove_multi}
     class RemoveMulti < Base
+      prepend MultiOperation
+
       attr_accessor :durability_level # @return [Symbol]
 
       # Creates an instance of options for {Collection#remove}
@@ -629,6 +706,14 @@ module Couchbase
       DEFAULT = Insert.new.freeze
     end
 
+    # Options for {Collection#insert_multi}
+    class InsertMulti < Insert
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = InsertMulti.new.freeze
+    end
+
     # Options for {Collection#upsert}
     class Upsert < Base
       attr_accessor :expiry # @return [Integer, #in_seconds, nil]
@@ -715,6 +800,8 @@ module Couchbase
 
     # Options for {Collection#upsert_multi}
     class UpsertMulti < Base
+      prepend MultiOperation
+
       attr_accessor :expiry # @return [Integer, #in_seconds, nil]
       attr_accessor :transcoder # @return [JsonTranscoder, #encode(Object)]
       attr_accessor :durability_level # @return [Symbol]
@@ -886,6 +973,21 @@ module Couchbase
       DEFAULT = Replace.new.freeze
     end
 
+    # Options for {Collection#replace_multi}
+    class ReplaceMulti < Replace
+      prepend MultiOperation
+
+      # @api private
+      #
+      # CAS values are passed along with each document in {Collection#replace_multi}
+      def to_backend
+        super.except(:cas)
+      end
+
+      # @api private
+      DEFAULT = ReplaceMulti.new.freeze
+    end
+
     # Options for {Collection#mutate_in}
     class MutateIn < Base
       attr_accessor :expiry # @return [Integer, #in_seconds, nil]
@@ -1000,6 +1102,21 @@ module Couchbase
       DEFAULT = MutateIn.new.freeze
     end
 
+    # Options for {Collection#mutate_in_multi}
+    class MutateInMulti < MutateIn
+      prepend MultiOperation
+
+      # @api private
+      #
+      # The CAS value cannot be shared between documents, and is not sent for {Collection#mutate_in_multi}
+      def to_backend
+        super.except(:cas)
+      end
+
+      # @api private
+      DEFAULT = MutateInMulti.new.freeze
+    end
+
     # Options for {Collection#lookup_in}
     class LookupIn < Base
       attr_accessor :transcoder # @return [JsonTranscoder, #decode(String)]
@@ -1032,6 +1149,7 @@ module Couchbase
         {
           timeout: Utils::Time.extract_duration(@timeout),
           access_deleted: @access_deleted,
+          json_decode: json_decode_options(@transcoder),
         }
       end
 
@@ -1043,6 +1161,14 @@ module Couchbase
       DEFAULT = LookupIn.new.freeze
     end
 
+    # Options for {Collection#lookup_in_multi}
+    class LookupInMulti < LookupIn
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = LookupInMulti.new.freeze
+    end
+
     # Options for {Collection#lookup_in_any_replica}
     class LookupInAnyReplica < Base
       attr_accessor :transcoder # @return [JsonTranscoder, #decode(String)]
@@ -1139,6 +1265,9 @@ module Couchbase
       attr_accessor :batch_byte_limit # @return [Integer, nil]
       attr_accessor :batch_item_limit # @return [Integer, nil]
       attr_accessor :concurrency # @return [Integer, nil]
+      attr_accessor :resume_from # @return [ScanCheckpoint, nil]
+      attr_accessor :metadata_only # @return [Boolean]
+      attr_accessor :projections # @return [Array<String>]
 
       # Creates an instance of options for {Collection#scan}
       #
@@ -1151,6 +1280,15 @@ module Couchbase
       #   to the client on each partition batch, defaults to 50
       # @param [Integer, nil] concurrency specifies the maximum number of partitions that can be scanned concurrently,
       #   defaults to 1
+      # @param [ScanCheckpoint, Hash, nil] resume_from the checkpoint of the interrupted scan, the items it has already
+      #   delivered are skipped. It must come from the scan with the same scan type, and cannot be used with
+      #   {SamplingScan}. The items are skipped on the client side, so the server streams them again. The only exception
+      #   is a {RangeScan} whose checkpoint has a key for every vbucket: it starts from the lowest key of the checkpoint.
+      #   In all other cases, the server streams almost the whole range again.
+      # @param [Boolean] metadata_only if set to true, the results include CAS, flags and expiry, but not the content.
+      #   The server still sends the bodies, but they are discarded before any Ruby objects are created.
+      # @param [Array<String>] projections a list of dot-separated paths, the JSON content of the documents is reduced
+      #   to these fields by the library before any Ruby objects are created
       #
       # @param [Integer, #in_milliseconds, nil] timeout
       # @param [Proc, nil] retry_strategy the custom retry strategy, if set
@@ -1164,11 +1302,17 @@ module Couchbase
                      batch_byte_limit: nil,
                      batch_item_limit: nil,
                      concurrency: nil,
+                     resume_from: nil,
+                     metadata_only: false,
+                     projections: [],
                      timeout: nil,
                      retry_strategy: nil,
                      client_context: nil,
                      parent_span: nil)
         super(timeout: timeout, retry_strategy: retry_strategy, client_context: client_context, parent_span: parent_span)
+        @resume_from = resume_from
+        @metadata_only = metadata_only
+        @projections = projections
         @ids_only = ids_only
         @transcoder = transcoder
         @mutation_state = mutation_state
@@ -1196,6 +1340,9 @@ module Couchbase
           batch_byte_limit: @batch_byte_limit,
           batch_item_limit: @batch_item_limit,
           concurrency: @concurrency,
+          resume_from: @resume_from&.to_h&.transform_keys { |vbucket| Integer(vbucket) },
+          metadata_only: @metadata_only,
+          projections: @projections,
         }
       end
 
@@ -1452,6 +1599,14 @@ module Couchbase
       DEFAULT = Increment.new.freeze
     end
 
+    # Options for {BinaryCollection#increment_multi}
+    class IncrementMulti < Increment
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = IncrementMulti.new.freeze
+    end
+
     # Options for {BinaryCollection#decrement}
     class Decrement < Base
       attr_reader :delta # @return [Integer]
@@ -1546,6 +1701,14 @@ module Couchbase
       DEFAULT = Decrement.new.freeze
     end
 
+    # Options for {BinaryCollection#decrement_multi}
+    class DecrementMulti < Decrement
+      prepend MultiOperation
+
+      # @api private
+      DEFAULT = DecrementMulti.new.freeze
+    end
+
     # Options for {Datastructures::CouchbaseList#initialize}
     class CouchbaseList
       attr_accessor :get_options # @return [Get]
@@ -1706,6 +1869,12 @@ module Couchbase
       attr_accessor :config_idle_redial_timeout # @return [nil, Integer, #in_milliseconds]
       attr_accessor :idle_http_connection_timeout # @return [nil, Integer, #in_milliseconds]
 
+      attr_accessor :enable_compression # @return [nil, Boolean]
+      attr_accessor :compression_min_size # @return [nil, Integer]
+      attr_accessor :compression_min_ratio # @return [nil, Float]
+      attr_accessor :prepared_statement_cache_size # @return [nil, Integer]
+      attr_accessor :row_stream_max_buffered_bytes # @return [nil, Integer]
+
       # @return [ApplicationTelemetry]
       # @!macro volatile
       attr_accessor :application_telemetry
@@ -1723,6 +1892,19 @@ module Couchbase
       # @param [nil, Integer, #in_milliseconds] analytics_timeout default timeout for Analytics query
       # @param [nil, Integer, #in_milliseconds] search_timeout default timeout for Search query
       # @param [nil, Integer, #in_milliseconds] management_timeout default timeout for management operations
+      # @param [nil, Boolean] enable_compression whether to compress document bodies with Snappy, when the server
+      #   supports it (enabled by default). Compressed values received from the server are always inflated transparently.
+      # @param [nil, Integer] compression_min_size bodies smaller than this number of bytes are sent as is
+      # @param [nil, Float] compression_min_ratio the compressed body is only sent if its size divided by the size of
+      #   the original body does not exceed this ratio, e.g. +0.83+ requires to save at least 17%
+      # @param [nil, Integer] prepared_statement_cache_size maximum number of prepared statements remembered for the
+      #   queries with +adhoc: false+. The cache is disabled by default (zero), and the statements are left to the core.
+      #   Several thousands is enough for the typical application, while it bounds the memory if the application
+      #   generates statements instead of using parameters.
+      # @param [nil, Integer] row_stream_max_buffered_bytes maximum size of the rows received, but not yet consumed by
+      #   the block of {Cluster#query_each}, {Cluster#analytics_query_each} or {Cluster#search_each} (64 MiB by default).
+      #   If the block is slower than the network, the operation stops reading the response and raises
+      #   {Error::RequestCanceled} once the limit is reached. Zero removes the limit.
       #
       # @see .Cluster
       #
@@ -1757,6 +1939,11 @@ module Couchbase
                      config_poll_floor: nil,
                      config_idle_redial_timeout: nil,
                      idle_http_connection_timeout: nil,
+                     enable_compression: nil,
+                     compression_min_size: nil,
+                     compression_min_ratio: nil,
+                     prepared_statement_cache_size: nil,
+                     row_stream_max_buffered_bytes: nil,
                      tracer: nil,
                      meter: nil,
                      application_telemetry: ApplicationTelemetry.new)
@@ -1790,6 +1977,11 @@ module Couchbase
         @config_poll_floor = config_poll_floor
         @config_idle_redial_timeout = config_idle_redial_timeout
         @idle_http_connection_timeout = idle_http_connection_timeout
+        @enable_compression = enable_compression
+        @compression_min_size = compression_min_size
+        @compression_min_ratio = compression_min_ratio
+        @prepared_statement_cache_size = prepared_statement_cache_size
+        @row_stream_max_buffered_bytes = row_stream_max_buffered_bytes
         @tracer = tracer
         @meter = meter
         @application_telemetry = application_telemetry
@@ -1840,6 +2032,11 @@ module Couchbase
           config_poll_floor: Utils::Time.extract_duration(@config_poll_floor),
           config_idle_redial_timeout: Utils::Time.extract_duration(@config_idle_redial_timeout),
           idle_http_connection_timeout: Utils::Time.extract_duration(@idle_http_connection_timeout),
+          enable_compression: @enable_compression,
+          compression_min_size: @compression_min_size,
+          compression_min_ratio: @compression_min_ratio,
+          prepared_statement_cache_size: @prepared_statement_cache_size,
+          row_stream_max_buffered_bytes: @row_stream_max_buffered_bytes,
           application_telemetry: @application_telemetry.to_backend,
         }
       end
@@ -2303,8 +2500,9 @@ module Couchbase
           pipeline_cap: @pipeline_cap,
           metrics: @metrics,
           profile: @profile,
-          positional_parameters: export_positional_parameters,
-          named_parameters: export_named_parameters,
+          # the extension encodes parameters into JSON itself, without intermediate Ruby strings
+          positional_parameters: @positional_parameters,
+          named_parameters: @named_parameters,
           raw_parameters: @raw_parameters,
           scan_consistency: @scan_consistency,
           mutation_state: @mutation_state&.to_a,
@@ -2655,6 +2853,16 @@ module Couchbase
       GetAndTouch.new(**args)
     end
 
+    # Construct {GetAndTouchMulti} options for {Collection#get_and_touch_multi}
+    #
+    # @example Retrieve documents and prolong their expiration for 10 seconds
+    #   res = collection.get_and_touch_multi(["foo", "bar"], 10, Options::GetAndTouchMulti(timeout: 3_000))
+    #
+    # @return [GetAndTouchMulti]
+    def GetAndTouchMulti(**args)
+      GetAndTouchMulti.new(**args)
+    end
+
     # Construct {GetAllReplicas} options for {Collection#get_any_replica}
     #
     # @return [GetAllReplicas]
@@ -2680,6 +2888,17 @@ module Couchbase
       Exists.new(**args)
     end
 
+    # Construct {ExistsMulti} options for {Collection#exists_multi}
+    #
+    # @example Check if the documents exist without fetching their contents
+    #   res = collection.exists_multi(["foo", "bar"], Options::ExistsMulti(timeout: 3_000))
+    #   res[0].exists? #=> true
+    #
+    # @return [ExistsMulti]
+    def ExistsMulti(**args)
+      ExistsMulti.new(**args)
+    end
+
     # Construct {Touch} options for {Collection#touch}
     #
     # @example Reset expiration timer for document to 30 seconds (and use custom operation timeout)
@@ -2690,6 +2909,16 @@ module Couchbase
       Touch.new(**args)
     end
 
+    # Construct {TouchMulti} options for {Collection#touch_multi}
+    #
+    # @example Reset expiration timers of the documents to 30 seconds
+    #   collection.touch_multi(["foo", "bar"], 30, Options::TouchMulti(timeout: 3_000))
+    #
+    # @return [TouchMulti]
+    def TouchMulti(**args)
+      TouchMulti.new(**args)
+    end
+
     # Construct {Unlock} options for {Collection#touch}
     #
     # @example Lock (pessimistically) and unlock document
@@ -2701,6 +2930,17 @@ module Couchbase
       Unlock.new(**args)
     end
 
+    # Construct {UnlockMulti} options for {Collection#unlock_multi}
+    #
+    # @example Lock (pessimistically) and unlock documents
+    #   res = collection.get_and_lock("foo", 10)
+    #   collection.unlock_multi([["foo", res.cas]], Options::UnlockMulti(timeout: 3_000))
+    #
+    # @return [UnlockMulti]
+    def UnlockMulti(**args)
+      UnlockMulti.new(**args)
+    end
+
     # Construct {Remove} options for {Collection#remove}
     #
     # @example Remove the document in collection, but apply optimistic lock
@@ -2745,6 +2985,16 @@ module Couchbase
       Insert.new(**args)
     end
 
+    # Construct {InsertMulti} options for {Collection#insert_multi}
+    #
+    # @example Insert two documents with expiration 20 seconds
+    #   res = collection.insert_multi([["foo", {"foo" => 42}], ["bar", {"bar" => 43}]], Options::InsertMulti(expiry: 20))
+    #
+    # @return [InsertMulti]
+    def InsertMulti(**args)
+      InsertMulti.new(**args)
+    end
+
     # Construct {Upsert} options for {Collection#upsert}
     #
     # @example Upsert new document in collection
@@ -2783,6 +3033,17 @@ module Couchbase
       Replace.new(**args)
     end
 
+    # Construct {ReplaceMulti} options for {Collection#replace_multi}
+    #
+    # @example Replace two documents, and apply optimistic lock for "foo"
+    #   res = collection.get("foo")
+    #   collection.replace_multi([["foo", {"foo" => 42}, res.cas], ["bar", {"bar" => 43}]], Options::ReplaceMulti(expiry: 20))
+    #
+    # @return [ReplaceMulti]
+    def ReplaceMulti(**args)
+      ReplaceMulti.new(**args)
+    end
+
     # Construct {MutateIn} options for {Collection#mutate_in}
     #
     # @example Append number into subarray of the document
@@ -2796,6 +3057,17 @@ module Couchbase
       MutateIn.new(**args)
     end
 
+    # Construct {MutateInMulti} options for {Collection#mutate_in_multi}
+    #
+    # @example Increment counter in two documents
+    #   specs = [MutateInSpec.increment("visits", 1)]
+    #   collection.mutate_in_multi([["foo", specs], ["bar", specs]], Options::MutateInMulti(expiry: 10))
+    #
+    # @return [MutateInMulti]
+    def MutateInMulti(**args)
+      MutateInMulti.new(**args)
+    end
+
     # Construct {LookupIn} options for {Collection#lookup_in}
     #
     # @example Get list of IDs of completed purchases
@@ -2809,6 +3081,17 @@ module Couchbase
       LookupIn.new(**args)
     end
 
+    # Construct {LookupInMulti} options for {Collection#lookup_in_multi}
+    #
+    # @example Fetch the same field from two documents
+    #   res = collection.lookup_in_multi(["foo", "bar"], [LookupInSpec.get("name")], Options::LookupInMulti(timeout: 3_000))
+    #   res[0].content(0) #=> name of "foo"
+    #
+    # @return [LookupInMulti]
+    def LookupInMulti(**args)
+      LookupInMulti.new(**args)
+    end
+
     # Construct {Append} options for {BinaryCollection#append}
     #
     # @example Append "bar" to the content of the existing document
@@ -2869,6 +3152,17 @@ module Couchbase
       Increment.new(**args)
     end
 
+    # Construct {IncrementMulti} options for {BinaryCollection#increment_multi}
+    #
+    # @example Increment two counters by 10, and initialize them to 0 if they do not exist
+    #   res = collection.binary.increment_multi(["foo", "bar"], Options::IncrementMulti(delta: 10, initial: 0))
+    #   res[0].content #=> 0
+    #
+    # @return [IncrementMulti]
+    def IncrementMulti(**args)
+      IncrementMulti.new(**args)
+    end
+
     # Construct {Decrement} options for {BinaryCollection#decrement}
     #
     # @example Decrement value by 2, and initialize to 100 if it does not exist
@@ -2882,6 +3176,17 @@ module Couchbase
       Decrement.new(**args)
     end
 
+    # Construct {DecrementMulti} options for {BinaryCollection#decrement_multi}
+    #
+    # @example Decrement two counters by 2, and initialize them to 100 if they do not exist
+    #   res = collection.binary.decrement_multi(["foo", "bar"], Options::DecrementMulti(delta: 2, initial: 100))
+    #   res[0].content #=> 100
+    #
+    # @return [DecrementMulti]
+    def DecrementMulti(**args)
+      DecrementMulti.new(**args)
+    end
+
     # Construct {Analytics} options for {Cluster#analytics_query}
     #
     # @example Select name of the given user
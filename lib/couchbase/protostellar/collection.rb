@@ -147,6 +147,10 @@ module Couchbase
       def scan(_scan_type, _options = Options::Scan::DEFAULT)
         raise Couchbase::Error::FeatureNotAvailable, "The #{Protostellar::NAME} protocol does not support KV scans"
       end
+
+      def scan_shards(_count, _options = Options::Scan::DEFAULT, **)
+        raise Couchbase::Error::FeatureNotAvailable, "The #{Protostellar::NAME} protocol does not support KV scans"
+      end
     end
   end
 end
@@ -24,6 +24,14 @@ module Couchbase
 
       attr_accessor :transcoder
 
+      # @return [Error::CouchbaseError, nil] error associated with the result, or nil (used in {Cluster#query_multi})
+      attr_accessor :error
+
+      # @return [Boolean] true if error was not associated with the result (useful for {Cluster#query_multi})
+      def success?
+        !error
+      end
+
       # Returns all rows converted using a transcoder
       #
       # @return [Array]
@@ -42,6 +50,22 @@ module Couchbase
         yield self if block_given?
         @transcoder = :json
       end
+
+      # @api private
+      #
+      # @param [Hash] resp entry of the response of {Backend#document_query_multi}
+      # @return [QueryResult]
+      def self.from_backend(resp)
+        new do |res|
+          if resp[:error]
+            res.error = resp[:error]
+            res.instance_variable_set(:@rows, [])
+          else
+            res.meta_data = QueryMetaData.from_backend(resp)
+            res.instance_variable_set(:@rows, resp[:rows])
+          end
+        end
+      end
     end
 
     class QueryMetaData
@@ -70,6 +94,33 @@ module Couchbase
       def initialize
         yield self if block_given?
       end
+
+      # @api private
+      #
+      # @param [Hash] resp response of the query from the extension
+      # @return [QueryMetaData]
+      def self.from_backend(resp)
+        new do |meta|
+          meta.status = resp[:meta][:status]
+          meta.request_id = resp[:meta][:request_id]
+          meta.client_context_id = resp[:meta][:client_context_id]
+          meta.signature = JSON.parse(resp[:meta][:signature]) if resp[:meta][:signature]
+          meta.profile = JSON.parse(resp[:meta][:profile]) if resp[:meta][:profile]
+          meta.metrics = QueryMetrics.new do |metrics|
+            if resp[:meta][:metrics]
+              metrics.elapsed_time = resp[:meta][:metrics][:elapsed_time]
+              metrics.execution_time = resp[:meta][:metrics][:execution_time]
+              metrics.sort_count = resp[:meta][:metrics][:sort_count]
+              metrics.result_count = resp[:meta][:metrics][:result_count]
+              metrics.result_size = resp[:meta][:metrics][:result_size]
+              metrics.mutation_count = resp[:meta][:metrics][:mutation_count]
+              metrics.error_count = resp[:meta][:metrics][:error_count]
+              metrics.warning_count = resp[:meta][:metrics][:warning_count]
+            end
+          end
+          meta.warnings = resp[:warnings].map { |warn| QueryWarning.new(warn[:code], warn[:message]) } if resp[:warnings]
+        end
+      end
     end
 
     class QueryMetrics
@@ -105,6 +156,45 @@ module Couchbase
       end
     end
 
+    # Counters of the prepared statement cache, that is used by queries with +adhoc: false+
+    #
+    # @see Cluster#prepared_statement_cache_stats
+    class PreparedStatementCacheStats
+      # @return [Integer] maximum number of statements in the cache
+      attr_accessor :capacity
+
+      # @return [Integer] number of statements in the cache
+      attr_accessor :size
+
+      # @return [Integer] number of queries that have been executed without preparing the statement
+      attr_accessor :hits
+
+      # @return [Integer] number of queries that had to prepare the statement first
+      attr_accessor :misses
+
+      # @return [Integer] number of statements dropped from the cache to make room for new ones
+      attr_accessor :evictions
+
+      # @yieldparam [PreparedStatementCacheStats] self
+      def initialize
+        yield self if block_given?
+      end
+
+      # @api private
+      #
+      # @param [Hash] resp statistics of the cache from the extension
+      # @return [PreparedStatementCacheStats]
+      def self.from_backend(resp)
+        new do |stats|
+          stats.capacity = resp[:capacity]
+          stats.size = resp[:size]
+          stats.hits = resp[:hits]
+          stats.misses = resp[:misses]
+          stats.evictions = resp[:evictions]
+        end
+      end
+    end
+
     # Represents a single warning returned from the query engine.
     class QueryWarning
       # @return [Integer]
@@ -28,12 +28,12 @@ module Couchbase
 
     # @param [String] blob string of bytes, containing encoded representation of the document
     # @param [Integer] flags bit field, describing how the data encoded
-    # @return [String] decoded document
+    # @return [String] decoded document, the caller is free to modify it
     def decode(blob, flags)
       format = TranscoderFlags.decode(flags).format
       raise Error::DecodingFailure, "Unable to decode #{format} with the RawBinaryTranscoder" unless format == :binary || format.nil?
 
-      blob
+      +blob
     end
   end
 end
@@ -17,6 +17,7 @@
 require "couchbase/collection"
 require "couchbase/query_options"
 require "couchbase/analytics_options"
+require "couchbase/utils/row_stream"
 
 module Couchbase
   # The scope identifies a group of collections and allows high application density as a result.
@@ -67,31 +68,83 @@ module Couchbase
         resp = @backend.document_query(statement, options.to_backend(scope_name: @name, bucket_name: @bucket_name), obs_handler)
 
         Cluster::QueryResult.new do |res|
-          res.meta_data = Cluster::QueryMetaData.new do |meta|
-            meta.status = resp[:meta][:status]
-            meta.request_id = resp[:meta][:request_id]
-            meta.client_context_id = resp[:meta][:client_context_id]
-            meta.signature = JSON.parse(resp[:meta][:signature]) if resp[:meta][:signature]
-            meta.profile = JSON.parse(resp[:meta][:profile]) if resp[:meta][:profile]
-            meta.metrics = Cluster::QueryMetrics.new do |metrics|
-              if resp[:meta][:metrics]
-                metrics.elapsed_time = resp[:meta][:metrics][:elapsed_time]
-                metrics.execution_time = resp[:meta][:metrics][:execution_time]
-                metrics.sort_count = resp[:meta][:metrics][:sort_count]
-                metrics.result_count = resp[:meta][:metrics][:result_count]
-                metrics.result_size = resp[:meta][:metrics][:result_size]
-                metrics.mutation_count = resp[:meta][:metrics][:mutation_count]
-                metrics.error_count = resp[:meta][:metrics][:error_count]
-                metrics.warning_count = resp[:meta][:metrics][:warning_count]
-              end
-            end
-            meta.warnings = resp[:warnings].map { |warn| Cluster::QueryWarning.new(warn[:code], warn[:message]) } if resp[:warnings]
-          end
+          res.meta_data = Cluster::QueryMetaData.from_backend(resp)
           res.instance_variable_set(:@rows, resp[:rows])
         end
       end
     end
 
+    # Performs a query against the query (N1QL) services, and yields rows to the block as they arrive
+    #
+    # @see Cluster#query_each
+    #
+    # @param [String] statement the N1QL query statement
+    # @param [Options::Query] options the custom options for this query
+    #
+    # @example Export all hotels of the scope
+    #   scope.query_each("SELECT * FROM hotel") do |row|
+    #     csv << [row["hotel"]["name"], row["hotel"]["city"]]
+    #   end
+    #
+    # @yieldparam [Object] row the row decoded as JSON
+    #
+    # @raise [Error::RequestCanceled] if the block does not keep up with the network, and more than
+    #   {Options::Cluster#row_stream_max_buffered_bytes} of rows have been buffered
+    #
+    # @return [Cluster::QueryMetaData, Enumerator] metadata of the query, or Enumerator if the block is not given
+    def query_each(statement, options = Options::Query::DEFAULT, &block)
+      return enum_for(:query_each, statement, options) unless block
+
+      @observability.record_operation(Observability::OP_QUERY, options.parent_span, self, :query) do |obs_handler|
+        obs_handler.add_query_statement(statement, options)
+
+        stream = @backend.document_query_stream(statement, options.to_backend(scope_name: @name, bucket_name: @bucket_name), obs_handler)
+        Cluster::QueryMetaData.from_backend(Utils::RowStream.each_row(stream) { |row| yield JSON.parse(row) })
+      end
+    end
+
+    # Performs independent queries concurrently and waits for all of them at once, so that the latency of the batch is
+    # the latency of the slowest query rather than the sum of them.
+    #
+    # @param [Array<String, Array(String, Options::Query)>] queries the N1QL query statements, optionally paired with
+    #   their options
+    #
+    # @example Load data for the dashboard widgets
+    #   top, total = scope.query_multi([
+    #     ["SELECT name FROM `travel-sample` WHERE type = $1 LIMIT 5", Options::Query(positional_parameters: ["hotel"])],
+    #     "SELECT COUNT(*) AS total FROM `travel-sample`",
+    #   ])
+    #
+    # @return [Array<QueryResult>] results in the order of the queries, failed queries carry {QueryResult#error}
+    def query_multi(queries)
+      queries = queries.map { |statement, options = Options::Query::DEFAULT| [statement, options] }
+      parent_spans = queries.map { |_, options| options.parent_span }
+      @observability.record_operations(Observability::OP_QUERY, parent_spans, self, :query) do |obs_handlers|
+        requests = queries.zip(obs_handlers).map do |(statement, options), obs_handler|
+          obs_handler.add_query_statement(statement, options)
+          [statement, options.to_backend(scope_name: @name, bucket_name: @bucket_name)]
+        end
+        @backend.document_query_multi(requests, obs_handlers).zip(obs_handlers).map do |resp, obs_handler|
+          res = Cluster::QueryResult.from_backend(resp)
+          res.success? ? obs_handler.set_success : obs_handler.add_error(res.error)
+          res
+        end
+      end
+    end
+
+    # Prepares the statements ahead of time in the context of this scope, so that the queries with +adhoc: false+ skip
+    # the extra round trip to the query service on their first execution.
+    #
+    # @param [Array<String>] statements the N1QL query statements
+    # @param [Options::Query] options the custom options for the PREPARE requests (e.g. timeout)
+    #
+    # @see Cluster#prepare_queries
+    #
+    # @return [Integer] number of statements that have been prepared
+    def prepare_queries(statements, options = Options::Query::DEFAULT)
+      @backend.document_query_prepare(statements, options.to_backend(scope_name: @name, bucket_name: @bucket_name))
+    end
+
     # Performs an analytics query
     #
     # The query will be implicitly scoped using current bucket and scope names.
@@ -108,34 +161,48 @@ module Couchbase
       @observability.record_operation(Observability::OP_ANALYTICS_QUERY, options.parent_span, self, :analytics) do |obs_handler|
         obs_handler.add_query_statement(statement, options)
 
-        resp = @backend.document_analytics(statement, options.to_backend(scope_name: @name, bucket_name: @bucket_name))
+        resp = @backend.document_analytics(statement, options.to_backend(scope_name: @name, bucket_name: @bucket_name), obs_handler)
 
         Cluster::AnalyticsResult.new do |res|
           res.transcoder = options.transcoder
-          res.meta_data = Cluster::AnalyticsMetaData.new do |meta|
-            meta.status = resp[:meta][:status]
-            meta.request_id = resp[:meta][:request_id]
-            meta.client_context_id = resp[:meta][:client_context_id]
-            meta.signature = JSON.parse(resp[:meta][:signature]) if resp[:meta][:signature]
-            meta.profile = JSON.parse(resp[:meta][:profile]) if resp[:meta][:profile]
-            meta.metrics = Cluster::AnalyticsMetrics.new do |metrics|
-              if resp[:meta][:metrics]
-                metrics.elapsed_time = resp[:meta][:metrics][:elapsed_time]
-                metrics.execution_time = resp[:meta][:metrics][:execution_time]
-                metrics.result_count = resp[:meta][:metrics][:result_count]
-                metrics.result_size = resp[:meta][:metrics][:result_size]
-                metrics.error_count = resp[:meta][:metrics][:error_count]
-                metrics.warning_count = resp[:meta][:metrics][:warning_count]
-                metrics.processed_objects = resp[:meta][:metrics][:processed_objects]
-              end
-            end
-            res[:warnings] = resp[:warnings].map { |warn| Cluster::AnalyticsWarning.new(warn[:code], warn[:message]) } if resp[:warnings]
-          end
+          res.meta_data = Cluster::AnalyticsMetaData.from_backend(resp)
           res.instance_variable_set(:@rows, resp[:rows])
         end
       end
     end
 
+    # Performs an analytics query, and yields rows to the block as they arrive
+    #
+    # The query will be implicitly scoped using current bucket and scope names.
+    #
+    # @see Cluster#analytics_query_each
+    #
+    # @param [String] statement the N1QL query statement
+    # @param [Options::Analytics] options the custom options for this query
+    #
+    # @example Count users without loading the whole result set
+    #   scope.analytics_query_each("SELECT u.* FROM GleambookUsers u").count { |row| row["active"] }
+    #
+    # @yieldparam [Object] row the row decoded with the transcoder of the options
+    #
+    # @raise [Error::RequestCanceled] if the block does not keep up with the network, and more than
+    #   {Options::Cluster#row_stream_max_buffered_bytes} of rows have been buffered
+    #
+    # @return [Cluster::AnalyticsMetaData, Enumerator] metadata of the query, or Enumerator if the block is not given
+    def analytics_query_each(statement, options = Options::Analytics::DEFAULT, &block)
+      return enum_for(:analytics_query_each, statement, options) unless block
+
+      @observability.record_operation(Observability::OP_ANALYTICS_QUERY, options.parent_span, self, :analytics) do |obs_handler|
+        obs_handler.add_query_statement(statement, options)
+
+        stream = @backend.document_analytics_stream(
+          statement, options.to_backend(scope_name: @name, bucket_name: @bucket_name), obs_handler
+        )
+        meta = Utils::RowStream.each_row(stream) { |row| yield options.transcoder.decode(row, 0) }
+        Cluster::AnalyticsMetaData.from_backend(meta)
+      end
+    end
+
     # Performs a Full Text Search (FTS) query
     #
     # @param [String] index_name the name of the search index
@@ -176,6 +243,41 @@ module Couchbase
       end
     end
 
+    # Performs a request against the Full Text Search (FTS) service, and yields hits as they are received.
+    #
+    # Unlike {#search}, hits are not collected into the result, so that large result sets could be processed without
+    # holding all of them in memory. The hits received and not yet yielded are buffered up to
+    # {Options::Cluster#row_stream_max_buffered_bytes}, after which the request fails. If the block breaks the
+    # iteration, the rest of the response is not read.
+    #
+    # @param [String] index_name the name of the search index
+    # @param [SearchRequest] search_request the request
+    # @param [Options::Search] options the custom options for this search request
+    #
+    # @example Collect identifiers of all matching documents
+    #   ids = scope.search_each("travel_index", SearchRequest.new(SearchQuery.match("hotel"))).map(&:id)
+    #
+    # @yieldparam [SearchRow] row
+    #
+    # @raise [Error::RequestCanceled] if the block does not keep up with the network, and more than
+    #   {Options::Cluster#row_stream_max_buffered_bytes} of rows have been buffered
+    #
+    # @return [SearchResult, Enumerator] metadata and facets of the response (without rows), or Enumerator over the
+    #   rows if the block is not given
+    def search_each(index_name, search_request, options = Options::Search::DEFAULT, &block)
+      return enum_for(:search_each, index_name, search_request, options) unless block
+
+      @observability.record_operation(Observability::OP_SEARCH_QUERY, options.parent_span, self, :search) do |obs_handler|
+        encoded_query, encoded_req = search_request.to_backend
+        stream = @backend.document_search_stream(@bucket_name, @name, index_name, encoded_query, encoded_req,
+                                                 options.to_backend(show_request: false), obs_handler)
+        resp = Utils::RowStream.each_row(stream) do |hit|
+          yield SearchRow.from_backend(Backend.search_row_parse(hit), options.transcoder)
+        end
+        convert_search_result(resp, options)
+      end
+    end
+
     # @return [Management::ScopeSearchIndexManager]
     def search_indexes
       Management::ScopeSearchIndexManager.new(@backend, @bucket_name, @name, @observability)
@@ -194,31 +296,7 @@ module Couchbase
           meta.metrics.total_rows = resp[:meta_data][:metrics][:total_rows]
           meta.errors = resp[:meta_data][:errors]
         end
-        res.rows = resp[:rows].map do |r|
-          SearchRow.new do |row|
-            row.transcoder = options.transcoder
-            row.index = r[:index]
-            row.id = r[:id]
-            row.score = r[:score]
-            row.fragments = r[:fragments]
-            unless r[:locations].empty?
-              row.locations = SearchRowLocations.new(
-                r[:locations].map do |loc|
-                  SearchRowLocation.new do |location|
-                    location.field = loc[:field]
-                    location.term = loc[:term]
-                    location.position = loc[:position]
-                    location.start_offset = loc[:start_offset]
-                    location.end_offset = loc[:end_offset]
-                    location.array_positions = loc[:array_positions]
-                  end
-                end,
-              )
-            end
-            row.instance_variable_set(:@fields, r[:fields])
-            row.explanation = JSON.parse(r[:explanation]) if r[:explanation]
-          end
-        end
+        res.rows = resp.fetch(:rows, []).map { |r| SearchRow.from_backend(r, options.transcoder) }
         if resp[:facets]
           res.facets = resp[:facets].each_with_object({}) do |(k, v), o|
             facet = case options.facets[k]
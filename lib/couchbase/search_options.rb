@@ -1562,13 +1562,13 @@ module Couchbase
     attr_accessor :score
 
     # @return [SearchRowLocations]
-    attr_accessor :locations
+    attr_writer :locations
 
     # @return [Hash]
-    attr_accessor :explanation
+    attr_writer :explanation
 
     # @return [Hash<String => Array<String>>]
-    attr_accessor :fragments
+    attr_writer :fragments
 
     # @return [JsonTranscoder] transcoder to use for the fields
     attr_accessor :transcoder
@@ -1577,11 +1577,70 @@ module Couchbase
       @transcoder.decode(@fields, :json) if @fields && @transcoder
     end
 
+    # @return [SearchRowLocations]
+    def locations
+      if @encoded_locations
+        @locations = SearchRowLocations.new(
+          Backend.json_parse(@encoded_locations, false).flat_map do |field, terms|
+            terms.flat_map do |term, term_locations|
+              term_locations.map do |loc|
+                SearchRowLocation.new do |location|
+                  location.field = field
+                  location.term = term
+                  location.position = loc["pos"]
+                  location.start_offset = loc["start"]
+                  location.end_offset = loc["end"]
+                  location.array_positions = loc["array_positions"]
+                end
+              end
+            end
+          end,
+        )
+        @encoded_locations = nil
+      end
+      @locations
+    end
+
+    # @return [Hash]
+    def explanation
+      if @encoded_explanation
+        @explanation = Backend.json_parse(@encoded_explanation, false)
+        @encoded_explanation = nil
+      end
+      @explanation
+    end
+
+    # @return [Hash<String => Array<String>>]
+    def fragments
+      if @encoded_fragments
+        @fragments = Backend.json_parse(@encoded_fragments, false)
+        @encoded_fragments = nil
+      end
+      @fragments
+    end
+
     # @yieldparam [SearchRow] self
     def initialize
       @fields = nil
       yield self if block_given?
     end
+
+    # Locations, fragments, fields and explanation are kept as JSON text until they are requested, because
+    # applications that page through large result sets often need only identifiers and scores of the hits.
+    #
+    # @api private
+    def self.from_backend(row, transcoder)
+      new do |res|
+        res.transcoder = transcoder
+        res.index = row[:index]
+        res.id = row[:id]
+        res.score = row[:score]
+        res.instance_variable_set(:@encoded_locations, row[:locations])
+        res.instance_variable_set(:@encoded_fragments, row[:fragments])
+        res.instance_variable_set(:@encoded_explanation, row[:explanation])
+        res.instance_variable_set(:@fields, row[:fields])
+      end
+    end
   end
 
   class SearchMetrics
@@ -57,6 +57,24 @@ module Couchbase
         res
       end
 
+      # Records a batch of operations that are executed at once, every one with its own parent span. The block
+      # receives the handlers in the order of the parent spans, and has to report success or error of each of them.
+      def record_operations(op_name, parent_spans, receiver, service = nil)
+        handlers = parent_spans.map do |parent_span|
+          handler = Handler.new(@backend, op_name, parent_span, receiver, @tracer, @meter)
+          handler.add_service(service) unless service.nil?
+          handler
+        end
+        begin
+          yield(handlers)
+        rescue StandardError => e
+          handlers.each { |handler| handler.add_error(e) }
+          raise e
+        ensure
+          handlers.each(&:finish)
+        end
+      end
+
       def close
         @tracer&.close
         @meter&.close
@@ -20,26 +20,36 @@ module Couchbase
     OP_GET_MULTI = "get_multi"
     OP_GET_AND_LOCK = "get_and_lock"
     OP_GET_AND_TOUCH = "get_and_touch"
+    OP_GET_AND_TOUCH_MULTI = "get_and_touch_multi"
     OP_GET_ALL_REPLICAS = "get_all_replicas"
     OP_GET_ANY_REPLICA = "get_any_replica"
     OP_GET_REPLICA = "get_replica"
     OP_EXISTS = "exists"
+    OP_EXISTS_MULTI = "exists_multi"
     OP_REPLACE = "replace"
+    OP_REPLACE_MULTI = "replace_multi"
     OP_UPSERT = "upsert"
     OP_UPSERT_MULTI = "upsert_multi"
     OP_REMOVE = "remove"
     OP_REMOVE_MULTI = "remove_multi"
     OP_INSERT = "insert"
+    OP_INSERT_MULTI = "insert_multi"
     OP_TOUCH = "touch"
+    OP_TOUCH_MULTI = "touch_multi"
     OP_UNLOCK = "unlock"
+    OP_UNLOCK_MULTI = "unlock_multi"
     OP_LOOKUP_IN = "lookup_in"
+    OP_LOOKUP_IN_MULTI = "lookup_in_multi"
     OP_LOOKUP_IN_ALL_REPLICAS = "lookup_in_all_replicas"
     OP_LOOKUP_IN_ANY_REPLICA = "lookup_in_any_replica"
     OP_LOOKUP_IN_REPLICA = "lookup_in_replica"
     OP_MUTATE_IN = "mutate_in"
+    OP_MUTATE_IN_MULTI = "mutate_in_multi"
     OP_SCAN = "scan"
     OP_INCREMENT = "increment"
+    OP_INCREMENT_MULTI = "increment_multi"
     OP_DECREMENT = "decrement"
+    OP_DECREMENT_MULTI = "decrement_multi"
     OP_APPEND = "append"
     OP_PREPEND = "prepend"
 
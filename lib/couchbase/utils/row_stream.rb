@@ -0,0 +1,46 @@
+# frozen_string_literal: true
+
+#  Copyright 2025-Present Couchbase, Inc.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+module Couchbase
+  module Utils
+    # Consumes rows of the streaming operations (like {Cluster#query_each}) from the extension
+    #
+    # @api private
+    module RowStream
+      # Number of rows converted into Ruby Strings at once
+      CHUNK_SIZE = 1_000
+
+      module_function
+
+      # Yields rows of the backend stream as they arrive, and stops reading the response if the block breaks the
+      # iteration early (or raises an error).
+      #
+      # @param [Backend::RowStream] stream
+      #
+      # @yieldparam [String] row
+      #
+      # @return [Hash] metadata of the response
+      def each_row(stream)
+        while (rows = stream.next_rows(CHUNK_SIZE))
+          rows.each { |row| yield row }
+        end
+        stream.meta
+      ensure
+        stream.cancel
+      end
+    end
+  end
+end
@@ -0,0 +1,102 @@
+# frozen_string_literal: true
+
+#  Copyright 2025-Present Couchbase, Inc.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+require_relative "test_helper"
+
+module Couchbase
+  class AnalyticsTest < Minitest::Test
+    include TestUtilities
+
+    def setup
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support analytics streaming") if env.protostellar?
+      connect
+      skip("#{name}: CAVES does not support analytics service yet") if use_caves?
+    end
+
+    def teardown
+      disconnect
+    end
+
+    def test_analytics_query_each_streams_rows
+      seen = []
+      meta = @cluster.analytics_query_each("SELECT VALUE i FROM range(0, 4999) AS i",
+                                           Options::Analytics(client_context_id: "each-test")) { |row| seen << row }
+
+      assert_equal (0...5000).to_a, seen
+      assert_kind_of AnalyticsMetaData, meta
+      assert_equal :success, meta.status
+      assert_equal "each-test", meta.client_context_id
+      refute_nil meta.request_id
+      assert_equal 5000, meta.metrics.result_count
+    end
+
+    def test_analytics_query_each_stops_when_block_breaks
+      taken = @cluster.analytics_query_each("SELECT VALUE i FROM range(0, 99999) AS i").take(3)
+
+      assert_equal [0, 1, 2], taken
+
+      seen = []
+      @cluster.analytics_query_each("SELECT VALUE i FROM range(0, 99999) AS i") do |row|
+        seen << row
+        break if seen.size == 10
+      end
+
+      assert_equal (0...10).to_a, seen
+      assert_equal({"result" => true}, @cluster.analytics_query("SELECT 1=1 AS result").rows.first)
+    end
+
+    def test_analytics_query_each_raises_analytics_errors
+      assert_raises(Error::ParsingFailure) do
+        @cluster.analytics_query_each("SELECT * FROM WHERE") { |row| flunk("unexpected row #{row}") }
+      end
+
+      assert_raises(Error::DatasetNotFound) do
+        @cluster.analytics_query_each("SELECT * FROM `#{uniq_id(:missing_dataset)}`") do |row|
+          flunk("unexpected row #{row}")
+        end
+      end
+    end
+
+    def test_analytics_query_each_propagates_errors_of_the_block
+      seen = []
+
+      error = assert_raises(RuntimeError) do
+        @cluster.analytics_query_each("SELECT VALUE i FROM range(0, 99999) AS i") do |row|
+          seen << row
+          raise "stop at #{row}" if row == 5
+        end
+      end
+
+      assert_equal "stop at 5", error.message
+      assert_equal (0..5).to_a, seen
+    end
+
+    def test_analytics_query_each_fails_when_consumer_falls_behind
+      disconnect
+      connect(Options::Cluster.new(row_stream_max_buffered_bytes: 4096))
+      seen = []
+
+      assert_raises(Error::RequestCanceled) do
+        @cluster.analytics_query_each("SELECT VALUE i FROM range(0, 99999) AS i") do |row|
+          sleep(1) if seen.empty?
+          seen << row
+        end
+      end
+
+      assert_operator seen.size, :<, 100_000
+    end
+  end
+end
@@ -17,6 +17,8 @@
 require_relative "test_helper"
 
 require "couchbase/raw_binary_transcoder"
+require "couchbase/native_json_transcoder"
+require "couchbase/raw_json_transcoder"
 
 module Couchbase
   class CrudTest < Minitest::Test
@@ -53,6 +55,53 @@ module Couchbase
       end
     end
 
+    def test_kv_operations_overlap_in_non_blocking_fibers
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not use fiber scheduler") if env.protostellar?
+
+      doc_ids = Array.new(5) { |i| uniq_id("fiber_#{i}") }
+      missing_id = uniq_id(:fiber_missing)
+      results = {}
+      scheduler = TestUtilities::FiberScheduler.new
+
+      Thread.new do
+        Fiber.set_scheduler(scheduler)
+        doc_ids.each do |doc_id|
+          Fiber.schedule do
+            @collection.upsert(doc_id, {"id" => doc_id})
+            results[doc_id] = @collection.get(doc_id).content
+          end
+        end
+        Fiber.schedule do
+          @collection.get(missing_id)
+        rescue Error::DocumentNotFound => e
+          results[missing_id] = e
+        end
+      end.join
+
+      assert_operator(scheduler.max_waiting_fibers, :>, 1)
+      doc_ids.each do |doc_id|
+        assert_equal({"id" => doc_id}, results[doc_id])
+      end
+      assert_kind_of(Error::DocumentNotFound, results[missing_id])
+    end
+
+    def test_mutations_return_mutation_tokens
+      doc_id = uniq_id(:foo)
+      tokens = [
+        @collection.insert(doc_id, {"value" => 42}).mutation_token,
+        @collection.upsert(doc_id, {"value" => 43}).mutation_token,
+        @collection.replace(doc_id, {"value" => 44}).mutation_token,
+        @collection.remove(doc_id).mutation_token,
+      ]
+
+      tokens.each do |token|
+        assert_equal env.bucket, token.bucket_name
+        assert_equal tokens.first.partition_id, token.partition_id
+        assert_predicate token.sequence_number, :positive?
+      end
+      assert_equal tokens.map(&:sequence_number).sort, tokens.map(&:sequence_number)
+    end
+
     def test_reads_from_replica
       doc_id = uniq_id(:foo)
       document = {"value" => 42}
@@ -397,6 +446,112 @@ module Couchbase
       assert_equal person, res.content
     end
 
+    def test_large_document_bodies_outlive_get_result
+      doc_id = uniq_id(:large_doc)
+      transcoder = Couchbase::RawBinaryTranscoder.new
+      blob = ("a".."z").to_a.join * 20_000
+      @collection.upsert(doc_id, blob, Options::Upsert(transcoder: transcoder))
+
+      content = @collection.get(doc_id, Options::Get(transcoder: transcoder)).content
+
+      assert_equal blob, content
+      head = content[0, 300 * 1024]
+      tail = content[100 * 1024..]
+      content = nil # rubocop:disable Lint/UselessAssignment
+      GC.start
+      GC.compact if GC.respond_to?(:compact)
+
+      assert_equal blob[0, 300 * 1024], head
+      assert_equal blob[100 * 1024..], tail
+    end
+
+    def test_raw_document_bodies_are_mutable_regardless_of_size
+      transcoder = Couchbase::RawBinaryTranscoder.new
+      [16, 64 * 1024].each do |size|
+        doc_id = uniq_id(:"raw_doc_#{size}")
+        blob = "x" * size
+        @collection.upsert(doc_id, blob, Options::Upsert(transcoder: transcoder))
+
+        content = @collection.get(doc_id, Options::Get(transcoder: transcoder)).content
+
+        refute_predicate content, :frozen?, "content of #{size} bytes must not be frozen"
+        content << "y"
+
+        assert_equal size + 1, content.bytesize
+        assert_equal blob, @collection.get(doc_id, Options::Get(transcoder: transcoder)).content
+      end
+    end
+
+    def test_native_json_transcoder_decodes_documents_in_extension
+      doc_id = uniq_id(:native_json)
+      other_id = uniq_id(:native_binary)
+      document = {"name" => "Brass Doorknob", "tags" => ["kitchen", 42, nil], "price" => {"value" => 19.95}}
+      @collection.upsert(doc_id, document)
+      @collection.upsert(other_id, "\x00\x01", Options::Upsert(transcoder: Couchbase::RawBinaryTranscoder.new))
+      transcoder = Couchbase::NativeJsonTranscoder.new(symbolize_names: true)
+
+      res = @collection.get(doc_id, Options::Get(transcoder: transcoder))
+
+      assert_equal({name: "Brass Doorknob", tags: ["kitchen", 42, nil], price: {value: 19.95}}, res.content)
+      assert_equal document, res.content(Couchbase::JsonTranscoder.new)
+
+      res = @collection.get_multi([doc_id, other_id], Options::GetMulti(transcoder: transcoder))
+
+      assert_equal "Brass Doorknob", res[0].content[:name]
+      assert_raises(Couchbase::Error::DecodingFailure) { res[1].content }
+      assert_equal "\x00\x01", res[1].content(Couchbase::RawBinaryTranscoder.new)
+
+      res = @collection.lookup_in(doc_id, [LookupInSpec.get("price"), LookupInSpec.get("tags")],
+                                  Options::LookupIn(transcoder: transcoder))
+
+      assert_equal({value: 19.95}, res.content(0))
+      assert_equal ["kitchen", 42, nil], res.content("tags")
+    end
+
+    def test_native_json_transcoder_keeps_original_body
+      doc_id = uniq_id(:native_json_body)
+      body = '{ "name": "Brass Doorknob",  "price": 19.950 }'
+      @collection.upsert(doc_id, body, Options::Upsert(transcoder: Couchbase::RawJsonTranscoder.new))
+      transcoder = Couchbase::NativeJsonTranscoder.new
+
+      res = @collection.get(doc_id, Options::Get(transcoder: transcoder))
+      res.content["name"] = "Steel Doorknob"
+
+      assert_equal "Steel Doorknob", res.content["name"]
+      assert_equal body, res.encoded
+      assert_equal body, res.content(Couchbase::RawJsonTranscoder.new)
+      assert_equal "Brass Doorknob", res.content(Couchbase::JsonTranscoder.new)["name"]
+
+      res = @collection.lookup_in(doc_id, [LookupInSpec.get("price")], Options::LookupIn(transcoder: transcoder))
+
+      assert_in_delta(19.95, res.content(0))
+      assert_equal "19.950", res.content(0, Couchbase::RawJsonTranscoder.new)
+    end
+
+    def test_compressed_documents_round_trip
+      disconnect
+      connect(Options::Cluster.new(enable_compression: true, compression_min_size: 1024, compression_min_ratio: 0.9))
+      collection = @cluster.bucket(env.bucket).default_collection
+      doc_id = uniq_id(:compressed)
+      document = {"items" => Array.new(2_000) { |i| {"id" => i, "description" => "the same text over and over"} }}
+
+      collection.upsert(doc_id, document)
+
+      assert_equal document, collection.get(doc_id).content
+      res = collection.upsert_multi([[doc_id, document], [uniq_id(:small), {"id" => 1}]])
+
+      assert res.all?(&:success?)
+      assert_equal document, collection.get_multi([doc_id]).first.content
+    end
+
+    def test_compression_ratio_must_be_valid
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support compression options") if env.protostellar?
+
+      assert_raises(Couchbase::Error::InvalidArgument) do
+        connect(Options::Cluster.new(compression_min_ratio: 1.5))
+      end
+    end
+
     def test_error_not_existent
       doc_id = uniq_id(:does_not_exist)
 
@@ -926,6 +1081,261 @@ module Couchbase
       end
     end
 
+    def test_multi_ops_with_limited_number_of_requests_in_flight
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support multi ops") if env.protostellar?
+
+      keys = (0..100).map { |idx| uniq_id("key_#{idx}") }
+
+      res = @collection.upsert_multi(keys.map { |k| [k, {"value" => k}] }, Options::UpsertMulti(max_in_flight: 8))
+
+      assert_equal keys.size, res.size
+      assert res.all?(&:success?)
+
+      res = @collection.get_multi(keys, Options::GetMulti(max_in_flight: 1))
+
+      assert_equal keys, res.map(&:id)
+      assert_equal keys, res.map { |r| r.content["value"] }
+
+      res = @collection.remove_multi(keys, Options::RemoveMulti(max_in_flight: keys.size * 2))
+
+      assert res.all?(&:success?)
+    end
+
+    def test_multi_ops_never_exceed_max_in_flight
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support multi ops") if env.protostellar?
+
+      keys = (0..100).map { |idx| uniq_id("key_#{idx}") }
+      @collection.upsert_multi(keys.map { |k| [k, {"value" => k}] })
+
+      [1, 4].each do |window|
+        completed = []
+        @collection.get_multi(keys, Options::GetMulti(max_in_flight: window)) { |r| completed << keys.index(r.id) }
+
+        assert_equal keys.size, completed.size
+        # the request N is sent only after N - window + 1 requests have completed
+        completed.each_with_index do |key_index, position|
+          assert_operator key_index, :<, position + window
+        end
+      end
+    ensure
+      @collection.remove_multi(keys) if keys
+    end
+
+    def test_multi_ops_reject_invalid_max_in_flight
+      [0, -1, 1.5, "8"].each do |value|
+        assert_raises(Error::InvalidArgument) { Options::GetMulti(max_in_flight: value) }
+        assert_raises(Error::InvalidArgument) { Options::UpsertMulti.new.max_in_flight = value }
+      end
+    end
+
+    def test_get_multi_yields_results_in_order_of_completion
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support multi ops") if env.protostellar?
+
+      keys = (0..50).map { |idx| uniq_id("key_#{idx}") }
+      @collection.upsert_multi(keys.map { |k| [k, {"value" => k}] })
+      missing = uniq_id(:does_not_exist)
+
+      results = []
+      res = @collection.get_multi(keys + [missing]) { |r| results << r }
+
+      assert_nil res
+      assert_equal keys.size + 1, results.size
+      assert_equal (keys + [missing]).sort, results.map(&:id).sort
+      results.each do |r|
+        if r.id == missing
+          assert_kind_of Error::DocumentNotFound, r.error
+        else
+          assert_nil r.error
+          assert_equal r.id, r.content["value"]
+        end
+      end
+    end
+
+    def test_multi_mutations_across_collections
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support multi ops") if env.protostellar?
+      skip("#{name}: The server does not support collections") unless use_caves? || env.server_version.supports_collections?
+
+      collection_name = uniq_id(:coll)
+      @bucket.collections.create_collection("_default", collection_name)
+      env.consistency.wait_until_collection_present(env.bucket, "_default", collection_name)
+      other = @bucket.default_scope.collection(collection_name)
+
+      doc_id = uniq_id(:foo)
+      res = @collection.upsert_multi([[doc_id, {"value" => "default"}], [other, doc_id, {"value" => "other"}]])
+
+      assert res.all?(&:success?)
+      assert_equal({"value" => "default"}, @collection.get(doc_id).content)
+      assert_equal({"value" => "other"}, other.get(doc_id).content)
+
+      res = @collection.remove_multi([[other, doc_id]])
+
+      assert_nil res[0].error
+      assert_raises(Error::DocumentNotFound) { other.get(doc_id) }
+      assert_equal({"value" => "default"}, @collection.get(doc_id).content)
+    ensure
+      @bucket.collections.drop_collection("_default", collection_name) if collection_name
+    end
+
+    def test_completion_queue
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not use native backend") if env.protostellar?
+
+      backend = @cluster.backend
+      keyspace = [@collection.bucket_name, @collection.scope_name, @collection.name]
+      queue = Couchbase::Backend::CompletionQueue.new
+      keys = (0..10).map { |idx| uniq_id("key_#{idx}") }
+      keys.each do |key|
+        backend.document_upsert_enqueue(queue, [:upsert, key], *keyspace, key, JSON.generate(value: key), 0, {})
+      end
+
+      assert_equal keys.size, queue.pending
+
+      completed = []
+      completed.concat(queue.wait(10_000)) while queue.pending.positive?
+
+      assert_equal keys.size, completed.size
+      assert_equal keys.sort, completed.map { |(_, key), _| key }.sort
+      completed.each do |(_, key), entry|
+        assert_nil entry[:error]
+        assert_equal key, entry[:id]
+      end
+
+      backend.document_get_enqueue(queue, :missing, *keyspace, uniq_id(:does_not_exist), {})
+      completed = []
+      completed.concat(queue.wait(10_000)) while queue.pending.positive?
+
+      assert_equal :missing, completed[0][0]
+      assert_kind_of Error::DocumentNotFound, completed[0][1][:error]
+    end
+
+    def test_async_ops
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support async ops") if env.protostellar?
+
+      doc_id1 = uniq_id(:foo)
+      doc_id2 = uniq_id(:bar)
+
+      pending = [
+        @collection.upsert_async(doc_id1, {"foo" => 32}),
+        @collection.insert_async(doc_id2, {"bar" => "bar42"}),
+      ]
+      res = pending.map(&:value)
+
+      assert pending.all?(&:ready?)
+      res.each do |r|
+        assert_kind_of Collection::MutationResult, r
+        refute_equal 0, r.cas
+      end
+
+      pending = [
+        @collection.get_async(doc_id1),
+        @collection.get_async(doc_id2),
+        @collection.get_async(uniq_id(:does_not_exist)),
+      ]
+
+      assert_equal({"foo" => 32}, pending[0].value.content)
+      assert_equal({"bar" => "bar42"}, pending[1].value.content)
+      assert_equal res[1].cas, pending[1].value.cas
+      2.times do
+        assert_raises(Error::DocumentNotFound) { pending[2].value }
+      end
+
+      res = @collection.replace_async(doc_id1, {"foo" => 33}, Options::Replace(cas: pending[0].value.cas)).value
+
+      refute_equal pending[0].value.cas, res.cas
+
+      @collection.touch_async(doc_id1, 60).value
+      @collection.remove_async(doc_id1).value
+      @collection.remove_async(doc_id2).value
+
+      assert_raises(Error::DocumentNotFound) { @collection.get_async(doc_id1).value }
+    end
+
+    def test_async_value_from_multiple_threads
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support async ops") if env.protostellar?
+
+      doc_id = uniq_id(:foo)
+      @collection.upsert(doc_id, {"foo" => 42})
+
+      pending = @collection.get_async(doc_id)
+      results = Array.new(8) { Thread.new { pending.value } }.map(&:value)
+
+      assert_predicate pending, :ready?
+      results.each do |res|
+        assert_same results.first, res
+        assert_equal({"foo" => 42}, res.content)
+      end
+
+      missing = @collection.get_async(uniq_id(:does_not_exist))
+      errors = Array.new(8) do
+        Thread.new do
+          missing.value
+        rescue Error::DocumentNotFound => e
+          e
+        end
+      end.map(&:value)
+
+      errors.each { |error| assert_kind_of Error::DocumentNotFound, error }
+    end
+
+    def test_multi_variants_of_kv_ops
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support multi ops") if env.protostellar?
+
+      keys = (0..10).map { |idx| uniq_id("key_#{idx}") }
+      missing = uniq_id(:does_not_exist)
+
+      res = @collection.insert_multi(keys.map { |k| [k, {"value" => k, "visits" => 0}] })
+
+      assert res.all?(&:success?)
+      res = @collection.insert_multi([[keys[0], {"value" => 42}]])
+
+      assert_kind_of Error::DocumentExists, res[0].error
+
+      res = @collection.exists_multi(keys + [missing])
+
+      assert_equal keys.size + 1, res.size
+      assert res.take(keys.size).all?(&:exists?)
+      refute_predicate res.last, :exists?
+      assert_equal missing, res.last.id
+
+      res = @collection.replace_multi([[keys[0], {"value" => "replaced"}, 0xdeadbeef], [keys[1], {"value" => "replaced"}]])
+
+      assert_kind_of Error::CasMismatch, res[0].error
+      assert_nil res[1].error
+
+      res = @collection.touch_multi([keys[0], missing], 60)
+
+      assert_nil res[0].error
+      assert_kind_of Error::DocumentNotFound, res[1].error
+
+      res = @collection.get_and_touch_multi(keys.take(2), 60)
+
+      assert_equal({"value" => "replaced"}, res[1].content)
+
+      locked = @collection.get_and_lock(keys[2], 10)
+      res = @collection.unlock_multi([[keys[2], locked.cas]])
+
+      assert_nil res[0].error
+
+      res = @collection.mutate_in_multi(keys.map { |k| [k, [MutateInSpec.increment("visits", 2)]] })
+
+      res.each do |r|
+        assert_nil r.error
+        assert_equal 2, r.content(0)
+      end
+
+      res = @collection.lookup_in_multi(keys + [missing], [LookupInSpec.get("visits")])
+
+      assert_equal 2, res[0].content(0)
+      assert_kind_of Error::DocumentNotFound, res.last.error
+
+      counters = keys.take(2).map { |k| "#{k}_counter" }
+      res = @collection.binary.increment_multi(counters, Options::IncrementMulti(initial: 10))
+
+      assert_equal [10, 10], res.map(&:content)
+      res = @collection.binary.decrement_multi(counters, Options::DecrementMulti(delta: 3))
+
+      assert_equal [7, 7], res.map(&:content)
+    end
+
     def test_preserve_expiry
       skip("#{name}: CAVES does not support preserve expiry") if use_caves?
       unless env.server_version.supports_preserve_expiry?
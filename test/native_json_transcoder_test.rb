@@ -0,0 +1,113 @@
+# frozen_string_literal: true
+
+#  Copyright 2025-Present Couchbase, Inc.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+require "test_helper"
+
+require "couchbase/native_json_transcoder"
+require "couchbase/transcoder_flags"
+require "couchbase/errors"
+
+module Couchbase
+  class NativeJsonTranscoderTest < Minitest::Test
+    include Couchbase::TestUtilities
+
+    def setup
+      @transcoder = Couchbase::NativeJsonTranscoder.new
+      @flags = Couchbase::TranscoderFlags.new(format: :json).encode
+    end
+
+    def test_encode_hash
+      document = {:foo => 10, "bar" => "baz", :nested => [1, -2.5, nil, true, {"x" => 2**63}]}
+      encoded, flag = @transcoder.encode(document)
+
+      assert_equal JSON.parse(JSON.generate(document)), JSON.parse(encoded)
+      assert_equal 2, flag >> 24
+    end
+
+    def test_encode_preserves_order_of_keys
+      encoded, = @transcoder.encode({"b" => 1, "a" => 2, "c" => 3})
+
+      assert_equal "{\"b\":1,\"a\":2,\"c\":3}", encoded
+    end
+
+    def test_encode_escapes_strings
+      document = "quote \" backslash \\ newline \n unicode é"
+      encoded, = @transcoder.encode(document)
+
+      assert_equal document, JSON.parse(encoded)
+    end
+
+    def test_encode_binary_fails
+      document = "\x00\xff"
+
+      assert_raises(Couchbase::Error::EncodingFailure) { @transcoder.encode(document) }
+    end
+
+    def test_encode_nan_fails
+      assert_raises(Couchbase::Error::EncodingFailure) { @transcoder.encode({"value" => Float::NAN}) }
+    end
+
+    def test_encode_uses_to_json_of_custom_objects
+      klass = Struct.new(:value) do
+        def to_json(*_args)
+          JSON.generate({"custom" => value})
+        end
+      end
+      encoded, = @transcoder.encode([klass.new(42)])
+
+      assert_equal "[{\"custom\":42}]", encoded
+    end
+
+    def test_decode_hash
+      decoded = @transcoder.decode("{\"foo\":10,\"bar\":\"baz\",\"qux\":[1.5,null,false,18446744073709551615]}", @flags)
+
+      assert_equal({"foo" => 10, "bar" => "baz", "qux" => [1.5, nil, false, 18_446_744_073_709_551_615]}, decoded)
+      assert_equal %w[foo bar qux], decoded.keys
+      assert_predicate decoded.keys.first, :frozen?
+    end
+
+    def test_decode_symbolize_names
+      transcoder = Couchbase::NativeJsonTranscoder.new(symbolize_names: true)
+      decoded = transcoder.decode("{\"foo\":{\"bar\":42}}", @flags)
+
+      assert_equal({foo: {bar: 42}}, decoded)
+    end
+
+    def test_decode_large_document
+      document = Array.new(5_000) { |i| {"id" => i, "name" => "item #{i}", "tags" => %w[a b c]} }
+      blob = JSON.generate(document)
+      decoded = @transcoder.decode(blob, @flags)
+
+      assert_operator blob.bytesize, :>, 64 * 1024
+      assert_equal document, decoded
+    end
+
+    def test_decode_invalid_json_fails
+      assert_raises(Couchbase::Error::DecodingFailure) { @transcoder.decode("{\"foo\":", @flags) }
+    end
+
+    def test_decode_invalid_flag
+      blob = "\xff\x00"
+      flag = Couchbase::TranscoderFlags.new(format: :binary).encode
+
+      assert_raises(Couchbase::Error::DecodingFailure) { @transcoder.decode(blob, flag) }
+    end
+
+    def test_decode_nil
+      assert_nil @transcoder.decode("null", @flags)
+    end
+  end
+end
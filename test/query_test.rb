@@ -52,6 +52,166 @@ module Couchbase
       assert_equal "ruby rules", res.rows.first["greeting"]
     end
 
+    def test_query_each_streams_rows
+      statement = "SELECT RAW i FROM ARRAY_RANGE(0, 5000) AS i"
+      seen = []
+      meta = @cluster.query_each(statement, Options::Query(metrics: true)) { |row| seen << row }
+
+      assert_equal (0...5000).to_a, seen
+      assert_equal :success, meta.status
+      assert_equal 5000, meta.metrics.result_count
+    end
+
+    def test_query_each_stops_when_block_breaks
+      taken = @cluster.query_each("SELECT RAW i FROM ARRAY_RANGE(0, 100000) AS i").take(3)
+
+      assert_equal [0, 1, 2], taken
+      assert_equal "ruby rules", @cluster.query('SELECT "ruby rules" AS greeting').rows.first["greeting"]
+    end
+
+    def test_query_each_fails_when_consumer_falls_behind
+      disconnect
+      connect(Options::Cluster.new(row_stream_max_buffered_bytes: 4096))
+      seen = []
+
+      error = assert_raises(Error::RequestCanceled) do
+        @cluster.query_each("SELECT RAW i FROM ARRAY_RANGE(0, 100000) AS i") do |row|
+          sleep(1) if seen.empty?
+          seen << row
+        end
+      end
+
+      assert_match(/4096 bytes/, error.message)
+      assert_operator seen.size, :<, 100_000
+      assert_equal "ruby rules", @cluster.query('SELECT "ruby rules" AS greeting').rows.first["greeting"]
+    end
+
+    def test_query_each_raises_query_errors
+      assert_raises(Error::ParsingFailure) do
+        @cluster.query_each("SELECT * FROM WHERE") { |row| flunk("unexpected row #{row}") }
+      end
+    end
+
+    def test_query_parameters_of_native_types
+      ids = Array.new(10_000) { |i| "id-#{i}" }
+      res = @cluster.query("SELECT ARRAY_LENGTH($1) AS size, $2 AS nested, $3 AS number",
+                           Options::Query(positional_parameters: [ids, {"a" => [1, nil, true]}, 4.5]))
+
+      assert_equal({"size" => 10_000, "nested" => {"a" => [1, nil, true]}, "number" => 4.5}, res.rows.first)
+
+      res = @cluster.query("SELECT $str AS str, $sym AS sym",
+                           Options::Query(named_parameters: {str: "quote\"d", "sym" => :value}))
+
+      assert_equal({"str" => "quote\"d", "sym" => "value"}, res.rows.first)
+    end
+
+    def test_query_multi_returns_results_in_order
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support batched queries") if env.protostellar?
+
+      results = @cluster.query_multi([
+        'SELECT "first" AS greeting',
+        ["SELECT $1 AS greeting", Options::Query(positional_parameters: ["second"])],
+        "SELECT * FROM WHERE",
+        ["SELECT $name AS greeting", Options::Query(named_parameters: {name: "fourth"})],
+      ])
+
+      assert_equal 4, results.size
+      assert_equal %w[first second], results[0, 2].map { |res| res.rows.first["greeting"] }
+      refute_predicate results[2], :success?
+      assert_kind_of Error::ParsingFailure, results[2].error
+      assert_equal "fourth", results[3].rows.first["greeting"]
+      assert_equal :success, results[3].meta_data.status
+    end
+
+    def test_prepared_statement_cache_is_disabled_by_default
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support prepared statement cache") if env.protostellar?
+
+      statement = "SELECT $1 AS #{uniq_id(:greeting).tr('^a-zA-Z0-9', '_')}"
+
+      assert_equal 0, @cluster.prepare_queries([statement])
+      res = @cluster.query(statement, Options::Query(adhoc: false, positional_parameters: [42]))
+
+      assert_equal 42, res.rows.first.values.first
+      stats = @cluster.prepared_statement_cache_stats
+
+      assert_equal 0, stats.capacity
+      assert_equal 0, stats.size
+      assert_equal 0, stats.hits + stats.misses
+    end
+
+    def test_prepared_statements_are_cached
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support prepared statement cache") if env.protostellar?
+
+      disconnect
+      connect(Options::Cluster.new(prepared_statement_cache_size: 100))
+      statement = "SELECT $1 AS #{uniq_id(:greeting).tr('^a-zA-Z0-9', '_')}"
+
+      assert_equal 1, @cluster.prepare_queries([statement])
+      assert_equal 0, @cluster.prepare_queries([statement])
+
+      before = @cluster.prepared_statement_cache_stats
+      3.times do |i|
+        res = @cluster.query(statement, Options::Query(adhoc: false, positional_parameters: [i]))
+
+        assert_equal i, res.rows.first.values.first
+      end
+      after = @cluster.prepared_statement_cache_stats
+
+      assert_equal before.hits + 3, after.hits
+      assert_equal before.misses, after.misses
+      assert_operator after.size, :<=, after.capacity
+    end
+
+    def test_prepared_statement_cache_evicts_least_recently_used
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support prepared statement cache") if env.protostellar?
+
+      disconnect
+      connect(Options::Cluster.new(prepared_statement_cache_size: 2))
+      first, second, third = %i[first second third].map { |n| "SELECT $1 AS #{uniq_id(n).tr('^a-zA-Z0-9', '_')}" }
+
+      assert_equal 2, @cluster.prepare_queries([first, second])
+      # touch the first statement, so that the second one becomes the least recently used
+      @cluster.query(first, Options::Query(adhoc: false, positional_parameters: [1]))
+
+      assert_equal 1, @cluster.prepare_queries([third])
+      stats = @cluster.prepared_statement_cache_stats
+
+      assert_equal 2, stats.capacity
+      assert_equal 2, stats.size
+      assert_equal 1, stats.evictions
+      assert_equal 0, @cluster.prepare_queries([first, third])
+      assert_equal 1, @cluster.prepare_queries([second])
+      assert_equal 2, @cluster.prepared_statement_cache_stats.evictions
+    end
+
+    def test_prepared_statement_is_prepared_again_when_server_forgets_it
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support prepared statement cache") if env.protostellar?
+
+      disconnect
+      connect(Options::Cluster.new(prepared_statement_cache_size: 10))
+      field = uniq_id(:greeting).tr("^a-zA-Z0-9", "_")
+      statement = "SELECT $1 AS #{field}"
+      options = Options::Query(adhoc: false, positional_parameters: ["before"])
+
+      assert_equal "before", @cluster.query(statement, options).rows.first[field]
+
+      # drop the statement on the server, the next EXECUTE fails with error in 4040..4090 range
+      @cluster.query("DELETE FROM system:prepareds WHERE CONTAINS(statement, $1)",
+                     Options::Query(positional_parameters: [field]))
+      before = @cluster.prepared_statement_cache_stats
+      options.positional_parameters(["after"])
+
+      assert_equal "after", @cluster.query(statement, options).rows.first[field]
+      after = @cluster.prepared_statement_cache_stats
+
+      assert_equal before.hits + 1, after.hits
+      assert_equal before.size, after.size
+      prepareds = @cluster.query("SELECT RAW COUNT(*) FROM system:prepareds WHERE CONTAINS(statement, $1)",
+                                 Options::Query(positional_parameters: [field]))
+
+      assert_operator prepareds.rows.first, :>=, 1
+    end
+
     def test_cas_representation_consistency
       doc_id = uniq_id(:foo)
       res = @collection.insert(doc_id, {"self_id" => doc_id})
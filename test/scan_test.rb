@@ -214,6 +214,144 @@ module Couchbase
       validate_sampling_scan(scan_result, limit, ids_only: true)
     end
 
+    def test_prefix_scan_next_batch
+      expected_ids = (0..9).map { |i| "#{@shared_prefix}-1#{i}" }
+      scan_result = @collection.scan(PrefixScan.new("#{@shared_prefix}-1"), Options::Scan(mutation_state: @mutation_state))
+      batches = []
+      while (batch = scan_result.next_batch(3))
+        assert_operator(batch.size, :<=, 3)
+        batches << batch
+      end
+
+      assert_nil(scan_result.next_batch(3))
+      assert_operator(batches.size, :>=, 4)
+      assert_equal(expected_ids.to_set, batches.flatten.to_set(&:id))
+    end
+
+    def test_prefix_scan_next_batch_rejects_invalid_limits
+      expected_ids = (0..9).map { |i| "#{@shared_prefix}-1#{i}" }
+      scan_result = @collection.scan(PrefixScan.new("#{@shared_prefix}-1"), Options::Scan(mutation_state: @mutation_state))
+
+      [0, -1, 2.5, "3", nil].each do |max_items|
+        assert_raises(Error::InvalidArgument) { scan_result.next_batch(max_items) }
+      end
+      [0, -1, "1024"].each do |max_bytes|
+        assert_raises(Error::InvalidArgument) { scan_result.next_batch(3, max_bytes) }
+      end
+
+      # the scan is still usable after rejected calls
+      assert_equal(expected_ids.to_set, scan_result.next_batch(2**64).to_set(&:id))
+    end
+
+    def test_consecutive_scans_on_the_same_bucket
+      expected_ids = (0..9).map { |i| "#{@shared_prefix}-1#{i}" }
+      3.times do
+        validate_scan(@collection.scan(PrefixScan.new("#{@shared_prefix}-1"), Options::Scan(mutation_state: @mutation_state)),
+                      expected_ids)
+      end
+
+      # the second scan starts while the first one still holds its streams
+      first = @collection.scan(PrefixScan.new("#{@shared_prefix}-1"), Options::Scan(mutation_state: @mutation_state))
+      head = first.next_batch(2)
+      second = @collection.scan(PrefixScan.new("#{@shared_prefix}-2"), Options::Scan(mutation_state: @mutation_state))
+
+      validate_scan(second, (0..9).map { |i| "#{@shared_prefix}-2#{i}" })
+      rest = []
+      while (batch = first.next_batch(5))
+        rest.concat(batch)
+      end
+
+      assert_equal(expected_ids.to_set, (head + rest).to_set(&:id))
+    end
+
+    def test_scan_after_reconnect
+      expected_ids = (0..9).map { |i| "#{@shared_prefix}-1#{i}" }
+      validate_scan(@collection.scan(PrefixScan.new("#{@shared_prefix}-1"), Options::Scan(mutation_state: @mutation_state)),
+                    expected_ids)
+      stale_collection = @collection
+
+      disconnect
+
+      assert_raises(Error::ClusterClosed) do
+        stale_collection.scan(PrefixScan.new("#{@shared_prefix}-1")).to_a
+      end
+
+      connect
+      @bucket = @cluster.bucket(env.bucket)
+      @collection = @bucket.default_collection
+
+      validate_scan(@collection.scan(PrefixScan.new("#{@shared_prefix}-1"), Options::Scan(mutation_state: @mutation_state)),
+                    expected_ids)
+    end
+
+    def test_scan_shards_cover_collection_without_overlap
+      shards = @collection.scan_shards(4, Options::Scan(mutation_state: @mutation_state))
+
+      assert_operator(shards.size, :<=, 4)
+      assert_nil(shards.first.from)
+      assert_nil(shards.last.to)
+
+      ids = shards.flat_map do |shard|
+        @collection.scan(shard, Options::Scan.new(ids_only: true, mutation_state: @mutation_state)).map(&:id)
+      end
+
+      assert_equal(ids.size, ids.uniq.size)
+      assert_equal(@test_ids, ids.to_set & @test_ids)
+    end
+
+    def test_range_scan_resumes_from_checkpoint
+      expected_ids = (0..9).map { |i| "#{@shared_prefix}-1#{i}" }
+      scan_type = RangeScan.new(
+        from: ScanTerm.new("#{@shared_prefix}-10"),
+        to: ScanTerm.new("#{@shared_prefix}-19"),
+      )
+      scan_result = @collection.scan(scan_type, Options::Scan(mutation_state: @mutation_state))
+      first_batch = scan_result.next_batch(4)
+      checkpoint = scan_result.checkpoint
+
+      refute_empty(checkpoint)
+
+      resumed = @collection.scan(scan_type, Options::Scan(mutation_state: @mutation_state, resume_from: checkpoint.to_h))
+      rest = resumed.map(&:id)
+
+      assert_empty(first_batch.map(&:id) & rest)
+      assert_equal(expected_ids.to_set, (first_batch.map(&:id) + rest).to_set)
+    end
+
+    def test_sampling_scan_rejects_checkpoint
+      assert_raises(Error::InvalidArgument) do
+        @collection.scan(SamplingScan.new(10), Options::Scan(resume_from: {0 => "#{@shared_prefix}-10"}))
+      end
+    end
+
+    def test_prefix_scan_metadata_only
+      expected_ids = (0..9).map { |i| "#{@shared_prefix}-1#{i}" }
+      scan_result = @collection.scan(PrefixScan.new("#{@shared_prefix}-1"),
+                                     Options::Scan(metadata_only: true, mutation_state: @mutation_state))
+      items = scan_result.to_a
+
+      assert_equal(expected_ids.to_set, items.to_set(&:id))
+      items.each do |item|
+        refute(item.id_only)
+        refute_equal(0, item.cas)
+        assert_nil(item.content)
+      end
+    end
+
+    def test_prefix_scan_with_projections
+      doc_id = "#{@shared_prefix}-projection"
+      @test_ids << doc_id
+      res = @collection.upsert(doc_id, {"name" => "Arthur", "address" => {"city" => "London", "street" => "Main"}, "age" => 42})
+      @mutation_state.add(res.mutation_token)
+
+      scan_result = @collection.scan(PrefixScan.new(doc_id),
+                                     Options::Scan(projections: ["name", "address.city", "missing"], mutation_state: @mutation_state))
+      items = scan_result.to_a
+
+      assert_equal([doc_id], items.map(&:id))
+      assert_equal({"name" => "Arthur", "address" => {"city" => "London"}}, items.first.content)
+    end
+
     def test_sampling_scan_with_seed
       limit = 20
       scan_result = @collection.scan(SamplingScan.new(limit, 42), Options::Scan.new(ids_only: true, mutation_state: @mutation_state))
@@ -152,6 +152,58 @@ module Couchbase
       assert_operator attempts, :<, 20, "it is very suspicious that search took more than 20 attempts (#{attempts})"
     end
 
+    def test_search_each_yields_rows_with_lazy_locations
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support search index management yet") if env.protostellar?
+      skip("#{name}: CAVES does not support search service yet") if use_caves?
+
+      doc_id = uniq_id(:foo)
+      res = @collection.insert(doc_id, {"type" => "character", "name" => "Arthur"})
+      options = Options::Search.new(limit: 100, include_locations: true)
+      options.consistent_with(MutationState.new(res.mutation_token))
+      query = Cluster::SearchQuery.conjuncts(Cluster::SearchQuery.doc_id(doc_id), Cluster::SearchQuery.match("arthur"))
+      request = SearchRequest.new(query)
+      rows = []
+      attempts = 0
+      retry_delay = 0.5
+      loop do
+        begin
+          break if attempts >= 20
+
+          attempts += 1
+          rows = @cluster.search_each(@index_name, request, options).to_a
+        rescue Error::ConsistencyMismatch
+          sleep(retry_delay)
+          retry
+        end
+        break unless rows.empty?
+
+        sleep(retry_delay)
+      end
+
+      assert_equal [doc_id], rows.map(&:id)
+      assert_kind_of Float, rows.first.score
+      # the "name" field of the index stores term vectors
+      locations = rows.first.locations
+
+      refute_nil locations
+      assert_equal ["name"], locations.fields
+      assert_equal ["arthur"], locations.terms
+      location = locations.get_for_field_and_term("name", "arthur").first
+
+      assert_equal "name", location.field
+      assert_equal "arthur", location.term
+      assert_equal 1, location.position
+      assert_equal 0, location.start_offset
+      assert_equal 6, location.end_offset
+
+      result = @cluster.search(@index_name, request, options)
+
+      assert_equal [doc_id], result.rows.map(&:id)
+      assert_equal locations.terms, result.rows.first.locations.terms
+      assert_equal [[location.position, location.start_offset, location.end_offset]],
+                   result.rows.first.locations.get_all.map { |loc| [loc.position, loc.start_offset, loc.end_offset] }
+    end
+
     def test_search_request_backend_encoding
       skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support search index management yet") if env.protostellar?
       skip("#{name}: CAVES does not support search service yet") if use_caves?
@@ -33,6 +33,7 @@ end
 require "rubygems/version"
 
 require_relative 'utils/consistency_helper'
+require_relative 'utils/fiber_scheduler'
 
 require "couchbase/management"
 
@@ -201,6 +201,30 @@ module Couchbase
       )
     end
 
+    def test_analytics_query_each
+      skip("#{name}: CAVES does not support analytics service yet") if use_caves?
+
+      rows = []
+      meta = @cluster.analytics_query_each(
+        "SELECT VALUE i FROM range(1, 3) AS i",
+        Options::Analytics.new(
+          parent_span: @parent_span,
+        ),
+      ) { |row| rows << row }
+
+      assert_equal [1, 2, 3], rows
+      assert_equal :success, meta.status
+
+      spans = @tracer.spans("analytics")
+
+      assert_equal 1, spans.size
+      assert_http_span(
+        env, spans.first, "analytics", @parent_span,
+        service: "analytics",
+        statement: nil # No db.query.text attribute if no parameters are used
+      )
+    end
+
     def test_analytics_manager_get_all_datasets
       skip("#{name}: CAVES does not support analytics service yet") if use_caves?
 
@@ -400,6 +424,32 @@ module Couchbase
       )
     end
 
+    def test_cluster_level_query_multi
+      skip("#{name}: CAVES does not support query service") if use_caves?
+      skip("#{name}: The #{Couchbase::Protostellar::NAME} protocol does not support batched queries") if env.protostellar?
+
+      results = @cluster.query_multi([
+        ["SELECT 1=1 AS result", Options::Query.new(parent_span: @parent_span)],
+        ["SELECT $1 AS result", Options::Query.new(parent_span: @parent_span, positional_parameters: [10])],
+      ])
+
+      assert_equal [{"result" => true}, {"result" => 10}], results.map { |res| res.rows.first }
+
+      spans = @tracer.spans("query")
+
+      assert_equal 2, spans.size
+      assert_http_span(
+        env, spans[0], "query", @parent_span,
+        service: "query",
+        statement: nil # No db.query.text attribute if no parameters are used
+      )
+      assert_http_span(
+        env, spans[1], "query", @parent_span,
+        service: "query",
+        statement: "SELECT $1 AS result"
+      )
+    end
+
     def test_scope_level_query
       skip("#{name}: CAVES does not support query service") if use_caves?
 
@@ -0,0 +1,122 @@
+# frozen_string_literal: true
+
+#  Copyright 2025-Present Couchbase, Inc.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+module Couchbase
+  module TestUtilities
+    # Minimal implementation of Fiber::Scheduler interface, just enough to run the operations of
+    # the library in non-blocking fibers on a single thread.
+    #
+    # It also records how many fibers have been waiting for IO at the same time.
+    class FiberScheduler
+      attr_reader :max_waiting_fibers
+
+      def initialize
+        @readable = {}
+        @sleeping = {}
+        @ready = []
+        @blocked = 0
+        @waiting_fibers = 0
+        @max_waiting_fibers = 0
+        @lock = Thread::Mutex.new
+        @wakeup_r, @wakeup_w = IO.pipe
+      end
+
+      def run
+        while @readable.any? || @sleeping.any? || @ready.any? || @blocked.positive?
+          readable, = IO.select([@wakeup_r, *@readable.keys], nil, nil, next_timeout)
+          readable&.each do |io|
+            if io == @wakeup_r
+              io.read_nonblock(1024, exception: false)
+            else
+              @readable.delete(io)&.resume
+            end
+          end
+          resume_expired_sleepers
+          @lock.synchronize { @ready.slice!(0..) }.each do |fiber|
+            @sleeping.delete(fiber)
+            fiber.resume
+          end
+        end
+      end
+
+      def close
+        run
+      ensure
+        @wakeup_r.close
+        @wakeup_w.close
+      end
+
+      def fiber(&block)
+        Fiber.new(blocking: false, &block).tap(&:resume)
+      end
+
+      def io_wait(io, events, _timeout)
+        @readable[io] = Fiber.current
+        @waiting_fibers += 1
+        @max_waiting_fibers = [@max_waiting_fibers, @waiting_fibers].max
+        Fiber.yield
+        events
+      ensure
+        @waiting_fibers -= 1
+      end
+
+      def kernel_sleep(duration = nil)
+        @sleeping[Fiber.current] = duration && (monotonic_time + duration)
+        Fiber.yield
+      end
+
+      def block(_blocker, timeout = nil)
+        if timeout
+          kernel_sleep(timeout)
+        else
+          @blocked += 1
+          begin
+            Fiber.yield
+          ensure
+            @blocked -= 1
+          end
+        end
+      end
+
+      def unblock(_blocker, fiber)
+        @lock.synchronize { @ready << fiber }
+        @wakeup_w.write_nonblock(".", exception: false)
+      end
+
+      private
+
+      def monotonic_time
+        Process.clock_gettime(Process::CLOCK_MONOTONIC)
+      end
+
+      def next_timeout
+        deadlines = @sleeping.values.compact
+        return nil if deadlines.empty?
+
+        [deadlines.min - monotonic_time, 0].max
+      end
+
+      def resume_expired_sleepers
+        now = monotonic_time
+        expired = @sleeping.select { |_fiber, deadline| deadline && deadline <= now }.keys
+        expired.each do |fiber|
+          @sleeping.delete(fiber)
+          fiber.resume
+        end
+      end
+    end
+  end
+end